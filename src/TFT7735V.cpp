@@ -1,13 +1,24 @@
 #include "TFT7735V.h"
+#include "bitmap_lut.h"
 #include <cstring>
 #include <algorithm>
+#include <math.h>
+#include <esp_timer.h>
 
 static const char* TAG = "TFT7735V";
 
+// Blend fg over bg, alpha 0..32
+static inline uint16_t blend565(uint16_t fg, uint16_t bg, uint8_t alpha) {
+    uint32_t f = (fg | ((uint32_t)fg << 16)) & 0x07E0F81F;
+    uint32_t b = (bg | ((uint32_t)bg << 16)) & 0x07E0F81F;
+    uint32_t r = ((((f - b) * alpha) >> 5) + b) & 0x07E0F81F;
+    return (uint16_t)((r >> 16) | r);
+}
+
 // Pre-transfer callback for setting DC pin
 void IRAM_ATTR spi_pre_transfer_callback(spi_transaction_t *t) {
     TFT7735V* tft = (TFT7735V*)t->user;
-    int dc = (int)t->user;
+    int dc = (int)(intptr_t)t->user;
     gpio_set_level((gpio_num_t)dc, (t->user != nullptr) ? 1 : 0);
 }
 
@@ -19,6 +30,7 @@ TFT7735V::TFT7735V(gpio_num_t mosi, gpio_num_t sclk, gpio_num_t cs,
     pins.dc = dc;
     pins.reset = reset;
     pins.bl = bl;
+    pins.miso = GPIO_NUM_NC;
     
     cs_pin = cs;
     dc_pin = dc;
@@ -27,11 +39,18 @@ TFT7735V::TFT7735V(gpio_num_t mosi, gpio_num_t sclk, gpio_num_t cs,
     
     initialized = false;
     spi_initialized = false;
+    spi_host = SPI2_HOST;
     pwm_initialized = false;
     spi_frequency = 40000000; // Default 40MHz
     brightness_level = 255;   // Default full brightness
-    width = ST7735_WIDTH;
-    height = ST7735_HEIGHT;
+    panel = &TFT_PANEL_ST7735V_128X160;
+    width = panel->native_width;
+    height = panel->native_height;
+    panel_w = width;
+    panel_h = height;
+    res_shift = 0;
+    half_res_smooth = false;
+    half_lines = nullptr;
     rotation = 0;
     x_offset = 0;
     y_offset = 0;
@@ -45,20 +64,78 @@ TFT7735V::TFT7735V(gpio_num_t mosi, gpio_num_t sclk, gpio_num_t cs,
     text_wrap = true;
     text_has_bg = false;
 
-    spi_device = nullptr;    // Triple buffer framebuffer initialization - ALWAYS ENABLED
-    framebuffer_a = nullptr;
-    framebuffer_b = nullptr;
-    framebuffer_c = nullptr;
+    spi_device = nullptr;
+    transport = TFT_TRANSPORT_SPI_MASTER;
+    for (int i = 0; i < 8; i++) {
+        i80_pins.data[i] = GPIO_NUM_NC;
+    }
+    i80_pins.wr = GPIO_NUM_NC;
+    ramwr_pending = false;
+    transfers_in_flight = 0;
+#if TFT7735V_HAS_ESP_LCD
+    lcd_io = nullptr;
+    transfer_done_semaphore = nullptr;
+#if TFT7735V_HAS_I80
+    i80_bus = nullptr;
+#endif
+#endif
+    
+    // Framebuffer queue initialization - ALWAYS ENABLED
+    framebuffer_count = TFT_DEFAULT_FRAMEBUFFERS;
+    for (int i = 0; i < TFT_MAX_FRAMEBUFFERS; i++) {
+        framebuffers[i] = nullptr;
+        buffer_states[i] = BUFFER_STATE_IDLE;
+    }
+    frame_queue_head = 0;
+    frame_queue_count = 0;
+    transfer_active = false;
+    portMUX_TYPE unlocked = portMUX_INITIALIZER_UNLOCKED;
+    frame_queue_lock = unlocked;
+    buffer_free_semaphore = nullptr;
+    frame_interval_us = 0;
+    last_transfer_start_us = 0;
+    canvas_panel_count = 0;
+    canvas_master = nullptr;
+    canvas_x = 0;
+    canvas_y = 0;
+    canvas_frame_bytes = 0;
+    canvas_frame_sprite_us = 0;
+    memset(canvas_pending, 0, sizeof(canvas_pending));
+    fb_window = false;
+    fb_x = 0;
+    fb_y = 0;
+    fb_w = width;
+    fb_h = height;
+    gram_mutex = nullptr;
     current_framebuffer = nullptr;
     framebuffer_enabled = true;  // Default enabled
-    framebuffer_size = ST7735_WIDTH * ST7735_HEIGHT * sizeof(uint16_t);
-    
-    // Initialize buffer states and indices
-    buffer_states[0] = BUFFER_STATE_IDLE;
-    buffer_states[1] = BUFFER_STATE_IDLE;
-    buffer_states[2] = BUFFER_STATE_IDLE;
-    render_buffer_idx = 0;      // Start with buffer A
-    transfer_buffer_idx = 1;    // Buffer B ready for transfer
+    
+    lazy_clear_enabled = false;
+    tiles_x = 0;
+    tiles_y = 0;
+    for (int i = 0; i < TFT_MAX_FRAMEBUFFERS; i++) {
+        tile_lazy[i] = nullptr;
+        tile_color[i] = nullptr;
+        lazy_tile_count[i] = 0;
+    }
+    gamma_custom = false;
+    color_lut_enabled = false;
+    partial_mode = false;
+    partial_idle = false;
+    partial_y = 0;
+    partial_h = 0;
+    tear_avoidance = false;
+    scan_period_us = 0;
+    scan_phase_us = 0;
+    scan_sync_us = 0;
+    frame_scan_wait_us = 0;
+    tracer = nullptr;
+    trace_depth = 0;
+    framebuffer_size = panel->native_width * panel->native_height * sizeof(uint16_t);
+    
+    // Initialize buffer indices
+    render_buffer_idx = 0;
+    transfer_buffer_idx = 0;
       // Double buffering initialization
     sram_buffer_a = nullptr;
     sram_buffer_b = nullptr;
@@ -69,40 +146,76 @@ TFT7735V::TFT7735V(gpio_num_t mosi, gpio_num_t sclk, gpio_num_t cs,
     display_in_progress = false;
     display_done_flag = true;
     current_chunk = 0;
-    total_chunks = MAX_CHUNKS;
+    update_chunk_geometry();
     dirty_rect_enabled = true;   // Default enabled
     force_full_redraw = false;
+    clearDirty();
+    
+    frame_start_us = 0;
+    frame_bytes = 0;
+    frame_bus_wait_us = 0;
+    frame_seq = 0;
+    frame_seq_done = 0;
+    frame_sprite_us = 0;
+    frame_done_cb = nullptr;
+    frame_done_user = nullptr;
+    bus_policy = TFT_BUS_LOCK_PER_CHUNK_GROUP;
+    bus_chunks_per_group = 2;
+    bus_chunks_held = 0;
+    bus_acquired = false;
+    memset(&frame_stats, 0, sizeof(frame_stats));
+    resetFrameStats();
 }
 
 TFT7735V::~TFT7735V() {
     end();
     free_framebuffer();
     free_double_buffering();
+    if (gram_mutex != nullptr) {
+        vSemaphoreDelete(gram_mutex);
+    }
 }
 
 bool TFT7735V::begin(uint32_t freq_hz) {
+    return begin(freq_hz, transport);
+}
+
+bool TFT7735V::begin(uint32_t freq_hz, tft_transport_t transport) {
     if (initialized) {
         ESP_LOGW(TAG, "Already initialized");
         return true;
     }
     
-    // Store SPI frequency
+    // Store SPI frequency (pixel clock for the parallel bus)
     if (freq_hz > 0) {
         spi_frequency = freq_hz;
     }
+    this->transport = transport;
+    
+    // Geometry follows the panel profile, or the canvas spanning all panels
+    framebuffer_size = panel->native_width * panel->native_height * sizeof(uint16_t);
+    set_logical_size();
+    if (canvas_panel_count != 0) {
+        framebuffer_size = (size_t)width * height * sizeof(uint16_t);
+    }
+    if (fb_window) {
+        framebuffer_size = (size_t)fb_w * fb_h * sizeof(uint16_t);
+    }
     
-    ESP_LOGI(TAG, "Initializing TFT7735V display with SPI freq: %lu Hz", spi_frequency);
+    ESP_LOGI(TAG, "Initializing %s display with SPI freq: %lu Hz", panel->name, spi_frequency);
     
     // Configure GPIO pins
     gpio_config_t io_conf = {};
     
-    // Configure DC pin
+    // Configure DC pin (esp_lcd drives DC itself)
     io_conf.intr_type = GPIO_INTR_DISABLE;
     io_conf.mode = GPIO_MODE_OUTPUT;
     io_conf.pin_bit_mask = (1ULL << dc_pin);
     io_conf.pull_down_en = GPIO_PULLDOWN_DISABLE;
     io_conf.pull_up_en = GPIO_PULLUP_DISABLE;
-    gpio_config(&io_conf);
+    if (transport == TFT_TRANSPORT_SPI_MASTER) {
+        gpio_config(&io_conf);
+    }
     
     // Configure RESET pin
     if (reset_pin != GPIO_NUM_NC) {
@@ -116,35 +229,8 @@ bool TFT7735V::begin(uint32_t freq_hz) {
         apply_brightness(); // Apply current brightness level
     }
     
-    // Initialize SPI bus
-    spi_bus_config_t buscfg = {};
-    buscfg.mosi_io_num = pins.mosi;
-    buscfg.miso_io_num = -1; // Not used
-    buscfg.sclk_io_num = pins.sclk;
-    buscfg.quadwp_io_num = -1;
-    buscfg.quadhd_io_num = -1;
-    buscfg.max_transfer_sz = 4096; // Maximum transfer size in bytes
-    
-    esp_err_t ret = spi_bus_initialize(SPI2_HOST, &buscfg, SPI_DMA_CH_AUTO);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to initialize SPI bus: %s", esp_err_to_name(ret));
-        return false;
-    }
-    spi_initialized = true;
-    
-    // Configure SPI device
-    spi_device_interface_config_t devcfg = {};
-    devcfg.clock_speed_hz = spi_frequency;
-    devcfg.mode = 0; // SPI mode 0
-    devcfg.spics_io_num = cs_pin;
-    devcfg.queue_size = 7;
-    devcfg.pre_cb = nullptr; // We'll handle DC manually
-    devcfg.flags = SPI_DEVICE_HALFDUPLEX;
-    
-    ret = spi_bus_add_device(SPI2_HOST, &devcfg, &spi_device);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to add SPI device: %s", esp_err_to_name(ret));
-        spi_bus_free(SPI2_HOST);
+    // Bring up the bus and panel IO for the selected transport
+    if (!init_transport()) {
         return false;
     }
     
@@ -153,8 +239,8 @@ bool TFT7735V::begin(uint32_t freq_hz) {
       // Initialize display
     init_sequence();
     
-    // Automatically initialize framebuffer system with triple buffering and dirty rect
-    ESP_LOGI(TAG, "Initializing framebuffer system (triple buffer + dirty rect)...");
+    // Automatically initialize framebuffer system with the frame queue and dirty rect
+    ESP_LOGI(TAG, "Initializing framebuffer system (frame queue + dirty rect)...");
     if (!init_framebuffer()) {
         ESP_LOGE(TAG, "Failed to initialize framebuffer system");
         return false;
@@ -167,13 +253,15 @@ bool TFT7735V::begin(uint32_t freq_hz) {
     }
     
     // Set current framebuffer to first buffer
-    current_framebuffer = framebuffer_a;
+    current_framebuffer = framebuffers[0];
     
     ESP_LOGI(TAG, "Framebuffer system initialized successfully");
-    ESP_LOGI(TAG, "- Triple buffering: ENABLED");
+    ESP_LOGI(TAG, "- Frame queue: %d buffers", framebuffer_count);
     ESP_LOGI(TAG, "- Dirty rectangle optimization: ENABLED");
-    ESP_LOGI(TAG, "- Total PSRAM usage: %d KB", (framebuffer_size * 3) / 1024);
+    ESP_LOGI(TAG, "- Total PSRAM usage: %d KB", (framebuffer_size * framebuffer_count) / 1024);
     ESP_LOGI(TAG, "- Total SRAM usage: %d KB", (SRAM_BUFFER_SIZE * 2) / 1024);
+    frame_stats.psram_bytes = framebuffer_size * framebuffer_count;
+    frame_stats.sram_bytes = SRAM_BUFFER_SIZE * 2;
     
     initialized = true;
     ESP_LOGI(TAG, "TFT7735V initialized successfully with high-performance mode");
@@ -186,16 +274,12 @@ void TFT7735V::end() {
     // Clean up framebuffer system first
     free_framebuffer();
     free_double_buffering();
-    
-    if (spi_device) {
-        spi_bus_remove_device(spi_device);
-        spi_device = nullptr;
+    for (uint8_t i = 0; i < canvas_panel_count; i++) {
+        canvas_panels[i].panel->canvas_master = nullptr;
     }
+    canvas_panel_count = 0;
     
-    if (spi_initialized) {
-        spi_bus_free(SPI2_HOST);
-        spi_initialized = false;
-    }
+    free_transport();
     
     if (pwm_initialized) {
         ledc_stop(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_0, 0);
@@ -206,6 +290,252 @@ void TFT7735V::end() {
     ESP_LOGI(TAG, "TFT7735V deinitialized");
 }
 
+void TFT7735V::setParallelPins(const tft_i80_pins_t& pins) {
+    i80_pins = pins;
+}
+
+tft_transport_t TFT7735V::getTransport() const {
+    return transport;
+}
+
+void TFT7735V::setSPIHost(spi_host_device_t host) {
+    if (initialized) {
+        ESP_LOGW(TAG, "setSPIHost() must be called before begin()");
+        return;
+    }
+    spi_host = host;
+}
+
+void TFT7735V::setBusPolicy(tft_bus_policy_t policy, uint8_t chunks_per_group) {
+    // Don't change locking under a running transfer
+    waitForDisplayDone();
+    
+    bus_policy = policy;
+    bus_chunks_per_group = (chunks_per_group > 0) ? chunks_per_group : 1;
+    if (transport != TFT_TRANSPORT_SPI_MASTER) {
+        ESP_LOGW(TAG, "Bus policy only applies to the spi_master transport");
+    }
+    ESP_LOGI(TAG, "Bus policy: %d, %d chunks per group", policy, bus_chunks_per_group);
+}
+
+tft_bus_policy_t TFT7735V::getBusPolicy() const {
+    return bus_policy;
+}
+
+// Take the bus for a chunk group or frame so other devices cannot interleave
+// between the address window and the pixel data of a chunk
+void TFT7735V::bus_acquire() {
+    if (bus_acquired || bus_policy == TFT_BUS_LOCK_PER_TRANSACTION || spi_device == nullptr) {
+        return;
+    }
+    
+    int64_t start_us = esp_timer_get_time();
+    esp_err_t ret = spi_device_acquire_bus(spi_device, portMAX_DELAY);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to acquire SPI bus: %s", esp_err_to_name(ret));
+        return;
+    }
+    frame_bus_wait_us += (uint32_t)(esp_timer_get_time() - start_us);
+    bus_acquired = true;
+    bus_chunks_held = 0;
+}
+
+void TFT7735V::bus_release() {
+    if (!bus_acquired) {
+        return;
+    }
+    spi_device_release_bus(spi_device);
+    bus_acquired = false;
+}
+
+// Called after each chunk: give other devices a turn at group boundaries
+void TFT7735V::bus_chunk_done() {
+    if (!bus_acquired) {
+        return;
+    }
+    bus_chunks_held++;
+    if (bus_policy == TFT_BUS_LOCK_PER_CHUNK_GROUP && bus_chunks_held >= bus_chunks_per_group) {
+        bus_release();
+    }
+}
+
+bool TFT7735V::init_transport() {
+    if (transport == TFT_TRANSPORT_ESP_LCD_I80) {
+#if TFT7735V_HAS_I80
+        esp_lcd_i80_bus_config_t bus_config = {};
+        bus_config.dc_gpio_num = dc_pin;
+        bus_config.wr_gpio_num = i80_pins.wr;
+        bus_config.clk_src = LCD_CLK_SRC_DEFAULT;
+        for (int i = 0; i < 8; i++) {
+            bus_config.data_gpio_nums[i] = i80_pins.data[i];
+        }
+        bus_config.bus_width = 8;
+        bus_config.max_transfer_bytes = SRAM_BUFFER_SIZE;
+        
+        esp_err_t ret = esp_lcd_new_i80_bus(&bus_config, &i80_bus);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to create I80 bus: %s", esp_err_to_name(ret));
+            i80_bus = nullptr;
+            return false;
+        }
+        
+        if (!init_esp_lcd_io()) {
+            free_transport();
+            return false;
+        }
+        return true;
+#else
+        ESP_LOGE(TAG, "I80 parallel bus not supported on this target");
+        return false;
+#endif
+    }
+    
+    // Initialize SPI bus (shared by the spi_master and esp_lcd SPI backends)
+    spi_bus_config_t buscfg = {};
+    buscfg.mosi_io_num = pins.mosi;
+    buscfg.miso_io_num = pins.miso; // Only needed for readback/calibration
+    buscfg.sclk_io_num = pins.sclk;
+    buscfg.quadwp_io_num = -1;
+    buscfg.quadhd_io_num = -1;
+    buscfg.max_transfer_sz = SRAM_BUFFER_SIZE; // One staged chunk per transaction
+    
+    esp_err_t ret = spi_bus_initialize(spi_host, &buscfg, SPI_DMA_CH_AUTO);
+    if (ret == ESP_ERR_INVALID_STATE) {
+        // Bus already set up by another device (e.g. SD card): share it
+        ESP_LOGI(TAG, "SPI bus already initialized, sharing it");
+    } else if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize SPI bus: %s", esp_err_to_name(ret));
+        return false;
+    } else {
+        spi_initialized = true;
+    }
+    
+    if (transport == TFT_TRANSPORT_ESP_LCD_SPI) {
+#if TFT7735V_HAS_ESP_LCD
+        if (!init_esp_lcd_io()) {
+            free_transport();
+            return false;
+        }
+        return true;
+#else
+        ESP_LOGE(TAG, "esp_lcd not available in this build");
+        free_transport();
+        return false;
+#endif
+    }
+    
+    // Configure SPI device
+    spi_device_interface_config_t devcfg = {};
+    devcfg.clock_speed_hz = spi_frequency;
+    devcfg.mode = 0; // SPI mode 0
+    devcfg.spics_io_num = cs_pin;
+    devcfg.queue_size = 7;
+    devcfg.pre_cb = nullptr; // We'll handle DC manually
+    devcfg.flags = SPI_DEVICE_HALFDUPLEX;
+    
+    ret = spi_bus_add_device(spi_host, &devcfg, &spi_device);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to add SPI device: %s", esp_err_to_name(ret));
+        spi_device = nullptr;
+        free_transport();
+        return false;
+    }
+    return true;
+}
+
+#if TFT7735V_HAS_ESP_LCD
+// Color transfer finished (ISR context): wake the task waiting for a free SRAM buffer
+bool IRAM_ATTR TFT7735V::on_color_trans_done(esp_lcd_panel_io_handle_t io, esp_lcd_panel_io_event_data_t* edata, void* user_ctx) {
+    TFT7735V* tft = (TFT7735V*)user_ctx;
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    xSemaphoreGiveFromISR(tft->transfer_done_semaphore, &higher_priority_task_woken);
+    return higher_priority_task_woken == pdTRUE;
+}
+
+bool TFT7735V::init_esp_lcd_io() {
+    if (transfer_done_semaphore == nullptr) {
+        transfer_done_semaphore = xSemaphoreCreateCounting(16, 0);
+        if (transfer_done_semaphore == nullptr) {
+            ESP_LOGE(TAG, "Failed to create transfer done semaphore");
+            return false;
+        }
+    }
+    transfers_in_flight = 0;
+    ramwr_pending = false;
+    
+    esp_err_t ret = ESP_FAIL;
+    if (transport == TFT_TRANSPORT_ESP_LCD_SPI) {
+        esp_lcd_panel_io_spi_config_t io_config = {};
+        io_config.cs_gpio_num = cs_pin;
+        io_config.dc_gpio_num = dc_pin;
+        io_config.spi_mode = 0;
+        io_config.pclk_hz = spi_frequency;
+        io_config.trans_queue_depth = 10;
+        io_config.on_color_trans_done = on_color_trans_done;
+        io_config.user_ctx = this;
+        io_config.lcd_cmd_bits = 8;
+        io_config.lcd_param_bits = 8;
+        ret = esp_lcd_new_panel_io_spi((esp_lcd_spi_bus_handle_t)spi_host, &io_config, &lcd_io);
+    }
+#if TFT7735V_HAS_I80
+    else if (transport == TFT_TRANSPORT_ESP_LCD_I80) {
+        esp_lcd_panel_io_i80_config_t io_config = {};
+        io_config.cs_gpio_num = cs_pin;
+        io_config.pclk_hz = spi_frequency;
+        io_config.trans_queue_depth = 10;
+        io_config.on_color_trans_done = on_color_trans_done;
+        io_config.user_ctx = this;
+        io_config.lcd_cmd_bits = 8;
+        io_config.lcd_param_bits = 8;
+        io_config.dc_levels.dc_idle_level = 0;
+        io_config.dc_levels.dc_cmd_level = 0;
+        io_config.dc_levels.dc_dummy_level = 0;
+        io_config.dc_levels.dc_data_level = 1;
+        ret = esp_lcd_new_panel_io_i80(i80_bus, &io_config, &lcd_io);
+    }
+#endif
+    
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create esp_lcd panel IO: %s", esp_err_to_name(ret));
+        lcd_io = nullptr;
+        return false;
+    }
+    return true;
+}
+#endif
+
+void TFT7735V::free_transport() {
+#if TFT7735V_HAS_ESP_LCD
+    if (lcd_io != nullptr) {
+        wait_transfers(0);
+        esp_lcd_panel_io_del(lcd_io);
+        lcd_io = nullptr;
+    }
+#if TFT7735V_HAS_I80
+    if (i80_bus != nullptr) {
+        esp_lcd_del_i80_bus(i80_bus);
+        i80_bus = nullptr;
+    }
+#endif
+    if (transfer_done_semaphore != nullptr) {
+        vSemaphoreDelete(transfer_done_semaphore);
+        transfer_done_semaphore = nullptr;
+    }
+#endif
+    
+    if (spi_device) {
+        bus_release();
+        spi_bus_remove_device(spi_device);
+        spi_device = nullptr;
+    }
+    
+    // Only free the bus if we initialized it
+    if (spi_initialized) {
+        spi_bus_free(spi_host);
+        spi_initialized = false;
+    }
+}
+
 void TFT7735V::hardware_reset() {
     if (reset_pin != GPIO_NUM_NC) {
         gpio_set_level(reset_pin, 0);
@@ -216,6 +546,20 @@ void TFT7735V::hardware_reset() {
 }
 
 void TFT7735V::write_command(uint8_t cmd) {
+#if TFT7735V_HAS_ESP_LCD
+    if (lcd_io != nullptr) {
+        // RAMWR is sent as the command phase of the following color transfer
+        if (cmd == ST7735_RAMWR) {
+            ramwr_pending = true;
+            return;
+        }
+        esp_err_t ret = esp_lcd_panel_io_tx_param(lcd_io, cmd, nullptr, 0);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to send command: %s", esp_err_to_name(ret));
+        }
+        return;
+    }
+#endif
     gpio_set_level(dc_pin, 0); // Command mode
     
     spi_transaction_t t = {};
@@ -230,89 +574,140 @@ void TFT7735V::write_command(uint8_t cmd) {
 }
 
 void TFT7735V::write_data(uint8_t data) {
-    gpio_set_level(dc_pin, 1); // Data mode
-    
-    spi_transaction_t t = {};
-    t.length = 8; // 8 bits
-    t.tx_data[0] = data;
-    t.flags = SPI_TRANS_USE_TXDATA;
-    
-    esp_err_t ret = spi_device_polling_transmit(spi_device, &t);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to send data: %s", esp_err_to_name(ret));
-    }
+    write_data_buffer(&data, 1);
 }
 
 void TFT7735V::write_data16(uint16_t data) {
+    uint8_t bytes[2] = { (uint8_t)(data >> 8), (uint8_t)(data & 0xFF) };
+    write_data_buffer(bytes, 2);
+}
+
+void TFT7735V::write_data_buffer(const uint8_t* data, size_t len) {
+    write_pixels(data, len, true);
+}
+
+// Send pixel data following RAMWR. With esp_lcd the transfer is queued and
+// completes asynchronously unless wait is set; the buffer must stay valid
+// until then.
+void TFT7735V::write_pixels(const void* data, size_t len, bool wait) {
+    (void)wait;
+    if (len == 0) return;
+    
+#if TFT7735V_HAS_ESP_LCD
+    if (lcd_io != nullptr) {
+        int cmd = ramwr_pending ? ST7735_RAMWR : -1;
+        ramwr_pending = false;
+        
+        esp_err_t ret = esp_lcd_panel_io_tx_color(lcd_io, cmd, data, len);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to queue color transfer: %s", esp_err_to_name(ret));
+            return;
+        }
+        transfers_in_flight++;
+        if (wait) {
+            wait_transfers(0);
+        }
+        return;
+    }
+#endif
+    
     gpio_set_level(dc_pin, 1); // Data mode
     
     spi_transaction_t t = {};
-    t.length = 16; // 16 bits
-    t.tx_data[0] = data >> 8;
-    t.tx_data[1] = data & 0xFF;
-    t.flags = SPI_TRANS_USE_TXDATA;
+    t.length = len * 8; // Length in bits
+    if (len <= 4) {
+        memcpy(t.tx_data, data, len);
+        t.flags = SPI_TRANS_USE_TXDATA;
+    } else {
+        t.tx_buffer = data;
+    }
     
     esp_err_t ret = spi_device_polling_transmit(spi_device, &t);
     if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to send 16-bit data: %s", esp_err_to_name(ret));
+        ESP_LOGE(TAG, "Failed to send data buffer: %s", esp_err_to_name(ret));
     }
 }
 
-void TFT7735V::write_data_buffer(const uint8_t* data, size_t len) {
+// Block until at most max_in_flight queued color transfers remain (esp_lcd only;
+// spi_master transfers are synchronous)
+void TFT7735V::wait_transfers(uint8_t max_in_flight) {
+    (void)max_in_flight;
+#if TFT7735V_HAS_ESP_LCD
+    while (transfers_in_flight > max_in_flight && transfer_done_semaphore != nullptr) {
+        xSemaphoreTake(transfer_done_semaphore, portMAX_DELAY);
+        transfers_in_flight--;
+    }
+#endif
+}
+
+void TFT7735V::send_command(uint8_t cmd, const uint8_t* data, size_t len) {
+#if TFT7735V_HAS_ESP_LCD
+    if (lcd_io != nullptr) {
+        esp_err_t ret = esp_lcd_panel_io_tx_param(lcd_io, cmd, data, len);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to send command 0x%02X: %s", cmd, esp_err_to_name(ret));
+        }
+        return;
+    }
+#endif
+    write_command(cmd);
     if (len == 0) return;
     
     gpio_set_level(dc_pin, 1); // Data mode
     
+    // Short parameter lists go in the transaction itself (no DMA buffer needed)
     spi_transaction_t t = {};
     t.length = len * 8; // Length in bits
-    t.tx_buffer = data;
+    if (len <= 4) {
+        memcpy(t.tx_data, data, len);
+        t.flags = SPI_TRANS_USE_TXDATA;
+    } else {
+        t.tx_buffer = data;
+    }
     
     esp_err_t ret = spi_device_polling_transmit(spi_device, &t);
     if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to send data buffer: %s", esp_err_to_name(ret));
+        ESP_LOGE(TAG, "Failed to send command 0x%02X data: %s", cmd, esp_err_to_name(ret));
     }
 }
 
 void TFT7735V::init_sequence() {
-    ESP_LOGI(TAG, "Starting display initialization sequence");
-    
-    // Software reset
-    write_command(ST7735_SWRESET);
-    vTaskDelay(pdMS_TO_TICKS(150));
-    
-    // Sleep out
-    write_command(ST7735_SLPOUT);
-    vTaskDelay(pdMS_TO_TICKS(500));
-    
-    // Color mode - 16-bit color
-    write_command(ST7735_COLMOD);
-    write_data(0x05); // 16-bit color (RGB565)
-    
-    // Memory access control
-    write_command(ST7735_MADCTL);
-    write_data(0x00); // Default orientation
-    
-    // Column address set (0..127)
-    write_command(ST7735_CASET);
-    write_data(0x00);
-    write_data(0x00);
-    write_data(0x00);
-    write_data(0x7F); // 127
-    
-    // Row address set (0..159)
-    write_command(ST7735_RASET);
-    write_data(0x00);
-    write_data(0x00);
-    write_data(0x00);
-    write_data(0x9F); // 159
-    
-    // Normal display mode on
-    write_command(ST7735_NORON);
-    vTaskDelay(pdMS_TO_TICKS(10));
+    ESP_LOGI(TAG, "Starting %s initialization sequence", panel->name);
+    
+    // Walk the profile's init command table
+    const uint8_t* p = panel->init_cmds;
+    uint8_t num_commands = *p++;
+    while (num_commands--) {
+        uint8_t cmd = *p++;
+        uint8_t num_args = *p++;
+        bool has_delay = num_args & TFT_INIT_DELAY;
+        num_args &= ~TFT_INIT_DELAY;
+        
+        send_command(cmd, p, num_args);
+        p += num_args;
+        
+        if (has_delay) {
+            uint16_t ms = *p++;
+            if (ms == 255) ms = 500;
+            vTaskDelay(pdMS_TO_TICKS(ms));
+        }
+    }
     
-    // Display on
-    write_command(ST7735_DISPON);
-    vTaskDelay(pdMS_TO_TICKS(100));
+    // Apply the current rotation on top of the profile defaults
+    uint8_t madctl = panel->madctl[rotation];
+    send_command(ST7735_MADCTL, &madctl, 1);
+    
+    if (gamma_custom) {
+        send_command(ST7735_GMCTRP1, gamma_positive, panel->gamma_bytes);
+        send_command(ST7735_GMCTRN1, gamma_negative, panel->gamma_bytes);
+    }
+    
+    // The init table ends in normal display mode
+    partial_mode = false;
+    partial_idle = false;
+    
+    // Scan position reference for tear avoidance
+    scan_sync_us = esp_timer_get_time();
     
     ESP_LOGI(TAG, "Display initialization sequence completed");
 }
@@ -336,117 +731,970 @@ void TFT7735V::invert_display(bool invert) {
 }
 
 void TFT7735V::set_rotation(uint8_t rotation) {
+    // The partial strip is a range of rows of the old orientation
+    exitPartialMode();
+    if (canvas_panel_count != 0 && initialized && rotation % 4 != this->rotation) {
+        ESP_LOGW(TAG, "Rotation is fixed in canvas mode");
+        return;
+    }
+    if (fb_window && rotation % 4 != this->rotation) {
+        ESP_LOGW(TAG, "Rotation is fixed with a framebuffer window");
+        return;
+    }
     this->rotation = rotation % 4;
-    uint8_t madctl = 0;
     
-    switch (this->rotation) {
-        case 0: // Portrait (0°)
-            madctl = 0x00; // No rotation
-            width = ST7735_WIDTH;
-            height = ST7735_HEIGHT;
-            break;
-        case 1: // Landscape (90° clockwise)
-            madctl = 0x60; // MV=1, MX=1, MY=0, RGB=0
-            width = ST7735_HEIGHT;
-            height = ST7735_WIDTH;
-            break;
-        case 2: // Portrait inverted (180°)
-            madctl = 0xC0; // MX=1, MY=1, MV=0, RGB=0
-            width = ST7735_WIDTH;
-            height = ST7735_HEIGHT;
-            break;
-        case 3: // Landscape inverted (270° clockwise)
-            madctl = 0xA0; // MV=1, MX=0, MY=1, RGB=0
-            width = ST7735_HEIGHT;
-            height = ST7735_WIDTH;
-            break;
-    }
+    // 0: portrait, 1: landscape (90° CW), 2: portrait inverted, 3: landscape inverted.
+    // MADCTL bits differ per controller, so they come from the profile.
+    uint8_t madctl = panel->madctl[this->rotation];
+    
+    // Rows per chunk depend on the (rotated) width
+    set_logical_size();
+    
       ESP_LOGI(TAG, "Setting rotation %d, MADCTL=0x%02X, Width=%d, Height=%d", 
              this->rotation, madctl, width, height);
-    write_command(ST7735_MADCTL);
-    write_data(madctl);
+    send_command(ST7735_MADCTL, &madctl, 1);
     
     // Add small delay after MADCTL command
     vTaskDelay(pdMS_TO_TICKS(10));
     
     // Reset address window to full screen after rotation
-    set_addr_window(0, 0, width - 1, height - 1);
+    set_addr_window_raw(0, 0, panel_w - 1, panel_h - 1);
 }
 
 void TFT7735V::set_addr_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
-    // Column address set
-    uint16_t sx0 = x0 + (x_offset >= 0 ? (uint16_t)x_offset : 0);
-    uint16_t sy0 = y0 + (y_offset >= 0 ? (uint16_t)y_offset : 0);
-    uint16_t sx1 = x1 + (x_offset >= 0 ? (uint16_t)x_offset : 0);
-    uint16_t sy1 = y1 + (y_offset >= 0 ? (uint16_t)y_offset : 0);
+    trace_scope trace(this, TFT_TRACE_OP_ADDR_WINDOW, { x0, y0, x1, y1 });
+    set_addr_window_raw(x0, y0, x1, y1);
+}
 
-    write_command(ST7735_CASET);
-    write_data(sx0 >> 8);
-    write_data(sx0 & 0xFF);
-    write_data(sx1 >> 8);
-    write_data(sx1 & 0xFF);
+// Also used by the display task, so never traced
+void TFT7735V::set_addr_window_raw(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+    // Panel GRAM offset for this rotation plus the user offset
+    int16_t xo = panel->col_offset[rotation] + x_offset;
+    int16_t yo = panel->row_offset[rotation] + y_offset;
+    uint16_t sx0 = x0 + (xo >= 0 ? (uint16_t)xo : 0);
+    uint16_t sy0 = y0 + (yo >= 0 ? (uint16_t)yo : 0);
+    uint16_t sx1 = x1 + (xo >= 0 ? (uint16_t)xo : 0);
+    uint16_t sy1 = y1 + (yo >= 0 ? (uint16_t)yo : 0);
+
+    // Column address set
+    uint8_t caset[4] = { (uint8_t)(sx0 >> 8), (uint8_t)(sx0 & 0xFF), (uint8_t)(sx1 >> 8), (uint8_t)(sx1 & 0xFF) };
+    send_command(ST7735_CASET, caset, 4);
     
     // Row address set
-    write_command(ST7735_RASET);
-    write_data(sy0 >> 8);
-    write_data(sy0 & 0xFF);
-    write_data(sy1 >> 8);
-    write_data(sy1 & 0xFF);
+    uint8_t raset[4] = { (uint8_t)(sy0 >> 8), (uint8_t)(sy0 & 0xFF), (uint8_t)(sy1 >> 8), (uint8_t)(sy1 & 0xFF) };
+    send_command(ST7735_RASET, raset, 4);
     
     // Memory write
     write_command(ST7735_RAMWR);
 }
 
-void TFT7735V::setOffsets(int16_t x, int16_t y) {
-    x_offset = x;
-    y_offset = y;
+// Scan (gate) line showing panel row y: the GRAM row set_addr_window_raw()
+// addresses, mirrored against the scan direction by MADCTL MY in rotation 2
+uint16_t TFT7735V::scan_line(uint16_t y) const {
+    int16_t yo = panel->row_offset[rotation] + y_offset;
+    uint16_t row = y + (yo >= 0 ? (uint16_t)yo : 0);
+    if (rotation == 2 && row < panel->gate_lines) {
+        row = panel->gate_lines - 1 - row;
+    }
+    return row;
 }
 
-void TFT7735V::getOffsets(int16_t &x, int16_t &y) const {
-    x = x_offset;
-    y = y_offset;
+bool TFT7735V::setPanel(const tft_panel_profile_t& profile) {
+    if (initialized) {
+        ESP_LOGW(TAG, "setPanel() must be called before begin()");
+        return false;
+    }
+    
+    panel = &profile;
+    gamma_custom = false;  // Curve length and meaning are per controller
+    framebuffer_size = panel->native_width * panel->native_height * sizeof(uint16_t);
+    set_logical_size();
+    
+    ESP_LOGI(TAG, "Panel profile: %s (%dx%d), %zu bytes per framebuffer", 
+             panel->name, panel->native_width, panel->native_height, framebuffer_size);
+    return true;
 }
 
-void TFT7735V::draw_pixel(uint16_t x, uint16_t y, uint16_t color) {
-    if (framebuffer_enabled) {
-        fb_draw_pixel(x, y, color);
-    } else {
-        // Direct mode - original implementation
-        if (x >= width || y >= height) return;
-        
-        set_addr_window(x, y, x, y);
-        write_data16(color);
+const tft_panel_profile_t& TFT7735V::getPanel() const {
+    return *panel;
+}
+
+// Panel size for the rotation, drawing size for the resolution mode
+void TFT7735V::set_logical_size() {
+    panel_w = (rotation & 1) ? panel->native_height : panel->native_width;
+    panel_h = (rotation & 1) ? panel->native_width : panel->native_height;
+    width = (panel_w + res_shift) >> res_shift;
+    height = (panel_h + res_shift) >> res_shift;
+    for (uint8_t i = 0; i < canvas_panel_count; i++) {
+        // The canvas spans every panel
+        const canvas_panel_t& p = canvas_panels[i];
+        width = std::max<uint16_t>(width, p.x + p.panel->width);
+        height = std::max<uint16_t>(height, p.y + p.panel->height);
     }
+    if (fb_window) {
+        // A window set before setPanel() may not fit the new size
+        fb_w = std::min<int32_t>(fb_w, std::max<int32_t>(0, width - fb_x));
+        fb_h = std::min<int32_t>(fb_h, std::max<int32_t>(0, height - fb_y));
+        if (fb_w == 0 || fb_h == 0) {
+            ESP_LOGW(TAG, "Framebuffer window is off screen, buffering the whole screen");
+            fb_window = false;
+        }
+    }
+    if (!fb_window) {
+        fb_x = 0;
+        fb_y = 0;
+        fb_w = width;
+        fb_h = height;
+    }
+    update_chunk_geometry();
 }
 
-void TFT7735V::fill_screen(uint16_t color) {
-    if (framebuffer_enabled) {
-        fb_fill_screen(color);
-    } else {
-        // Direct mode - original implementation
-        fill_rect(0, 0, width, height, color);
+void TFT7735V::update_chunk_geometry() {
+    // As many full rows as fit into one SRAM buffer at the current width;
+    // at half resolution a row is staged as two panel rows of twice the width.
+    // On a canvas this panel only sends its own part.
+    uint16_t rows_w = canvas_panel_count ? panel_w : width;
+    uint16_t rows_h = canvas_panel_count ? panel_h : height;
+    chunk_height = SRAM_BUFFER_SIZE / ((rows_w * sizeof(uint16_t)) << (2 * res_shift));
+    if (chunk_height == 0) chunk_height = 1;
+    total_chunks = (rows_h + chunk_height - 1) / chunk_height;
+    
+    // Tile grid follows the rotated size; old flags no longer map to pixels
+    tiles_x = (width + TFT_TILE_SIZE - 1) >> TFT_TILE_SHIFT;
+    tiles_y = (height + TFT_TILE_SIZE - 1) >> TFT_TILE_SHIFT;
+    reset_tile_tables();
+}
+
+// Tile tables live in internal RAM, sized for the panel in any rotation
+bool TFT7735V::init_tile_tables() {
+    size_t tiles = ((panel->native_width + TFT_TILE_SIZE - 1) >> TFT_TILE_SHIFT) *
+                   ((panel->native_height + TFT_TILE_SIZE - 1) >> TFT_TILE_SHIFT);
+    tiles = std::max<size_t>(tiles, (size_t)tiles_x * tiles_y);   // Canvas
+    for (int i = 0; i < framebuffer_count; i++) {
+        if (tile_lazy[i] != nullptr) continue;
+        tile_lazy[i] = (uint8_t*)heap_caps_malloc(tiles, MALLOC_CAP_INTERNAL);
+        tile_color[i] = (uint16_t*)heap_caps_malloc(tiles * sizeof(uint16_t), MALLOC_CAP_INTERNAL);
+        if (tile_lazy[i] == nullptr || tile_color[i] == nullptr) {
+            free_tile_tables();
+            return false;
+        }
     }
+    reset_tile_tables();
+    return true;
 }
 
-void TFT7735V::fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
-    if (framebuffer_enabled) {
-        fb_fill_rect(x, y, w, h, color);
+void TFT7735V::free_tile_tables() {
+    for (int i = 0; i < TFT_MAX_FRAMEBUFFERS; i++) {
+        if (tile_lazy[i] != nullptr) {
+            heap_caps_free(tile_lazy[i]);
+            tile_lazy[i] = nullptr;
+        }
+        if (tile_color[i] != nullptr) {
+            heap_caps_free(tile_color[i]);
+            tile_color[i] = nullptr;
+        }
+        lazy_tile_count[i] = 0;
+    }
+}
+
+void TFT7735V::reset_tile_tables() {
+    for (int i = 0; i < TFT_MAX_FRAMEBUFFERS; i++) {
+        if (tile_lazy[i] != nullptr) {
+            memset(tile_lazy[i], 0, tiles_x * tiles_y);
+        }
+        lazy_tile_count[i] = 0;
+    }
+}
+
+// Write out the flagged tiles of a buffer that overlap the given box
+void TFT7735V::materialize_tiles(uint8_t buffer_idx, int32_t x, int32_t y, int32_t w, int32_t h) {
+    if (lazy_tile_count[buffer_idx] == 0) return;
+    
+    uint16_t* fb = framebuffers[buffer_idx];
+    if (fb == nullptr) return;
+    
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > width) w = width - x;
+    if (y + h > height) h = height - y;
+    if (w <= 0 || h <= 0) return;
+    
+    int32_t tx0 = x >> TFT_TILE_SHIFT, tx1 = (x + w - 1) >> TFT_TILE_SHIFT;
+    int32_t ty0 = y >> TFT_TILE_SHIFT, ty1 = (y + h - 1) >> TFT_TILE_SHIFT;
+    
+    for (int32_t ty = ty0; ty <= ty1; ty++) {
+        for (int32_t tx = tx0; tx <= tx1; tx++) {
+            uint16_t t = ty * tiles_x + tx;
+            if (!tile_lazy[buffer_idx][t]) continue;
+            
+            uint16_t color = tile_color[buffer_idx][t];
+            uint16_t px0 = tx << TFT_TILE_SHIFT, py0 = ty << TFT_TILE_SHIFT;
+            uint16_t px1 = std::min<uint16_t>(width, px0 + TFT_TILE_SIZE);
+            uint16_t py1 = std::min<uint16_t>(height, py0 + TFT_TILE_SIZE);
+            for (uint16_t row = py0; row < py1; row++) {
+                std::fill(fb + row * width + px0, fb + row * width + px1, color);
+            }
+            
+            tile_lazy[buffer_idx][t] = 0;
+            lazy_tile_count[buffer_idx]--;
+        }
+    }
+}
+
+// Every framebuffer write goes through here first
+void TFT7735V::materialize_render(int32_t x, int32_t y, int32_t w, int32_t h) {
+    if (lazy_tile_count[render_buffer_idx] != 0) {
+        materialize_tiles(render_buffer_idx, x, y, w, h);
+    }
+}
+
+void TFT7735V::setLazyClear(bool enable) {
+    if (enable == lazy_clear_enabled) return;
+    
+    if (!enable) {
+        // Make every buffer self-contained again
+        waitForDisplayDone();
+        for (uint8_t i = 0; i < framebuffer_count; i++) {
+            materialize_tiles(i, 0, 0, width, height);
+        }
+    } else if (tile_lazy[0] == nullptr) {
+        ESP_LOGW(TAG, "Lazy clear needs the framebuffer tile tables");
+        return;
+    }
+    lazy_clear_enabled = enable;
+}
+
+bool TFT7735V::isLazyClearEnabled() const {
+    return lazy_clear_enabled;
+}
+
+// Color correction
+bool TFT7735V::setGammaCurves(const uint8_t* positive, const uint8_t* negative) {
+    if (positive == nullptr || negative == nullptr) return false;
+    if (panel->gamma_bytes == 0 || panel->gamma_bytes > TFT_GAMMA_MAX_BYTES) {
+        ESP_LOGW(TAG, "%s has no gamma curve upload", panel->name);
+        return false;
+    }
+    
+    memcpy(gamma_positive, positive, panel->gamma_bytes);
+    memcpy(gamma_negative, negative, panel->gamma_bytes);
+    gamma_custom = true;
+    
+    // Before begin() the curves go out at the end of the init sequence
+    if (initialized) {
+        waitForDisplayDone();
+        bus_release();
+        send_command(ST7735_GMCTRP1, gamma_positive, panel->gamma_bytes);
+        send_command(ST7735_GMCTRN1, gamma_negative, panel->gamma_bytes);
+    }
+    return true;
+}
+
+uint8_t TFT7735V::getGammaCurveLength() const {
+    return panel->gamma_bytes;
+}
+
+void TFT7735V::setColorLUT(const uint8_t* red, const uint8_t* green, const uint8_t* blue) {
+    if (red == nullptr && green == nullptr && blue == nullptr) {
+        clearColorLUT();
+        return;
+    }
+    
+    // Never change the tables under a running transfer
+    waitForDisplayDone();
+    
+    // Entries hold each channel at its RGB565 position, already byte-swapped,
+    // so staging ORs three lookups instead of packing and swapping
+    for (uint16_t i = 0; i < 32; i++) {
+        uint16_t r = red ? std::min<uint16_t>(red[i], 31) : i;
+        uint16_t b = blue ? std::min<uint16_t>(blue[i], 31) : i;
+        color_lut[i] = __builtin_bswap16(r << 11);
+        color_lut[96 + i] = __builtin_bswap16(b);
+    }
+    for (uint16_t i = 0; i < 64; i++) {
+        uint16_t g = green ? std::min<uint16_t>(green[i], 63) : i;
+        color_lut[32 + i] = __builtin_bswap16(g << 5);
+    }
+    color_lut_enabled = true;
+    
+    // Pixels already on the panel were sent uncorrected
+    forceFullRedraw();
+}
+
+void TFT7735V::clearColorLUT() {
+    if (!color_lut_enabled) return;
+    waitForDisplayDone();
+    color_lut_enabled = false;
+    forceFullRedraw();
+}
+
+bool TFT7735V::isColorLUTEnabled() const {
+    return color_lut_enabled;
+}
+
+// Partial display mode
+bool TFT7735V::setHalfResolution(bool enable, bool smooth) {
+    if (enable && (!framebuffer_enabled || current_framebuffer == nullptr)) {
+        ESP_LOGW(TAG, "Half resolution needs the framebuffer");
+        return false;
+    }
+    if (enable && (canvas_panel_count != 0 || fb_window)) {
+        ESP_LOGW(TAG, "Half resolution is not available in canvas mode or with a framebuffer window");
+        return false;
+    }
+    
+    waitForDisplayDone();
+    if (enable && half_lines == nullptr) {
+        size_t line = (std::max(panel->native_width, panel->native_height) + 1) / 2 + 1;
+        half_lines = (uint16_t*)heap_caps_malloc(2 * line * sizeof(uint16_t), MALLOC_CAP_INTERNAL);
+        if (half_lines == nullptr) {
+            ESP_LOGE(TAG, "Failed to allocate half resolution line buffers");
+            return false;
+        }
+    }
+    
+    half_res_smooth = smooth;
+    if ((res_shift != 0) != enable) {
+        exitPartialMode();
+        res_shift = enable ? 1 : 0;
+        set_logical_size();
+        ESP_LOGI(TAG, "Resolution %dx%d on a %dx%d panel", width, height, panel_w, panel_h);
+    }
+    forceFullRedraw();
+    return true;
+}
+
+bool TFT7735V::isHalfResolution() const {
+    return res_shift != 0;
+}
+
+bool TFT7735V::addCanvasPanel(TFT7735V& other, uint16_t x, uint16_t y) {
+    if (initialized) {
+        ESP_LOGW(TAG, "addCanvasPanel() must be called before begin()");
+        return false;
+    }
+    if (fb_window || other.fb_window) {
+        ESP_LOGE(TAG, "Canvas mode is not available with a framebuffer window");
+        return false;
+    }
+    if (canvas_panel_count >= TFT_MAX_CANVAS_PANELS) {
+        ESP_LOGE(TAG, "At most %d canvas panels", TFT_MAX_CANVAS_PANELS);
+        return false;
+    }
+    if (&other == this || !other.initialized || other.canvas_master != nullptr ||
+        other.canvas_panel_count != 0 || other.display_queue == nullptr) {
+        ESP_LOGE(TAG, "Canvas panel must be another begun panel, not part of a canvas");
+        return false;
+    }
+    
+    // The panel only stages from the canvas now
+    if (other.res_shift != 0) other.setHalfResolution(false);
+    other.exitPartialMode();
+    other.disableFramebuffer();
+    other.canvas_master = this;
+    other.canvas_x = x;
+    other.canvas_y = y;
+    
+    canvas_panel_t p = { &other, x, y };
+    canvas_panels[canvas_panel_count++] = p;
+    ESP_LOGI(TAG, "Canvas panel %d: %dx%d at (%d,%d)", canvas_panel_count, other.width, other.height, x, y);
+    return true;
+}
+
+uint8_t TFT7735V::getCanvasPanelCount() const {
+    return canvas_panel_count;
+}
+
+bool TFT7735V::setFramebufferWindow(int16_t x, int16_t y, uint16_t w, uint16_t h) {
+    if (initialized) {
+        ESP_LOGW(TAG, "setFramebufferWindow() must be called before begin()");
+        return false;
+    }
+    if (canvas_panel_count != 0) {
+        ESP_LOGE(TAG, "A framebuffer window is not available in canvas mode");
+        return false;
+    }
+    int32_t x0 = std::max<int32_t>(0, x), y0 = std::max<int32_t>(0, y);
+    int32_t x1 = std::min<int32_t>(width, (int32_t)x + w), y1 = std::min<int32_t>(height, (int32_t)y + h);
+    if (x0 >= x1 || y0 >= y1) {
+        ESP_LOGE(TAG, "Framebuffer window is off screen");
+        return false;
+    }
+    
+    // Direct drawing and the display task share the address window
+    if (gram_mutex == nullptr) {
+        gram_mutex = xSemaphoreCreateRecursiveMutex();
+        if (gram_mutex == nullptr) {
+            ESP_LOGE(TAG, "Failed to create GRAM mutex");
+            return false;
+        }
+    }
+    
+    fb_window = true;
+    fb_x = x0;
+    fb_y = y0;
+    fb_w = x1 - x0;
+    fb_h = y1 - y0;
+    ESP_LOGI(TAG, "Framebuffer window %dx%d at (%d,%d), %zu bytes per framebuffer",
+             fb_w, fb_h, fb_x, fb_y, (size_t)fb_w * fb_h * sizeof(uint16_t));
+    return true;
+}
+
+bool TFT7735V::getFramebufferWindow(int16_t& x, int16_t& y, uint16_t& w, uint16_t& h) const {
+    x = fb_x;
+    y = fb_y;
+    w = fb_w;
+    h = fb_h;
+    return fb_window;
+}
+
+bool TFT7735V::enterPartialMode(uint16_t y, uint16_t h, bool idle) {
+    if (!initialized) {
+        ESP_LOGE(TAG, "Display not initialized");
+        return false;
+    }
+    if (rotation & 1) {
+        ESP_LOGW(TAG, "Partial mode needs rotation 0 or 2 (scan lines are rows)");
+        return false;
+    }
+    if (res_shift != 0 || canvas_panel_count != 0 || fb_window) {
+        ESP_LOGW(TAG, "Partial mode is not available at half resolution, in canvas mode or with a framebuffer window");
+        return false;
+    }
+    if (h == 0 || y >= height) return false;
+    if (y + h > height) h = height - y;
+    
+    waitForDisplayDone();
+    bus_release();
+    
+    // PTLAR counts scan lines, which run against the rows in rotation 2
+    uint16_t start = std::min(scan_line(y), scan_line(y + h - 1));
+    uint16_t end = std::max(scan_line(y), scan_line(y + h - 1));
+    uint8_t ptlar[4] = { (uint8_t)(start >> 8), (uint8_t)start, (uint8_t)(end >> 8), (uint8_t)end };
+    send_command(ST7735_PTLAR, ptlar, 4);
+    if (!partial_mode) {
+        write_command(ST7735_PTLON);
+    }
+    if (idle != partial_idle) {
+        write_command(idle ? ST7735_IDMON : ST7735_IDMOFF);
+    }
+    
+    partial_mode = true;
+    partial_idle = idle;
+    partial_y = y;
+    partial_h = h;
+    
+    // The strip has to be sent in full once, the rest of the frame never
+    forceFullRedraw();
+    ESP_LOGI(TAG, "Partial mode: rows %d-%d%s", y, y + h - 1, idle ? ", idle" : "");
+    return true;
+}
+
+void TFT7735V::exitPartialMode() {
+    if (!partial_mode) return;
+    
+    waitForDisplayDone();
+    bus_release();
+    if (partial_idle) {
+        write_command(ST7735_IDMOFF);
+    }
+    write_command(ST7735_NORON);
+    partial_mode = false;
+    partial_idle = false;
+    
+    // GRAM outside the strip may be stale; resend everything
+    forceFullRedraw();
+    ESP_LOGI(TAG, "Normal display mode");
+}
+
+bool TFT7735V::isPartialMode() const {
+    return partial_mode;
+}
+
+// Tear avoidance
+void TFT7735V::setTearAvoidance(bool enable) {
+    if (enable && ((scan_period_us == 0 && panel->refresh_us == 0) || panel->gate_lines == 0)) {
+        ESP_LOGW(TAG, "Tear avoidance: %s has no refresh timing", panel->name);
+        return;
+    }
+    tear_avoidance = enable;
+    ESP_LOGI(TAG, "Tear avoidance %s", enable ? "enabled" : "disabled");
+}
+
+bool TFT7735V::isTearAvoidanceEnabled() const {
+    return tear_avoidance;
+}
+
+void TFT7735V::setScanTiming(uint32_t period_us, int32_t phase_us) {
+    scan_period_us = period_us;
+    scan_phase_us = phase_us;
+}
+
+void TFT7735V::getScanTiming(uint32_t& period_us, int32_t& phase_us) const {
+    period_us = scan_period_us ? scan_period_us : panel->refresh_us;
+    phase_us = scan_phase_us;
+}
+
+// Drawing-call trace
+void TFT7735V::setTraceRecorder(TFTTraceRecorder* recorder) {
+    tracer = recorder;
+    trace_depth = 0;
+    if (tracer != nullptr) {
+        int32_t args[4] = { width, height, rotation, framebuffer_enabled };
+        tracer->record(TFT_TRACE_OP_BEGIN, args, 4, esp_timer_get_time());
+    }
+}
+
+TFTTraceRecorder* TFT7735V::getTraceRecorder() const {
+    return tracer;
+}
+
+void TFT7735V::trace_enter(uint8_t op, std::initializer_list<int32_t> args) {
+    if (trace_depth++ == 0) {
+        tracer->record(op, args.begin(), (uint8_t)args.size(), esp_timer_get_time());
+    }
+}
+
+uint32_t TFT7735V::trace_hash(const void* data, size_t len) const {
+    return (tracing() && data != nullptr) ? tft_trace_hash(data, len) : 0;
+}
+
+// Bounds as min x, min y, extent x, extent y
+void TFT7735V::trace_bounds(const tft_point_t* points, size_t count, int32_t* bounds) {
+    if (points == nullptr || count == 0) return;
+    int32_t x0 = points[0].x, y0 = points[0].y, x1 = x0, y1 = y0;
+    for (size_t i = 1; i < count; i++) {
+        x0 = std::min<int32_t>(x0, points[i].x);
+        x1 = std::max<int32_t>(x1, points[i].x);
+        y0 = std::min<int32_t>(y0, points[i].y);
+        y1 = std::max<int32_t>(y1, points[i].y);
+    }
+    bounds[0] = x0; bounds[1] = y0; bounds[2] = x1 - x0; bounds[3] = y1 - y0;
+}
+
+void TFT7735V::trace_bounds(const tft_line_t* lines, size_t count, int32_t* bounds) {
+    if (lines == nullptr || count == 0) return;
+    int32_t x0 = lines[0].x0, y0 = lines[0].y0, x1 = x0, y1 = y0;
+    for (size_t i = 0; i < count; i++) {
+        x0 = std::min<int32_t>(x0, std::min(lines[i].x0, lines[i].x1));
+        x1 = std::max<int32_t>(x1, std::max(lines[i].x0, lines[i].x1));
+        y0 = std::min<int32_t>(y0, std::min(lines[i].y0, lines[i].y1));
+        y1 = std::max<int32_t>(y1, std::max(lines[i].y0, lines[i].y1));
+    }
+    bounds[0] = x0; bounds[1] = y0; bounds[2] = x1 - x0; bounds[3] = y1 - y0;
+}
+
+void TFT7735V::trace_bounds(const tft_rect_t* rects, size_t count, int32_t* bounds) {
+    if (rects == nullptr || count == 0) return;
+    int32_t x0 = rects[0].x, y0 = rects[0].y, x1 = x0, y1 = y0;
+    for (size_t i = 0; i < count; i++) {
+        x0 = std::min<int32_t>(x0, rects[i].x);
+        x1 = std::max<int32_t>(x1, rects[i].x + rects[i].w);
+        y0 = std::min<int32_t>(y0, rects[i].y);
+        y1 = std::max<int32_t>(y1, rects[i].y + rects[i].h);
+    }
+    bounds[0] = x0; bounds[1] = y0; bounds[2] = x1 - x0; bounds[3] = y1 - y0;
+}
+
+// Deterministic stand-in data for hashed payloads, seeded by the hash
+static uint32_t replay_next(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+static void replay_fill(std::vector<uint8_t>& buf, size_t len, uint32_t seed) {
+    buf.resize(len > 0 ? len : 1);
+    for (size_t i = 0; i < len; i++) buf[i] = (uint8_t)replay_next(seed);
+}
+
+static void replay_fill(std::vector<uint16_t>& buf, size_t count, uint32_t seed) {
+    buf.resize(count > 0 ? count : 1);
+    for (size_t i = 0; i < count; i++) buf[i] = (uint16_t)replay_next(seed);
+}
+
+static int16_t replay_coord(uint32_t& state, int32_t origin, int32_t extent) {
+    return (int16_t)(origin + (extent > 0 ? (int32_t)(replay_next(state) % (uint32_t)(extent + 1)) : 0));
+}
+
+// Arguments each op is recorded with (tft_trace.h); shorter records are skipped
+static const uint8_t replay_min_args[] = {
+    4, 5, 1, 3, 4, 4, 5, 5, 5, 4, 4,    // BEGIN .. FILL_CIRCLE
+    8, 6, 7, 8, 6, 6, 7, 7, 12, 7,      // BITMAP .. THICK_LINE
+    4, 3, 6, 5, 6, 4, 6,                // SHADER_RECT .. BLUR
+    7, 8, 4, 2, 2, 5,                   // CHAR .. RGB_ALPHA
+    7, 1, 0, 3, 2, 2, 3, 2, 2,          // SPRITE_ADD .. SPRITE_SHOW
+};
+static_assert(sizeof(replay_min_args) == TFT_TRACE_OP_COUNT, "one entry per trace op");
+
+// count points around the ellipse inscribed in the bounds
+static void replay_ellipse(std::vector<tft_point_t>& points, uint16_t count, const int32_t* b) {
+    points.resize(count > 0 ? count : 1);
+    for (uint16_t i = 0; i < count; i++) {
+        float a = 6.2831853f * i / count;
+        points[i].x = (int16_t)(b[0] + b[2] * 0.5f * (1.0f + cosf(a)));
+        points[i].y = (int16_t)(b[1] + b[3] * 0.5f * (1.0f + sinf(a)));
+    }
+}
+
+int16_t TFT7735V::replay_sprite(int32_t recorded_id) const {
+    if (recorded_id < 0 || recorded_id >= (int32_t)replay_sprite_ids.size()) return -1;
+    return replay_sprite_ids[recorded_id];
+}
+
+// Keeps stand-in pixels for sprite id, dropping the previous ones once the
+// frame in flight, which may still show them, is done
+const uint16_t* TFT7735V::keep_replay_sprite_pixels(int16_t id, std::vector<uint16_t>& pixels) {
+    waitForDisplayDone();
+    if (id >= (int16_t)replay_sprite_pixels.size()) replay_sprite_pixels.resize(id + 1);
+    replay_sprite_pixels[id].swap(pixels);
+    return &replay_sprite_pixels[id][0];
+}
+
+uint32_t TFT7735V::replayTrace(const uint8_t* data, size_t len, bool timed) {
+    size_t offset;
+    if (!tft_trace_read_header(data, len, &offset)) {
+        ESP_LOGE(TAG, "Not a trace stream");
+        return 0;
+    }
+    
+    std::vector<uint8_t> bytes;
+    std::vector<uint8_t> mask;
+    std::vector<tft_point_t> points;
+    std::vector<uint16_t> sprite_pixels;
+    tft_trace_record_t rec;
+    uint32_t replayed = 0;
+    int64_t target_us = esp_timer_get_time();
+    bool saved_has_bg = text_has_bg;
+    
+    while (tft_trace_next(data, len, &offset, &rec)) {
+        const int32_t* a = rec.args;
+        if (timed) {
+            target_us += rec.dt_us;
+            int64_t wait_us = target_us - esp_timer_get_time();
+            if (wait_us >= 1000) vTaskDelay(pdMS_TO_TICKS(wait_us / 1000));
+        }
+        if (rec.op < TFT_TRACE_OP_COUNT && rec.argc < replay_min_args[rec.op]) {
+            ESP_LOGW(TAG, "Trace op %d with %d arguments, skipped", rec.op, rec.argc);
+            continue;
+        }
+        uint32_t seed = rec.argc > 0 ? (uint32_t)a[rec.argc - 1] : 0;
+        bool has_list = rec.op == TFT_TRACE_OP_PIXELS || rec.op == TFT_TRACE_OP_LINES ||
+                        rec.op == TFT_TRACE_OP_RECTS || rec.op == TFT_TRACE_OP_POLYLINE;
+        if (has_list && a[0] <= 0) continue;
+        
+        switch (rec.op) {
+            case TFT_TRACE_OP_BEGIN:
+                if (a[0] != width || a[1] != height) {
+                    ESP_LOGW(TAG, "Trace recorded at %ldx%ld, replaying at %dx%d",
+                             (long)a[0], (long)a[1], width, height);
+                }
+                break;
+            case TFT_TRACE_OP_DISPLAY:
+                if (framebuffer_enabled) {
+                    waitForDisplayDone();
+                    display();
+                }
+                break;
+            case TFT_TRACE_OP_FILL_SCREEN: fill_screen(a[0]); break;
+            case TFT_TRACE_OP_PIXEL:       draw_pixel(a[0], a[1], a[2]); break;
+            case TFT_TRACE_OP_HLINE:       draw_fast_hline(a[0], a[1], a[2], a[3]); break;
+            case TFT_TRACE_OP_VLINE:       draw_fast_vline(a[0], a[1], a[2], a[3]); break;
+            case TFT_TRACE_OP_FILL_RECT:   fill_rect(a[0], a[1], a[2], a[3], a[4]); break;
+            case TFT_TRACE_OP_LINE:        drawLine(a[0], a[1], a[2], a[3], a[4]); break;
+            case TFT_TRACE_OP_RECT:        drawRect(a[0], a[1], a[2], a[3], a[4]); break;
+            case TFT_TRACE_OP_CIRCLE:      drawCircle(a[0], a[1], a[2], a[3]); break;
+            case TFT_TRACE_OP_FILL_CIRCLE: fillCircle(a[0], a[1], a[2], a[3]); break;
+            case TFT_TRACE_OP_BITMAP:
+                replay_fill(bytes, ((a[2] + 7) / 8) * a[3], seed);
+                if (a[6]) {
+                    drawBitmap(a[0], a[1], &bytes[0], a[2], a[3], a[4], a[5]);
+                } else {
+                    drawBitmap(a[0], a[1], &bytes[0], a[2], a[3], a[4]);
+                }
+                break;
+            case TFT_TRACE_OP_RGB_BITMAP:
+                replay_fill(bytes, a[2] * a[3] * sizeof(uint16_t), seed);
+                if (a[4]) {
+                    replay_fill(mask, ((a[2] + 7) / 8) * a[3], ~seed);
+                    drawRGBBitmap(a[0], a[1], (const uint16_t*)&bytes[0], &mask[0], a[2], a[3]);
+                } else {
+                    drawRGBBitmap(a[0], a[1], (const uint16_t*)&bytes[0], a[2], a[3]);
+                }
+                break;
+            case TFT_TRACE_OP_RGB_REGION:
+                replay_fill(bytes, a[2] * a[3] * sizeof(uint16_t), seed);
+                drawRGBBitmapRegion(a[0], a[1], (const uint16_t*)&bytes[0], a[2], 0, 0, a[2], a[3], a[4]);
+                break;
+            case TFT_TRACE_OP_PIXELS: {
+                points.resize(a[0]);
+                std::vector<uint16_t> colors(a[1] ? a[0] : 0);
+                for (int32_t i = 0; i < a[0]; i++) {
+                    points[i].x = replay_coord(seed, a[3], a[5]);
+                    points[i].y = replay_coord(seed, a[4], a[6]);
+                    if (a[1]) colors[i] = (uint16_t)replay_next(seed);
+                }
+                if (a[1]) {
+                    drawPixels(&points[0], &colors[0], a[0]);
+                } else {
+                    drawPixels(&points[0], a[0], a[2]);
+                }
+                break;
+            }
+            case TFT_TRACE_OP_LINES: {
+                std::vector<tft_line_t> lines(a[0]);
+                for (int32_t i = 0; i < a[0]; i++) {
+                    lines[i].x0 = replay_coord(seed, a[1], a[3]);
+                    lines[i].y0 = replay_coord(seed, a[2], a[4]);
+                    lines[i].x1 = replay_coord(seed, a[1], a[3]);
+                    lines[i].y1 = replay_coord(seed, a[2], a[4]);
+                    lines[i].color = (uint16_t)replay_next(seed);
+                }
+                drawLines(&lines[0], a[0]);
+                break;
+            }
+            case TFT_TRACE_OP_RECTS: {
+                std::vector<tft_rect_t> rects(a[0]);
+                for (int32_t i = 0; i < a[0]; i++) {
+                    rects[i].x = replay_coord(seed, a[1], a[3]);
+                    rects[i].y = replay_coord(seed, a[2], a[4]);
+                    rects[i].w = replay_coord(seed, 1, a[1] + a[3] - rects[i].x);
+                    rects[i].h = replay_coord(seed, 1, a[2] + a[4] - rects[i].y);
+                    rects[i].color = (uint16_t)replay_next(seed);
+                }
+                fillRects(&rects[0], a[0]);
+                break;
+            }
+            case TFT_TRACE_OP_POLYGON:
+                replay_ellipse(points, a[0], a + 2);
+                fillPolygon(&points[0], a[0], a[1]);
+                break;
+            case TFT_TRACE_OP_PATH: {
+                replay_ellipse(points, 32, a + 2);
+                TFTPath path;
+                path.moveTo(points[0].x, points[0].y);
+                for (uint16_t i = 1; i < 32; i++) path.lineTo(points[i].x, points[i].y);
+                path.close();
+                fillPath(path, a[0], (tft_fill_rule_t)a[1]);
+                break;
+            }
+            case TFT_TRACE_OP_POLYLINE: {
+                static const float dash[2] = { 6.0f, 4.0f };
+                points.resize(a[0]);
+                for (int32_t i = 0; i < a[0]; i++) {
+                    points[i].x = replay_coord(seed, a[7], a[9]);
+                    points[i].y = replay_coord(seed, a[8], a[10]);
+                }
+                tft_stroke_style_t style = tftStrokeStyle(a[2] / 16.0f, (tft_line_join_t)a[3], (tft_line_cap_t)a[4]);
+                if (a[6]) {
+                    style.dash = dash;
+                    style.dash_count = 2;
+                }
+                drawPolyline(&points[0], a[0], a[1], style, a[5] != 0);
+                break;
+            }
+            case TFT_TRACE_OP_THICK_LINE:
+                drawThickLine(a[0], a[1], a[2], a[3], a[4] / 16.0f, a[5], (tft_line_cap_t)a[6]);
+                break;
+            case TFT_TRACE_OP_SHADER_RECT:
+                fillRectShader(a[0], a[1], a[2], a[3],
+                               TFTLinearGradient(a[0], a[1], ST7735_BLACK, a[0] + a[2], a[1] + a[3], ST7735_WHITE));
+                break;
+            case TFT_TRACE_OP_SHADER_CIRCLE:
+                fillCircleShader(a[0], a[1], a[2], TFTRadialGradient(a[0], a[1], a[2], ST7735_WHITE, ST7735_BLACK));
+                break;
+            case TFT_TRACE_OP_SHADER_POLYGON:
+                replay_ellipse(points, a[0], a + 1);
+                fillPolygonShader(&points[0], a[0],
+                                  TFTLinearGradient(a[1], a[2], ST7735_BLACK, a[1] + a[3], a[2] + a[4], ST7735_WHITE));
+                break;
+            case TFT_TRACE_OP_DIM:    dimRegion(a[0], a[1], a[2], a[3], a[4]); break;
+            case TFT_TRACE_OP_TINT:   tintRegion(a[0], a[1], a[2], a[3], a[4], a[5]); break;
+            case TFT_TRACE_OP_INVERT: invertRegion(a[0], a[1], a[2], a[3]); break;
+            case TFT_TRACE_OP_BLUR:   blurRegion(a[0], a[1], a[2], a[3], a[4], a[5]); break;
+            case TFT_TRACE_OP_CHAR:
+                text_has_bg = a[6] != 0;
+                drawChar(a[0], a[1], a[2], a[3], a[4], a[5]);
+                break;
+            case TFT_TRACE_OP_TEXT: {
+                std::vector<char> text(a[2] + 1, '\0');
+                for (int32_t i = 0; i < a[2]; i++) text[i] = 'A' + (i % 26);
+                text_has_bg = a[6] != 0;
+                drawText(a[0], a[1], &text[0], a[3], a[4], a[5]);
+                break;
+            }
+            case TFT_TRACE_OP_ADDR_WINDOW: set_addr_window(a[0], a[1], a[2], a[3]); break;
+            case TFT_TRACE_OP_PUSH_COLORS:
+                replay_fill(bytes, a[0] * sizeof(uint16_t), seed);
+                push_colors((const uint16_t*)&bytes[0], a[0]);
+                break;
+            case TFT_TRACE_OP_PUSH_COLOR: push_color(a[0], a[1]); break;
+            case TFT_TRACE_OP_RGB_ALPHA:
+                replay_fill(bytes, a[2] * a[3] * sizeof(uint16_t), seed);
+                replay_fill(mask, a[2] * a[3], ~seed);
+                drawRGBBitmapAlpha(a[0], a[1], (const uint16_t*)&bytes[0], &mask[0], a[2], a[3]);
+                break;
+            case TFT_TRACE_OP_SPRITE_ADD: {
+                if (a[0] < 0 || a[0] >= TFT_MAX_SPRITES || a[1] <= 0 || a[2] <= 0) continue;
+                replay_fill(sprite_pixels, a[1] * a[2], seed);
+                int16_t id = addSprite(&sprite_pixels[0], a[1], a[2], a[3], a[4], a[5]);
+                if (id < 0) continue;
+                keep_replay_sprite_pixels(id, sprite_pixels);   // Same storage, now owned by the slot
+                if (a[0] >= (int32_t)replay_sprite_ids.size()) replay_sprite_ids.resize(a[0] + 1, -1);
+                replay_sprite_ids[a[0]] = id;
+                break;
+            }
+            case TFT_TRACE_OP_SPRITE_REMOVE: {
+                int16_t id = replay_sprite(a[0]);
+                if (id < 0) continue;
+                removeSprite(id);
+                replay_sprite_ids[a[0]] = -1;
+                break;
+            }
+            case TFT_TRACE_OP_SPRITE_CLEAR:
+                clearSprites();
+                replay_sprite_ids.clear();
+                break;
+            case TFT_TRACE_OP_SPRITE_MOVE:
+                if (!moveSprite(replay_sprite(a[0]), a[1], a[2])) continue;
+                break;
+            case TFT_TRACE_OP_SPRITE_IMAGE: {
+                int16_t id = replay_sprite(a[0]);
+                const tft_sprite_t* s = sprite_slot(id);
+                if (s == nullptr) continue;
+                replay_fill(sprite_pixels, s->w * s->h, seed);
+                setSpriteImage(id, keep_replay_sprite_pixels(id, sprite_pixels));
+                break;
+            }
+            case TFT_TRACE_OP_SPRITE_Z:
+                if (!setSpriteZ(replay_sprite(a[0]), a[1])) continue;
+                break;
+            case TFT_TRACE_OP_SPRITE_KEY:
+                if (!setSpriteColorKey(replay_sprite(a[0]), a[1], a[2] != 0)) continue;
+                break;
+            case TFT_TRACE_OP_SPRITE_ALPHA:
+                if (!setSpriteAlpha(replay_sprite(a[0]), a[1])) continue;
+                break;
+            case TFT_TRACE_OP_SPRITE_SHOW:
+                if (!showSprite(replay_sprite(a[0]), a[1] != 0)) continue;
+                break;
+            default:
+                ESP_LOGW(TAG, "Unknown trace op %d", rec.op);
+                continue;
+        }
+        replayed++;
+    }
+    
+    text_has_bg = saved_has_bg;
+    ESP_LOGI(TAG, "Replayed %lu trace records", (unsigned long)replayed);
+    return replayed;
+}
+
+void TFT7735V::setOffsets(int16_t x, int16_t y) {
+    x_offset = x;
+    y_offset = y;
+}
+
+void TFT7735V::getOffsets(int16_t &x, int16_t &y) const {
+    x = x_offset;
+    y = y_offset;
+}
+
+void TFT7735V::draw_pixel(uint16_t x, uint16_t y, uint16_t color) {
+    trace_scope trace(this, TFT_TRACE_OP_PIXEL, { x, y, color });
+    bool outside = fb_window && (x < fb_x || y < fb_y || x >= fb_x + fb_w || y >= fb_y + fb_h);
+    if (framebuffer_enabled && !outside) {
+        fb_draw_pixel(x, y, color);
     } else {
-        // Direct mode - original implementation
+        // Direct mode (or outside the framebuffer window)
         if (x >= width || y >= height) return;
-        if (x + w > width) w = width - x;
-        if (y + h > height) h = height - y;
         
-        set_addr_window(x, y, x + w - 1, y + h - 1);
-        
-        uint32_t total_pixels = w * h;
-        push_color(color, total_pixels);
+        gram_scope gram(this);
+        set_addr_window(x, y, x, y);
+        write_data16(color);
     }
 }
 
-void TFT7735V::push_color(uint16_t color, uint32_t len) {
-    gpio_set_level(dc_pin, 1); // Data mode
+void TFT7735V::fill_screen(uint16_t color) {
+    trace_scope trace(this, TFT_TRACE_OP_FILL_SCREEN, { color });
+    if (fb_full()) {
+        fb_fill_screen(color);
+    } else {
+        // Direct mode - original implementation
+        fill_rect(0, 0, width, height, color);
+    }
+}
+
+void TFT7735V::fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
+    trace_scope trace(this, TFT_TRACE_OP_FILL_RECT, { x, y, w, h, color });
+    if (framebuffer_enabled) {
+        fb_fill_rect(x, y, w, h, color);
+        if (!fb_window) return;
+    }
+    fill_rect_direct(x, y, w, h, color);
+}
+
+// Direct mode fill; with a framebuffer window only the parts around it
+// (bands above and below, then left and right of it)
+void TFT7735V::fill_rect_direct(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+    int32_t x0 = std::max<int32_t>(0, x), y0 = std::max<int32_t>(0, y);
+    int32_t x1 = std::min<int32_t>(width, x + w), y1 = std::min<int32_t>(height, y + h);
+    if (x0 >= x1 || y0 >= y1) return;
+    
+    if (fb_window && framebuffer_enabled) {
+        int32_t wx0 = fb_x, wy0 = fb_y, wx1 = fb_x + fb_w, wy1 = fb_y + fb_h;
+        if (x0 < wx1 && x1 > wx0 && y0 < wy1 && y1 > wy0) {
+            fill_rect_direct(x0, y0, x1 - x0, wy0 - y0, color);
+            fill_rect_direct(x0, wy1, x1 - x0, y1 - wy1, color);
+            int32_t my0 = std::max(y0, wy0), my1 = std::min(y1, wy1);
+            fill_rect_direct(x0, my0, wx0 - x0, my1 - my0, color);
+            fill_rect_direct(wx1, my0, x1 - wx1, my1 - my0, color);
+            return;
+        }
+    }
     
+    gram_scope gram(this);
+    set_addr_window(x0, y0, x1 - 1, y1 - 1);
+    push_color(color, (uint32_t)(x1 - x0) * (y1 - y0));
+}
+
+// Parts of row y between x0 and x1 (exclusive) that are not buffered, as
+// start / end pairs; all of it unless a framebuffer window crosses the row
+uint8_t TFT7735V::direct_spans(int32_t y, int32_t x0, int32_t x1, int32_t* spans) const {
+    x0 = std::max<int32_t>(0, x0);
+    x1 = std::min<int32_t>(width, x1);
+    if (y < 0 || y >= height || x0 >= x1) return 0;
+    
+    uint8_t n = 0;
+    if (!fb_window || !framebuffer_enabled || y < fb_y || y >= fb_y + fb_h ||
+        x1 <= fb_x || x0 >= fb_x + fb_w) {
+        spans[0] = x0;
+        spans[1] = x1;
+        return 1;
+    }
+    if (x0 < fb_x) {
+        spans[n++] = x0;
+        spans[n++] = fb_x;
+    }
+    if (x1 > fb_x + fb_w) {
+        spans[n++] = fb_x + fb_w;
+        spans[n++] = x1;
+    }
+    return n / 2;
+}
+
+// One row of native pixels starting at (x, y), minus the buffered part
+void TFT7735V::write_row_direct(int32_t x, int32_t y, const uint16_t* pixels, int32_t n) {
+    int32_t spans[4];
+    uint8_t count = direct_spans(y, x, x + n, spans);
+    gram_scope gram(this);
+    for (uint8_t s = 0; s < count; s++) {
+        set_addr_window(spans[2 * s], y, spans[2 * s + 1] - 1, y);
+        push_colors(pixels + (spans[2 * s] - x), spans[2 * s + 1] - spans[2 * s]);
+    }
+}
+
+void TFT7735V::push_color(uint16_t color, uint32_t len) {
+    trace_scope trace(this, TFT_TRACE_OP_PUSH_COLOR, { color, (int32_t)len });
     // Create buffer for efficient transfer
     const size_t chunk_size = 1024;
     uint16_t buffer[chunk_size];
@@ -459,66 +1707,963 @@ void TFT7735V::push_color(uint16_t color, uint32_t len) {
     while (len > 0) {
         size_t current_chunk = (len > chunk_size) ? chunk_size : len;
         
-        spi_transaction_t t = {};
-        t.length = current_chunk * 16; // Length in bits
-        t.tx_buffer = buffer;
-        
-        esp_err_t ret = spi_device_polling_transmit(spi_device, &t);
-        if (ret != ESP_OK) {
-            ESP_LOGE(TAG, "Failed to push color: %s", esp_err_to_name(ret));
-            break;
-        }
+        write_pixels(buffer, current_chunk * sizeof(uint16_t), true);
         
         len -= current_chunk;
     }
 }
 
-void TFT7735V::push_colors(const uint16_t* colors, uint32_t len) {
-    gpio_set_level(dc_pin, 1); // Data mode
-    
-    // Convert to big-endian and send
-    const size_t chunk_size = 512;
-    uint16_t buffer[chunk_size];
-    
-    uint32_t remaining = len;
-    const uint16_t* src = colors;
-    
-    while (remaining > 0) {
-        size_t current_chunk = (remaining > chunk_size) ? chunk_size : remaining;
-        
-        // Convert endianness
-        for (size_t i = 0; i < current_chunk; i++) {
-            buffer[i] = __builtin_bswap16(src[i]);
-        }
-        
-        spi_transaction_t t = {};
-        t.length = current_chunk * 16; // Length in bits
-        t.tx_buffer = buffer;
-        
-        esp_err_t ret = spi_device_polling_transmit(spi_device, &t);
-        if (ret != ESP_OK) {
-            ESP_LOGE(TAG, "Failed to push colors: %s", esp_err_to_name(ret));
-            break;
+void TFT7735V::push_colors(const uint16_t* colors, uint32_t len) {
+    trace_scope trace(this, TFT_TRACE_OP_PUSH_COLORS, { (int32_t)len, (int32_t)trace_hash(colors, len * sizeof(uint16_t)) });
+    // Convert to big-endian and send
+    const size_t chunk_size = 512;
+    uint16_t buffer[chunk_size];
+    
+    uint32_t remaining = len;
+    const uint16_t* src = colors;
+    
+    while (remaining > 0) {
+        size_t current_chunk = (remaining > chunk_size) ? chunk_size : remaining;
+        
+        // Convert endianness
+        for (size_t i = 0; i < current_chunk; i++) {
+            buffer[i] = __builtin_bswap16(src[i]);
+        }
+        
+        write_pixels(buffer, current_chunk * sizeof(uint16_t), true);
+        
+        src += current_chunk;
+        remaining -= current_chunk;
+    }
+}
+
+void TFT7735V::draw_fast_vline(uint16_t x, uint16_t y, uint16_t h, uint16_t color) {
+    trace_scope trace(this, TFT_TRACE_OP_VLINE, { x, y, h, color });
+    if (fb_full()) {
+        fb_draw_fast_vline(x, y, h, color);
+    } else {
+        fill_rect(x, y, 1, h, color);
+    }
+}
+
+void TFT7735V::draw_fast_hline(uint16_t x, uint16_t y, uint16_t w, uint16_t color) {
+    trace_scope trace(this, TFT_TRACE_OP_HLINE, { x, y, w, color });
+    if (fb_full()) {
+        fb_draw_fast_hline(x, y, w, color);
+    } else {
+        fill_rect(x, y, w, 1, color);
+    }
+}
+
+// Sorted pixel boundaries where the polygon outline crosses the center of
+// row y. Pixel columns [xs[2i], xs[2i+1]) are inside (even-odd rule).
+uint8_t TFT7735V::polygon_row_crossings(const tft_point_t* points, uint16_t count, int16_t y,
+                                        int16_t* xs, uint8_t max_crossings) {
+    uint8_t n = 0;
+    int32_t yc2 = 2 * y + 1;   // Row center in half pixels
+    
+    for (uint16_t i = 0; i < count && n < max_crossings; i++) {
+        const tft_point_t& a = points[i];
+        const tft_point_t& b = points[(i + 1 == count) ? 0 : i + 1];
+        if (a.y == b.y) continue;
+        
+        int32_t ya2 = 2 * a.y, yb2 = 2 * b.y;
+        // Half-open so shared vertices are counted once
+        if ((yc2 < ya2 || yc2 >= yb2) && (yc2 < yb2 || yc2 >= ya2)) continue;
+        
+        // Crossing x in 16.16, then the first pixel whose center is right of it
+        int64_t xf = ((int64_t)a.x << 16) +
+                     ((int64_t)(yc2 - ya2) * (b.x - a.x) << 16) / (yb2 - ya2);
+        int16_t xb = (int16_t)((xf + 32767) >> 16);
+        
+        // Insertion sort, counts are small
+        uint8_t j = n++;
+        while (j > 0 && xs[j - 1] > xb) {
+            xs[j] = xs[j - 1];
+            j--;
+        }
+        xs[j] = xb;
+    }
+    return n;
+}
+
+void TFT7735V::fillPolygon(const tft_point_t* points, uint16_t count, uint16_t color) {
+    int32_t b[4] = { 0, 0, 0, 0 };
+    if (tracing()) trace_bounds(points, count, b);
+    trace_scope trace(this, TFT_TRACE_OP_POLYGON, { count, color, b[0], b[1], b[2], b[3],
+                                                    (int32_t)trace_hash(points, count * sizeof(tft_point_t)) });
+    fillPolygonShader(points, count, TFTSolidShader(color));
+}
+
+dirty_rect_t TFT7735V::fillPath(const TFTPath& path, uint16_t color, tft_fill_rule_t rule,
+                                const tft_affine_t* transform) {
+    std::vector<tft_path_segment_t> segments;
+    path.flatten(segments, transform);
+    
+    int32_t b[4] = { 0, 0, 0, 0 };
+    uint32_t hash = 0;
+    if (tracing() && !segments.empty()) {
+        float x0 = segments[0].x0, y0 = segments[0].y0, x1 = x0, y1 = y0;
+        for (size_t i = 0; i < segments.size(); i++) {
+            x0 = std::min(x0, std::min(segments[i].x0, segments[i].x1));
+            x1 = std::max(x1, std::max(segments[i].x0, segments[i].x1));
+            y0 = std::min(y0, std::min(segments[i].y0, segments[i].y1));
+            y1 = std::max(y1, std::max(segments[i].y0, segments[i].y1));
+        }
+        b[0] = (int32_t)floorf(x0);
+        b[1] = (int32_t)floorf(y0);
+        b[2] = (int32_t)ceilf(x1) - b[0];
+        b[3] = (int32_t)ceilf(y1) - b[1];
+        std::vector<uint8_t> bytes(path.serialize(nullptr, 0));
+        if (!bytes.empty()) {
+            path.serialize(&bytes[0], bytes.size());
+            hash = tft_trace_hash(&bytes[0], bytes.size());
+        }
+    }
+    trace_scope trace(this, TFT_TRACE_OP_PATH, { color, rule, b[0], b[1], b[2], b[3], (int32_t)hash });
+    return fill_segments(segments, color, rule);
+}
+
+dirty_rect_t TFT7735V::drawPolyline(const tft_point_t* points, uint16_t count, uint16_t color,
+                                    const tft_stroke_style_t& style, bool closed) {
+    dirty_rect_t damage = { 0, 0, 0, 0, false };
+    if (points == nullptr || count == 0) return damage;
+    
+    int32_t b[4] = { 0, 0, 0, 0 };
+    if (tracing()) trace_bounds(points, count, b);
+    trace_scope trace(this, TFT_TRACE_OP_POLYLINE,
+                      { count, color, (int32_t)(style.width * 16.0f), style.join, style.cap, closed,
+                        style.dash != nullptr && style.dash_count > 0, b[0], b[1], b[2], b[3],
+                        (int32_t)trace_hash(points, count * sizeof(tft_point_t)) });
+    
+    std::vector<float> xy(count * 2);
+    for (uint16_t i = 0; i < count; i++) {
+        xy[i * 2] = points[i].x + 0.5f;
+        xy[i * 2 + 1] = points[i].y + 0.5f;
+    }
+    
+    std::vector<tft_path_segment_t> segments;
+    tft_stroke_polyline(&xy[0], count, closed, style, segments);
+    return fill_segments(segments, color, TFT_FILL_NONZERO, true);
+}
+
+dirty_rect_t TFT7735V::drawThickLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, float line_width,
+                                     uint16_t color, tft_line_cap_t cap) {
+    trace_scope trace(this, TFT_TRACE_OP_THICK_LINE, { x0, y0, x1, y1, (int32_t)(line_width * 16.0f), color, cap });
+    tft_point_t points[2] = { { x0, y0 }, { x1, y1 } };
+    return drawPolyline(points, 2, color, tftStrokeStyle(line_width, TFT_JOIN_MITER, cap));
+}
+
+static bool segment_top_less(const tft_path_segment_t& a, const tft_path_segment_t& b) {
+    return std::min(a.y0, a.y1) < std::min(b.y0, b.y1);
+}
+
+// Scanline fill of flattened segments: per row, accumulate signed coverage,
+// prefix-sum it and write each covered pixel once. overlapping pieces
+// (strokes) take the union rasterizer instead, which counts overlaps once.
+dirty_rect_t TFT7735V::fill_segments(std::vector<tft_path_segment_t>& segments, uint16_t color,
+                                     tft_fill_rule_t rule, bool overlapping) {
+    dirty_rect_t damage = { 0, 0, 0, 0, false };
+    if (segments.empty()) return damage;
+    if (framebuffer_enabled && current_framebuffer == nullptr) return damage;
+    
+    float min_x = segments[0].x0, max_x = min_x;
+    float min_y = segments[0].y0, max_y = min_y;
+    for (size_t i = 0; i < segments.size(); i++) {
+        const tft_path_segment_t& sg = segments[i];
+        min_x = std::min(min_x, std::min(sg.x0, sg.x1));
+        max_x = std::max(max_x, std::max(sg.x0, sg.x1));
+        min_y = std::min(min_y, std::min(sg.y0, sg.y1));
+        max_y = std::max(max_y, std::max(sg.y0, sg.y1));
+    }
+    
+    int32_t x0 = std::max<int32_t>(0, (int32_t)floorf(min_x));
+    int32_t x1 = std::min<int32_t>(width, (int32_t)ceilf(max_x));
+    int32_t y0 = std::max<int32_t>(0, (int32_t)floorf(min_y));
+    int32_t y1 = std::min<int32_t>(height, (int32_t)ceilf(max_y));
+    if (x0 >= x1 || y0 >= y1) return damage;
+    int32_t w = x1 - x0;
+    
+    // Active edge list: sorted by top, a segment joins when the row reaches
+    // its top and leaves once the row is below its bottom
+    std::sort(segments.begin(), segments.end(), segment_top_less);
+    std::vector<tft_path_segment_t> active;
+    size_t next = 0;
+    
+    if (framebuffer_enabled) {
+        materialize_render(x0, y0, w, y1 - y0);
+    }
+    
+    std::vector<float> acc(w + 2);
+    std::vector<tft_path_crossing_t> crossings;
+    int32_t dmg_x0 = x1, dmg_x1 = x0 - 1, dmg_y0 = y1, dmg_y1 = y0 - 1;
+    
+    for (int32_t y = y0; y < y1; y++) {
+        size_t kept = 0;
+        for (size_t i = 0; i < active.size(); i++) {
+            if (std::max(active[i].y0, active[i].y1) > (float)y) active[kept++] = active[i];
+        }
+        active.resize(kept);
+        while (next < segments.size() &&
+               std::min(segments[next].y0, segments[next].y1) < (float)(y + 1)) {
+            if (std::max(segments[next].y0, segments[next].y1) > (float)y) active.push_back(segments[next]);
+            next++;
+        }
+        std::fill(acc.begin(), acc.end(), 0.0f);
+        if (!active.empty()) {
+            if (overlapping) {
+                tft_path_coverage_row(&active[0], active.size(), y, x0, w, rule, &acc[0], crossings);
+            } else {
+                tft_path_accumulate_row(&active[0], active.size(), y, x0, w, &acc[0]);
+            }
+        }
+        
+        float winding = 0.0f;
+        int32_t run_start = -1;
+        uint16_t* row = fb_full() ? current_framebuffer + y * width : nullptr;
+        
+        for (int32_t i = 0; i <= w; i++) {
+            uint8_t alpha = 0;
+            if (i < w) {
+                winding += acc[i];
+                float coverage = overlapping ? std::min(acc[i], 1.0f) : tft_path_coverage(winding, rule);
+                alpha = (uint8_t)(coverage * 32.0f + 0.5f);
+            }
+            
+            if (row != nullptr) {
+                if (alpha == 0) continue;
+                uint16_t* p = row + x0 + i;
+                *p = (alpha >= 32) ? color : blend565(color, *p, alpha);
+                dmg_x0 = std::min(dmg_x0, x0 + i);
+                dmg_x1 = std::max(dmg_x1, x0 + i);
+                dmg_y0 = std::min(dmg_y0, y);
+                dmg_y1 = std::max(dmg_y1, y);
+            } else if (alpha >= 16) {
+                // Direct mode - no readback, so threshold and emit runs
+                if (run_start < 0) run_start = i;
+            } else if (run_start >= 0) {
+                fill_rect(x0 + run_start, y, i - run_start, 1, color);
+                dmg_x0 = std::min(dmg_x0, x0 + run_start);
+                dmg_x1 = std::max(dmg_x1, x0 + i - 1);
+                dmg_y0 = std::min(dmg_y0, y);
+                dmg_y1 = std::max(dmg_y1, y);
+                run_start = -1;
+            }
+        }
+    }
+    
+    if (dmg_x0 <= dmg_x1 && dmg_y0 <= dmg_y1) {
+        damage.x = dmg_x0;
+        damage.y = dmg_y0;
+        damage.w = dmg_x1 - dmg_x0 + 1;
+        damage.h = dmg_y1 - dmg_y0 + 1;
+        damage.valid = true;
+        if (framebuffer_enabled) {
+            expand_dirty_rect(damage.x, damage.y, damage.w, damage.h);
+        }
+    }
+    return damage;
+}
+
+// Blit a w x h region at (src_x, src_y) of an RGB565 image with src_stride
+// pixels per row. Clipping moves the source window instead of testing pixels;
+// opaque rows without a horizontal flip are one memcpy each.
+void TFT7735V::drawRGBBitmapRegion(int16_t x, int16_t y, const uint16_t* src, uint16_t src_stride,
+                                   uint16_t src_x, uint16_t src_y, uint16_t w, uint16_t h, uint8_t flip) {
+    uint32_t hash = 0;
+    if (tracing() && src != nullptr) {
+        hash = TFT_TRACE_HASH_SEED;
+        for (uint16_t row = 0; row < h; row++) {
+            hash = tft_trace_hash(src + (src_y + row) * src_stride + src_x, w * sizeof(uint16_t), hash);
+        }
+    }
+    trace_scope trace(this, TFT_TRACE_OP_RGB_REGION, { x, y, w, h, flip, src_stride, (int32_t)hash });
+    if (src == nullptr || w == 0 || h == 0) return;
+    if (framebuffer_enabled && current_framebuffer == nullptr) return;
+    
+    int32_t dx0 = std::max<int32_t>(0, x), dy0 = std::max<int32_t>(0, y);
+    int32_t dx1 = std::min<int32_t>(width, (int32_t)x + w), dy1 = std::min<int32_t>(height, (int32_t)y + h);
+    if (dx0 >= dx1 || dy0 >= dy1) return;
+    int32_t cw = dx1 - dx0, ch = dy1 - dy0;
+    
+    // Source position of the first visible pixel and the per-step direction
+    bool flip_h = (flip & TFT_FLIP_H) != 0;
+    bool flip_v = (flip & TFT_FLIP_V) != 0;
+    int32_t first_col = flip_h ? src_x + (w - 1) - (dx0 - x) : src_x + (dx0 - x);
+    int32_t first_row = flip_v ? src_y + (h - 1) - (dy0 - y) : src_y + (dy0 - y);
+    int32_t row_step = flip_v ? -(int32_t)src_stride : (int32_t)src_stride;
+    const uint16_t* src_row = src + first_row * src_stride + first_col;
+    
+    if (framebuffer_enabled) {
+        // The part inside the framebuffer (all of it without a window)
+        int32_t fx0 = std::max<int32_t>(dx0, fb_x), fy0 = std::max<int32_t>(dy0, fb_y);
+        int32_t fx1 = std::min<int32_t>(dx1, fb_x + fb_w), fy1 = std::min<int32_t>(dy1, fb_y + fb_h);
+        if (fx0 < fx1 && fy0 < fy1) {
+            int32_t fw = fx1 - fx0;
+            const uint16_t* src_fb = src_row + (fy0 - dy0) * row_step + (flip_h ? -(fx0 - dx0) : fx0 - dx0);
+            materialize_render(fx0, fy0, fw, fy1 - fy0);
+            for (int32_t py = fy0; py < fy1; py++, src_fb += row_step) {
+                uint16_t* dst = current_framebuffer + fb_offset(fx0, py);
+                if (flip_h) {
+                    for (int32_t i = 0; i < fw; i++) dst[i] = src_fb[-i];
+                } else {
+                    memcpy(dst, src_fb, fw * sizeof(uint16_t));
+                }
+            }
+            expand_dirty_rect(fx0, fy0, fw, fy1 - fy0);
+        }
+        if (!fb_window) return;
+    }
+    
+    // Direct mode - one address window, rows streamed in order; around a
+    // framebuffer window row by row
+    std::vector<uint16_t> line(cw);
+    gram_scope gram(this);
+    if (!framebuffer_enabled) set_addr_window(dx0, dy0, dx1 - 1, dy1 - 1);
+    for (int32_t row = 0; row < ch; row++, src_row += row_step) {
+        for (int32_t i = 0; i < cw; i++) {
+            line[i] = flip_h ? src_row[-i] : src_row[i];
+        }
+        if (framebuffer_enabled) {
+            write_row_direct(dx0, dy0 + row, &line[0], cw);
+        } else {
+            push_colors(&line[0], cw);
+        }
+    }
+}
+
+void TFT7735V::drawRGBBitmapAlpha(int16_t x, int16_t y, const uint16_t* bitmap, const uint8_t* alpha,
+                                  uint16_t w, uint16_t h) {
+    uint32_t hash = 0;
+    if (tracing() && bitmap != nullptr && alpha != nullptr) {
+        hash = tft_trace_hash(bitmap, w * h * sizeof(uint16_t));
+        hash = tft_trace_hash(alpha, w * h, hash);
+    }
+    trace_scope trace(this, TFT_TRACE_OP_RGB_ALPHA, { x, y, w, h, (int32_t)hash });
+    if (bitmap == nullptr || alpha == nullptr || w == 0 || h == 0) return;
+    if (framebuffer_enabled && current_framebuffer == nullptr) return;
+    
+    int32_t dx0 = std::max<int32_t>(0, x), dy0 = std::max<int32_t>(0, y);
+    int32_t dx1 = std::min<int32_t>(width, (int32_t)x + w), dy1 = std::min<int32_t>(height, (int32_t)y + h);
+    if (dx0 >= dx1 || dy0 >= dy1) return;
+    int32_t cw = dx1 - dx0, ch = dy1 - dy0;
+    size_t first = (size_t)(dy0 - y) * w + (dx0 - x);
+    
+    if (framebuffer_enabled) {
+        // The part inside the framebuffer (all of it without a window)
+        int32_t fx0 = std::max<int32_t>(dx0, fb_x), fy0 = std::max<int32_t>(dy0, fb_y);
+        int32_t fx1 = std::min<int32_t>(dx1, fb_x + fb_w), fy1 = std::min<int32_t>(dy1, fb_y + fb_h);
+        int32_t fw = fx1 - fx0;
+        if (fw > 0 && fy0 < fy1) {
+            size_t fb_first = (size_t)(fy0 - y) * w + (fx0 - x);
+            materialize_render(fx0, fy0, fw, fy1 - fy0);
+            for (int32_t py = fy0; py < fy1; py++) {
+                const uint16_t* src = bitmap + fb_first + (size_t)(py - fy0) * w;
+                const uint8_t* a = alpha + fb_first + (size_t)(py - fy0) * w;
+                uint16_t* dst = current_framebuffer + fb_offset(fx0, py);
+                int32_t i = 0;
+                while (i < fw) {
+                    // Opaque runs are copied, transparent runs skipped
+                    int32_t run = i;
+                    if (a[i] == 255) {
+                        while (run < fw && a[run] == 255) run++;
+                        memcpy(dst + i, src + i, (run - i) * sizeof(uint16_t));
+                    } else if (a[i] == 0) {
+                        while (run < fw && a[run] == 0) run++;
+                    } else {
+                        dst[i] = blend565(src[i], dst[i], (a[i] + 4) >> 3);
+                        run++;
+                    }
+                    i = run;
+                }
+            }
+            expand_dirty_rect(fx0, fy0, fw, fy1 - fy0);
+        }
+        if (!fb_window) return;
+    }
+    
+    // Direct mode (or outside the framebuffer window) - no background to
+    // blend with, send the covered runs
+    gram_scope gram(this);
+    for (int32_t row = 0; row < ch; row++) {
+        const uint16_t* src = bitmap + first + (size_t)row * w;
+        const uint8_t* a = alpha + first + (size_t)row * w;
+        int32_t i = 0;
+        while (i < cw) {
+            if (a[i] < 128) { i++; continue; }
+            int32_t run = i;
+            while (run < cw && a[run] >= 128) run++;
+            write_row_direct(dx0 + i, dy0 + row, src + i, run - i);
+            i = run;
+        }
+    }
+}
+
+bool TFT7735V::drawCachedImage(TFTImageCache& cache, uint32_t asset_id, int16_t x, int16_t y, uint32_t params) {
+    const tft_cached_image_t* img = cache.get(asset_id, params);
+    if (img == nullptr) {
+        ESP_LOGW(TAG, "Image %lu (params %lu) not available", (unsigned long)asset_id, (unsigned long)params);
+        return false;
+    }
+    if (img->alpha != nullptr) {
+        drawRGBBitmapAlpha(x, y, img->pixels, img->alpha, img->w, img->h);
+    } else {
+        drawRGBBitmapRegion(x, y, img->pixels, img->w, 0, 0, img->w, img->h);
+    }
+    return true;
+}
+
+// Batched primitives: clip in bulk, update damage once per call
+
+void TFT7735V::drawPixels(const tft_point_t* points, size_t count, uint16_t color) {
+    plot_pixels(points, nullptr, color, count);
+}
+
+void TFT7735V::drawPixels(const tft_point_t* points, const uint16_t* colors, size_t count) {
+    if (colors == nullptr) return;
+    plot_pixels(points, colors, 0, count);
+}
+
+void TFT7735V::plot_pixels(const tft_point_t* points, const uint16_t* colors, uint16_t color, size_t count) {
+    if (points == nullptr || count == 0) return;
+    int32_t b[4] = { 0, 0, 0, 0 };
+    uint32_t hash = 0;
+    if (tracing()) {
+        trace_bounds(points, count, b);
+        hash = tft_trace_hash(points, count * sizeof(tft_point_t));
+        if (colors != nullptr) hash = tft_trace_hash(colors, count * sizeof(uint16_t), hash);
+    }
+    trace_scope trace(this, TFT_TRACE_OP_PIXELS,
+                      { (int32_t)count, colors != nullptr, color, b[0], b[1], b[2], b[3], (int32_t)hash });
+    
+    if (!fb_full()) {
+        for (size_t i = 0; i < count; i++) {
+            if (points[i].x < 0 || points[i].y < 0) continue;
+            draw_pixel(points[i].x, points[i].y, colors ? colors[i] : color);
+        }
+        return;
+    }
+    if (current_framebuffer == nullptr) return;
+    
+    // Count visible points per row and find the bounds
+    std::vector<uint32_t> row_start(height + 1, 0);
+    int32_t min_x = width, max_x = -1, min_y = height, max_y = -1;
+    size_t visible = 0;
+    for (size_t i = 0; i < count; i++) {
+        int32_t x = points[i].x, y = points[i].y;
+        if (x < 0 || y < 0 || x >= width || y >= height) continue;
+        row_start[y + 1]++;
+        visible++;
+        min_x = std::min(min_x, x);
+        max_x = std::max(max_x, x);
+        min_y = std::min(min_y, y);
+        max_y = std::max(max_y, y);
+    }
+    if (visible == 0) return;
+    
+    materialize_render(min_x, min_y, max_x - min_x + 1, max_y - min_y + 1);
+    
+    // Stable bucket sort by row so PSRAM is written in order; points that
+    // land on the same pixel keep their submission order
+    for (uint16_t y = 0; y < height; y++) {
+        row_start[y + 1] += row_start[y];
+    }
+    std::vector<uint32_t> order(visible);
+    for (size_t i = 0; i < count; i++) {
+        int32_t x = points[i].x, y = points[i].y;
+        if (x < 0 || y < 0 || x >= width || y >= height) continue;
+        order[row_start[y]++] = (uint32_t)i;
+    }
+    
+    for (size_t k = 0; k < visible; k++) {
+        const tft_point_t& p = points[order[k]];
+        current_framebuffer[p.y * width + p.x] = colors ? colors[order[k]] : color;
+    }
+    
+    expand_dirty_rect(min_x, min_y, max_x - min_x + 1, max_y - min_y + 1);
+}
+
+void TFT7735V::drawLines(const tft_line_t* lines, size_t count) {
+    if (lines == nullptr || count == 0) return;
+    int32_t b[4] = { 0, 0, 0, 0 };
+    if (tracing()) trace_bounds(lines, count, b);
+    trace_scope trace(this, TFT_TRACE_OP_LINES, { (int32_t)count, b[0], b[1], b[2], b[3],
+                                                  (int32_t)trace_hash(lines, count * sizeof(tft_line_t)) });
+    if (framebuffer_enabled && current_framebuffer == nullptr) return;
+    
+    int32_t min_x = width, max_x = -1, min_y = height, max_y = -1;
+    
+    for (size_t i = 0; i < count; i++) {
+        int32_t x0 = lines[i].x0, y0 = lines[i].y0, x1 = lines[i].x1, y1 = lines[i].y1;
+        uint16_t color = lines[i].color;
+        
+        // Trivially reject lines entirely off screen
+        int32_t lx0 = std::max<int32_t>(0, std::min(x0, x1)), lx1 = std::min<int32_t>(width - 1, std::max(x0, x1));
+        int32_t ly0 = std::max<int32_t>(0, std::min(y0, y1)), ly1 = std::min<int32_t>(height - 1, std::max(y0, y1));
+        if (lx0 > lx1 || ly0 > ly1) continue;
+        
+        if (y0 == y1 || x0 == x1) {
+            if (fb_full()) {
+                fb_fill_rect_raw(lx0, ly0, lx1 - lx0 + 1, ly1 - ly0 + 1, color);
+            } else {
+                fill_rect(lx0, ly0, lx1 - lx0 + 1, ly1 - ly0 + 1, color);
+            }
+        } else {
+            if (fb_full()) {
+                materialize_render(lx0, ly0, lx1 - lx0 + 1, ly1 - ly0 + 1);
+            }
+            plot_line(x0, y0, x1, y1, color);
+        }
+        
+        min_x = std::min(min_x, lx0);
+        max_x = std::max(max_x, lx1);
+        min_y = std::min(min_y, ly0);
+        max_y = std::max(max_y, ly1);
+    }
+    
+    if (fb_full() && max_x >= min_x) {
+        expand_dirty_rect(min_x, min_y, max_x - min_x + 1, max_y - min_y + 1);
+    }
+}
+
+// Bresenham with per-pixel clipping, no damage tracking
+void TFT7735V::plot_line(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t color) {
+    int32_t dx = abs(x1 - x0), dy = abs(y1 - y0);
+    int32_t sx = x0 < x1 ? 1 : -1, sy = y0 < y1 ? 1 : -1;
+    int32_t err = dx - dy;
+    while (true) {
+        if (x0 >= 0 && y0 >= 0 && x0 < width && y0 < height) {
+            if (fb_full()) {
+                current_framebuffer[y0 * width + x0] = color;
+            } else {
+                draw_pixel(x0, y0, color);
+            }
+        }
+        if (x0 == x1 && y0 == y1) break;
+        int32_t e2 = 2 * err;
+        if (e2 > -dy) { err -= dy; x0 += sx; }
+        if (e2 < dx) { err += dx; y0 += sy; }
+    }
+}
+
+void TFT7735V::fillRects(const tft_rect_t* rects, size_t count) {
+    if (rects == nullptr || count == 0) return;
+    int32_t b[4] = { 0, 0, 0, 0 };
+    if (tracing()) trace_bounds(rects, count, b);
+    trace_scope trace(this, TFT_TRACE_OP_RECTS, { (int32_t)count, b[0], b[1], b[2], b[3],
+                                                  (int32_t)trace_hash(rects, count * sizeof(tft_rect_t)) });
+    if (framebuffer_enabled && current_framebuffer == nullptr) return;
+    
+    // Submission order is kept so overlapping rects paint as expected
+    int32_t min_x = width, max_x = -1, min_y = height, max_y = -1;
+    for (size_t i = 0; i < count; i++) {
+        int32_t x0 = std::max<int32_t>(0, rects[i].x), y0 = std::max<int32_t>(0, rects[i].y);
+        int32_t x1 = std::min<int32_t>(width, (int32_t)rects[i].x + rects[i].w);
+        int32_t y1 = std::min<int32_t>(height, (int32_t)rects[i].y + rects[i].h);
+        if (x0 >= x1 || y0 >= y1) continue;
+        
+        if (!fb_full()) {
+            fill_rect(x0, y0, x1 - x0, y1 - y0, rects[i].color);
+            continue;
+        }
+        
+        fb_fill_rect_raw(x0, y0, x1 - x0, y1 - y0, rects[i].color);
+        min_x = std::min(min_x, x0);
+        max_x = std::max(max_x, x1 - 1);
+        min_y = std::min(min_y, y0);
+        max_y = std::max(max_y, y1 - 1);
+    }
+    
+    if (fb_full() && max_x >= min_x) {
+        expand_dirty_rect(min_x, min_y, max_x - min_x + 1, max_y - min_y + 1);
+    }
+}
+
+// Region effects. Pixels are processed as RGB565 pairs in 32-bit words: the
+// low word masks B0, R0 and G1, the word shifted right by 5 masks G0, B1 and
+// R1, which leaves enough headroom between fields for a multiply by 0..32.
+#define PAIR_MASK_LO 0x07E0F81Fu
+#define PAIR_MASK_HI 0x07C0F83Fu
+
+static inline uint32_t lerp_pair(uint32_t p, uint32_t to_lo, uint32_t to_hi, uint32_t alpha) {
+    uint32_t lo = p & PAIR_MASK_LO;
+    uint32_t hi = (p >> 5) & PAIR_MASK_HI;
+    lo = ((lo * (32 - alpha) + to_lo * alpha) >> 5) & PAIR_MASK_LO;
+    hi = ((hi * (32 - alpha) + to_hi * alpha) >> 5) & PAIR_MASK_HI;
+    return lo | (hi << 5);
+}
+
+bool TFT7735V::clip_effect_region(int16_t& x, int16_t& y, int16_t& w, int16_t& h) {
+    if (!framebuffer_enabled || current_framebuffer == nullptr) return false;
+    // Effects read back, so they stop at the framebuffer window
+    int32_t x0 = std::max<int32_t>(fb_x, x), y0 = std::max<int32_t>(fb_y, y);
+    int32_t x1 = std::min<int32_t>(fb_x + fb_w, (int32_t)x + w), y1 = std::min<int32_t>(fb_y + fb_h, (int32_t)y + h);
+    if (x0 >= x1 || y0 >= y1) return false;
+    x = x0; y = y0; w = x1 - x0; h = y1 - y0;
+    materialize_render(x, y, w, h);
+    return true;
+}
+
+void TFT7735V::blend_region(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color, uint8_t alpha) {
+    uint32_t pair = color | ((uint32_t)color << 16);
+    uint32_t to_lo = pair & PAIR_MASK_LO;
+    uint32_t to_hi = (pair >> 5) & PAIR_MASK_HI;
+    
+    for (int16_t row = 0; row < h; row++) {
+        uint16_t* p = current_framebuffer + fb_offset(x, y + row);
+        int16_t n = w;
+        // Align to a 32-bit word, pairs in the middle, odd pixel at the end
+        if (((uintptr_t)p & 2) != 0) {
+            *p = (uint16_t)lerp_pair(*p, to_lo, to_hi, alpha);
+            p++;
+            n--;
+        }
+        uint32_t* words = (uint32_t*)p;
+        for (int16_t i = 0; i < n / 2; i++) {
+            words[i] = lerp_pair(words[i], to_lo, to_hi, alpha);
+        }
+        if (n & 1) {
+            p[n - 1] = (uint16_t)lerp_pair(p[n - 1], to_lo, to_hi, alpha);
+        }
+    }
+    expand_dirty_rect(x, y, w, h);
+}
+
+bool TFT7735V::dimRegion(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t level) {
+    trace_scope trace(this, TFT_TRACE_OP_DIM, { x, y, w, h, level });
+    if (!clip_effect_region(x, y, w, h)) return false;
+    if (level == 255) return true;
+    blend_region(x, y, w, h, 0x0000, 32 - ((level + 4) >> 3));
+    return true;
+}
+
+bool TFT7735V::tintRegion(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color, uint8_t amount) {
+    trace_scope trace(this, TFT_TRACE_OP_TINT, { x, y, w, h, color, amount });
+    if (!clip_effect_region(x, y, w, h)) return false;
+    if (amount == 0) return true;
+    blend_region(x, y, w, h, color, (amount + 4) >> 3);
+    return true;
+}
+
+bool TFT7735V::invertRegion(int16_t x, int16_t y, int16_t w, int16_t h) {
+    trace_scope trace(this, TFT_TRACE_OP_INVERT, { x, y, w, h });
+    if (!clip_effect_region(x, y, w, h)) return false;
+    for (int16_t row = 0; row < h; row++) {
+        uint16_t* p = current_framebuffer + fb_offset(x, y + row);
+        int16_t n = w;
+        if (((uintptr_t)p & 2) != 0) {
+            *p = ~*p;
+            p++;
+            n--;
+        }
+        uint32_t* words = (uint32_t*)p;
+        for (int16_t i = 0; i < n / 2; i++) words[i] = ~words[i];
+        if (n & 1) p[n - 1] = ~p[n - 1];
+    }
+    expand_dirty_rect(x, y, w, h);
+    return true;
+}
+
+// Box blur sums use one pixel spread over a word (B bits 0-10, R 11-20,
+// G 21-31), so one add per pixel updates all three channel sums. Up to 32
+// pixels fit before a field overflows into the next.
+static inline uint32_t spread565(uint16_t c) {
+    return (c | ((uint32_t)c << 16)) & PAIR_MASK_LO;
+}
+
+static inline uint16_t box_average(uint32_t sum, uint32_t half, uint32_t recip) {
+    uint32_t b = (((sum & 0x7FF) + half) * recip) >> 16;
+    uint32_t r = ((((sum >> 11) & 0x3FF) + half) * recip) >> 16;
+    uint32_t g = (((sum >> 21) + half) * recip) >> 16;
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+// Rolling box sum along one row with clamped edges
+static void box_blur_row(const uint16_t* src, uint16_t* dst, int32_t n, int32_t radius,
+                         uint32_t half, uint32_t recip) {
+    uint32_t sum = spread565(src[0]) * (radius + 1);
+    for (int32_t i = 1; i <= radius; i++) sum += spread565(src[std::min(i, n - 1)]);
+    
+    for (int32_t i = 0; i < n; i++) {
+        dst[i] = box_average(sum, half, recip);
+        sum += spread565(src[std::min(i + radius + 1, n - 1)]);
+        sum -= spread565(src[std::max(i - radius, (int32_t)0)]);
+    }
+}
+
+bool TFT7735V::blurRegion(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t radius, uint8_t passes) {
+    trace_scope trace(this, TFT_TRACE_OP_BLUR, { x, y, w, h, radius, passes });
+    if (!clip_effect_region(x, y, w, h)) return false;
+    if (radius > TFT_BLUR_MAX_RADIUS) radius = TFT_BLUR_MAX_RADIUS;
+    if (radius == 0 || passes == 0) return true;
+    
+    int32_t r = radius;
+    uint32_t window = 2 * r + 1;
+    uint32_t recip = (65536 + window - 1) / window;
+    uint32_t half = window / 2;
+    std::vector<uint16_t> line(w);
+    // The vertical pass slides per-column sums down the region in row order;
+    // rows already overwritten are kept in a ring of radius + 1 copies for
+    // the trailing edge
+    std::vector<uint32_t> sums(w);
+    std::vector<uint16_t> ring((r + 1) * w);
+    uint16_t* base = current_framebuffer + fb_offset(x, y);
+    
+    for (uint8_t pass = 0; pass < passes; pass++) {
+        for (int32_t row = 0; row < h; row++) {
+            uint16_t* p = base + row * fb_w;
+            memcpy(&line[0], p, w * sizeof(uint16_t));
+            box_blur_row(&line[0], p, w, r, half, recip);
+        }
+        
+        for (int32_t col = 0; col < w; col++) sums[col] = spread565(base[col]) * (r + 1);
+        for (int32_t i = 1; i <= r; i++) {
+            const uint16_t* p = base + std::min<int32_t>(i, h - 1) * fb_w;
+            for (int32_t col = 0; col < w; col++) sums[col] += spread565(p[col]);
+        }
+        
+        for (int32_t row = 0; row < h; row++) {
+            uint16_t* p = base + row * fb_w;
+            memcpy(&ring[(row % (r + 1)) * w], p, w * sizeof(uint16_t));
+            for (int32_t col = 0; col < w; col++) p[col] = box_average(sums[col], half, recip);
+            if (row == h - 1) break;
+            
+            const uint16_t* next = base + std::min<int32_t>(row + r + 1, h - 1) * fb_w;
+            const uint16_t* prev = &ring[(std::max<int32_t>(row - r, 0) % (r + 1)) * w];
+            for (int32_t col = 0; col < w; col++) {
+                sums[col] += spread565(next[col]);
+                sums[col] -= spread565(prev[col]);
+            }
+        }
+    }
+    expand_dirty_rect(x, y, w, h);
+    return true;
+}
+
+// Sprites
+
+tft_sprite_t* TFT7735V::sprite_slot(int16_t id) {
+    if (id < 0 || id >= (int16_t)sprites.size() || !sprites[id].used) return nullptr;
+    return &sprites[id];
+}
+
+void TFT7735V::mark_sprite(const tft_sprite_t& s) {
+    if (!s.visible) return;
+    mark_dirty_bounds(s.x, s.y, s.x + s.w - 1, s.y + s.h - 1);
+}
+
+int16_t TFT7735V::addSprite(const uint16_t* pixels, uint16_t w, uint16_t h, int16_t x, int16_t y, int16_t z) {
+    if (pixels == nullptr || w == 0 || h == 0) return -1;
+    
+    int16_t id = -1;
+    for (size_t i = 0; i < sprites.size(); i++) {
+        if (!sprites[i].used) {
+            id = i;
+            break;
+        }
+    }
+    if (id < 0) {
+        if (sprites.size() >= TFT_MAX_SPRITES) {
+            ESP_LOGW(TAG, "No free sprite slot");
+            return -1;
+        }
+        id = sprites.size();
+        sprites.push_back(tft_sprite_t());
+    }
+    
+    tft_sprite_t& s = sprites[id];
+    s.pixels = pixels;
+    s.x = x;
+    s.y = y;
+    s.w = w;
+    s.h = h;
+    s.z = z;
+    s.key = 0;
+    s.keyed = false;
+    s.alpha = 255;
+    s.visible = true;
+    s.used = true;
+    mark_sprite(s);
+    
+    // Recorded once the id is known, so replay can follow it
+    trace_scope trace(this, TFT_TRACE_OP_SPRITE_ADD, { id, w, h, x, y, z, (int32_t)trace_hash(pixels, (size_t)w * h * sizeof(uint16_t)) });
+    return id;
+}
+
+bool TFT7735V::removeSprite(int16_t id) {
+    trace_scope trace(this, TFT_TRACE_OP_SPRITE_REMOVE, { id });
+    tft_sprite_t* s = sprite_slot(id);
+    if (s == nullptr) return false;
+    mark_sprite(*s);
+    s->used = false;
+    while (!sprites.empty() && !sprites.back().used) sprites.pop_back();
+    return true;
+}
+
+void TFT7735V::clearSprites() {
+    trace_scope trace(this, TFT_TRACE_OP_SPRITE_CLEAR, {});
+    for (size_t i = 0; i < sprites.size(); i++) {
+        if (sprites[i].used) mark_sprite(sprites[i]);
+    }
+    sprites.clear();
+}
+
+bool TFT7735V::moveSprite(int16_t id, int16_t x, int16_t y) {
+    trace_scope trace(this, TFT_TRACE_OP_SPRITE_MOVE, { id, x, y });
+    tft_sprite_t* s = sprite_slot(id);
+    if (s == nullptr) return false;
+    if (s->x == x && s->y == y) return true;
+    mark_sprite(*s);
+    s->x = x;
+    s->y = y;
+    mark_sprite(*s);
+    return true;
+}
+
+bool TFT7735V::setSpriteImage(int16_t id, const uint16_t* pixels) {
+    tft_sprite_t* s = sprite_slot(id);
+    if (s == nullptr || pixels == nullptr) return false;
+    trace_scope trace(this, TFT_TRACE_OP_SPRITE_IMAGE, { id, (int32_t)trace_hash(pixels, (size_t)s->w * s->h * sizeof(uint16_t)) });
+    s->pixels = pixels;
+    mark_sprite(*s);
+    return true;
+}
+
+bool TFT7735V::setSpriteZ(int16_t id, int16_t z) {
+    trace_scope trace(this, TFT_TRACE_OP_SPRITE_Z, { id, z });
+    tft_sprite_t* s = sprite_slot(id);
+    if (s == nullptr) return false;
+    if (s->z != z) {
+        s->z = z;
+        mark_sprite(*s);
+    }
+    return true;
+}
+
+bool TFT7735V::setSpriteColorKey(int16_t id, uint16_t key, bool enable) {
+    trace_scope trace(this, TFT_TRACE_OP_SPRITE_KEY, { id, key, enable });
+    tft_sprite_t* s = sprite_slot(id);
+    if (s == nullptr) return false;
+    s->key = key;
+    s->keyed = enable;
+    mark_sprite(*s);
+    return true;
+}
+
+bool TFT7735V::setSpriteAlpha(int16_t id, uint8_t alpha) {
+    trace_scope trace(this, TFT_TRACE_OP_SPRITE_ALPHA, { id, alpha });
+    tft_sprite_t* s = sprite_slot(id);
+    if (s == nullptr) return false;
+    if (s->alpha != alpha) {
+        s->alpha = alpha;
+        mark_sprite(*s);
+    }
+    return true;
+}
+
+bool TFT7735V::showSprite(int16_t id, bool visible) {
+    trace_scope trace(this, TFT_TRACE_OP_SPRITE_SHOW, { id, visible });
+    tft_sprite_t* s = sprite_slot(id);
+    if (s == nullptr) return false;
+    if (s->visible != visible) {
+        s->visible = true;
+        mark_sprite(*s);
+        s->visible = visible;
+    }
+    return true;
+}
+
+uint16_t TFT7735V::getSpriteCount() const {
+    uint16_t count = 0;
+    for (size_t i = 0; i < sprites.size(); i++) {
+        if (sprites[i].used) count++;
+    }
+    return count;
+}
+
+static bool sprite_z_less(const tft_sprite_t& a, const tft_sprite_t& b) {
+    return a.z < b.z;
+}
+
+// Called by display() for the buffer it queues; the display task reads the
+// snapshot only while that buffer is in flight
+void TFT7735V::snapshot_sprites(sprite_snapshot_t& snap) {
+    snap.sprites.clear();
+    snap.band_items.clear();
+    snap.band_start.clear();
+    snap.band_height = chunk_height;
+    
+    for (size_t i = 0; i < sprites.size(); i++) {
+        const tft_sprite_t& s = sprites[i];
+        if (!s.used || !s.visible || s.alpha == 0) continue;
+        if (s.x >= (int16_t)width || s.y >= (int16_t)height || s.x + s.w <= 0 || s.y + s.h <= 0) continue;
+        snap.sprites.push_back(s);
+    }
+    if (snap.sprites.empty() || snap.band_height == 0) return;
+    std::stable_sort(snap.sprites.begin(), snap.sprites.end(), sprite_z_less);
+    
+    uint16_t bands = (height + snap.band_height - 1) / snap.band_height;
+    snap.band_start.resize(bands + 1);
+    for (uint16_t b = 0; b < bands; b++) {
+        snap.band_start[b] = snap.band_items.size();
+        int32_t band_y0 = b * snap.band_height;
+        int32_t band_y1 = band_y0 + snap.band_height;
+        for (size_t i = 0; i < snap.sprites.size(); i++) {
+            const tft_sprite_t& s = snap.sprites[i];
+            if (s.y < band_y1 && s.y + s.h > band_y0) snap.band_items.push_back(i);
         }
-        
-        src += current_chunk;
-        remaining -= current_chunk;
     }
+    snap.band_start[bands] = snap.band_items.size();
 }
 
-void TFT7735V::draw_fast_vline(uint16_t x, uint16_t y, uint16_t h, uint16_t color) {
-    if (framebuffer_enabled) {
-        fb_draw_fast_vline(x, y, h, color);
-    } else {
-        fill_rect(x, y, 1, h, color);
+bool TFT7735V::sprites_in_window(const sprite_snapshot_t& snap, uint16_t x, uint16_t y, uint16_t w, uint16_t rows) const {
+    if (snap.band_start.empty() || rows == 0) return false;
+    uint16_t bands = snap.band_start.size() - 1;
+    uint16_t last = (y + rows - 1) / snap.band_height;
+    for (uint16_t b = y / snap.band_height; b <= last && b < bands; b++) {
+        for (uint16_t n = snap.band_start[b]; n < snap.band_start[b + 1]; n++) {
+            const tft_sprite_t& s = snap.sprites[snap.band_items[n]];
+            if (s.x < x + w && s.x + s.w > x && s.y < y + rows && s.y + s.h > y) return true;
+        }
     }
+    return false;
 }
 
-void TFT7735V::draw_fast_hline(uint16_t x, uint16_t y, uint16_t w, uint16_t color) {
-    if (framebuffer_enabled) {
-        fb_draw_fast_hline(x, y, w, color);
-    } else {
-        fill_rect(x, y, w, 1, color);
+// Draw the snapshot sprites over rows y .. y + rows - 1, columns x .. x + w - 1
+// of native pixels packed w per row
+void TFT7735V::compose_sprites(const sprite_snapshot_t& snap, uint16_t x, uint16_t y, uint16_t w, uint16_t rows, uint16_t* dst) {
+    uint16_t bands = snap.band_start.size() - 1;
+    uint16_t first = y / snap.band_height;
+    uint16_t last = (y + rows - 1) / snap.band_height;
+    
+    for (uint16_t b = first; b <= last && b < bands; b++) {
+        // Rows of this window inside band b
+        int32_t wy0 = std::max<int32_t>(y, b * snap.band_height);
+        int32_t wy1 = std::min<int32_t>(y + rows, (b + 1) * snap.band_height);
+        for (uint16_t n = snap.band_start[b]; n < snap.band_start[b + 1]; n++) {
+            const tft_sprite_t& s = snap.sprites[snap.band_items[n]];
+            int32_t x0 = std::max<int32_t>(x, s.x);
+            int32_t x1 = std::min<int32_t>(x + w, s.x + s.w);
+            int32_t y0 = std::max<int32_t>(wy0, s.y);
+            int32_t y1 = std::min<int32_t>(wy1, s.y + s.h);
+            if (x0 >= x1 || y0 >= y1) continue;
+            
+            uint8_t alpha = (s.alpha + 4) >> 3;
+            int32_t span = x1 - x0;
+            for (int32_t py = y0; py < y1; py++) {
+                const uint16_t* src = s.pixels + (py - s.y) * s.w + (x0 - s.x);
+                uint16_t* out = dst + (py - y) * w + (x0 - x);
+                if (!s.keyed && alpha >= 32) {
+                    memcpy(out, src, span * sizeof(uint16_t));
+                    continue;
+                }
+                for (int32_t i = 0; i < span; i++) {
+                    uint16_t c = src[i];
+                    if (s.keyed && c == s.key) continue;
+                    out[i] = (alpha >= 32) ? c : blend565(c, out[i], alpha);
+                }
+            }
+        }
     }
 }
 
@@ -552,7 +2697,8 @@ void TFT7735V::setTextWrap(bool wrap) {
 }
 
 void TFT7735V::drawChar(uint16_t x, uint16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size) {
-    if (framebuffer_enabled) {
+    trace_scope trace(this, TFT_TRACE_OP_CHAR, { x, y, c, color, bg, size, text_has_bg });
+    if (fb_full()) {
         fb_draw_char(x, y, c, color, bg, size, text_has_bg);
     } else {
         // Direct mode character drawing
@@ -585,6 +2731,9 @@ void TFT7735V::drawChar(uint16_t x, uint16_t y, unsigned char c, uint16_t color,
 }
 
 void TFT7735V::drawText(uint16_t x, uint16_t y, const char* text, uint16_t color) {
+    size_t len = tracing() ? strlen(text) : 0;
+    trace_scope trace(this, TFT_TRACE_OP_TEXT, { x, y, (int32_t)len, color, text_bg_color, 1, text_has_bg,
+                                                 (int32_t)trace_hash(text, len) });
     while (*text) {
         drawChar(x, y, *text, color, text_bg_color, 1);
         x += FONT8X8_WIDTH;
@@ -593,6 +2742,9 @@ void TFT7735V::drawText(uint16_t x, uint16_t y, const char* text, uint16_t color
 }
 
 void TFT7735V::drawText(uint16_t x, uint16_t y, const char* text, uint16_t color, uint16_t bg) {
+    size_t len = tracing() ? strlen(text) : 0;
+    trace_scope trace(this, TFT_TRACE_OP_TEXT, { x, y, (int32_t)len, color, bg, 1, text_has_bg,
+                                                 (int32_t)trace_hash(text, len) });
     while (*text) {
         drawChar(x, y, *text, color, bg, 1);
         x += FONT8X8_WIDTH;
@@ -601,6 +2753,9 @@ void TFT7735V::drawText(uint16_t x, uint16_t y, const char* text, uint16_t color
 }
 
 void TFT7735V::drawText(uint16_t x, uint16_t y, const char* text, uint16_t color, uint16_t bg, uint8_t size) {
+    size_t len = tracing() ? strlen(text) : 0;
+    trace_scope trace(this, TFT_TRACE_OP_TEXT, { x, y, (int32_t)len, color, bg, size, text_has_bg,
+                                                 (int32_t)trace_hash(text, len) });
     while (*text) {
         drawChar(x, y, *text, color, bg, size);
         x += FONT8X8_WIDTH * size;
@@ -666,16 +2821,145 @@ size_t TFT7735V::println(float num, int decimals) {
 }
 
 uint16_t TFT7735V::getTextWidth(const char* text, uint8_t size) {
-    return strlen(text) * FONT8X8_WIDTH * size;
+    size_t widest = 0;
+    size_t run = 0;
+    for (const char* p = text; *p; p++) {
+        if (*p == '\n') {
+            run = 0;
+            continue;
+        }
+        if (++run > widest) widest = run;
+    }
+    return widest * FONT8X8_WIDTH * size;
 }
 
 uint16_t TFT7735V::getTextHeight(uint8_t size) {
     return FONT8X8_HEIGHT * size;
 }
 
+// Text boxes and labels. They are built from fillRect() and drawChar(), so
+// a trace records those calls and replays the exact pixels without needing
+// the label's previous state.
+
+void TFT7735V::draw_glyph_run(int16_t x, int16_t y, const char* text, size_t len, const tft_text_style_t& style) {
+    uint16_t gw = FONT8X8_WIDTH * style.size;
+    bool saved_has_bg = text_has_bg;
+    text_has_bg = true;
+    for (size_t i = 0; i < len; i++, x += gw) {
+        if (x < 0 || y < 0 || x >= (int16_t)width || y >= (int16_t)height) continue;
+        drawChar(x, y, text[i], style.color, style.bg, style.size);
+    }
+    text_has_bg = saved_has_bg;
+}
+
+void TFT7735V::fill_text_span(int16_t x0, int16_t x1, int16_t y, int16_t h, uint16_t color) {
+    int16_t y1 = y + h;
+    if (x0 < 0) x0 = 0;
+    if (y < 0) y = 0;
+    if (x1 > (int16_t)width) x1 = width;
+    if (y1 > (int16_t)height) y1 = height;
+    if (x0 >= x1 || y >= y1) return;
+    fillRect(x0, y, x1 - x0, y1 - y, color);
+}
+
+void TFT7735V::drawTextBox(int16_t x, int16_t y, uint16_t w, uint16_t h, const char* text, const tft_text_style_t& style) {
+    TFTTextLabel label(x, y, w, h, style);
+    drawLabel(label, text);
+}
+
+void TFT7735V::drawLabel(TFTTextLabel& label, const char* text) {
+    const tft_text_style_t& style = label.style;
+    if (style.size == 0 || text == nullptr) return;
+    uint16_t gw = FONT8X8_WIDTH * style.size;
+    uint16_t gh = FONT8X8_HEIGHT * style.size;
+    uint16_t line_h = gh + style.line_spacing;
+    const std::vector<tft_text_line_t>& layout =
+        text_layouts.lookup(text, label.w, label.h, gw, gh, style);
+
+    std::vector<TFTTextLabel::Line> lines(layout.size());
+    for (size_t i = 0; i < layout.size(); i++) {
+        lines[i].x = label.x + layout[i].x_offset;
+        lines[i].text.assign(text + layout[i].start, layout[i].length);
+        if (layout[i].ellipsis) lines[i].text.append("...");
+    }
+
+    if (!label.painted) {
+        // First draw: every pixel of the box outside the glyphs gets the background
+        int16_t box_right = label.x + label.w;
+        int16_t y = label.y;
+        for (size_t i = 0; i < lines.size(); i++, y += line_h) {
+            int16_t x1 = lines[i].x + lines[i].text.size() * gw;
+            fill_text_span(label.x, lines[i].x, y, gh, style.bg);
+            draw_glyph_run(lines[i].x, y, lines[i].text.data(), lines[i].text.size(), style);
+            fill_text_span(x1, box_right, y, gh, style.bg);
+            if (i + 1 < lines.size()) fill_text_span(label.x, box_right, y + gh, style.line_spacing, style.bg);
+        }
+        fill_text_span(label.x, box_right, y - (lines.empty() ? 0 : style.line_spacing),
+                       label.y + label.h - y + (lines.empty() ? 0 : style.line_spacing), style.bg);
+    } else {
+        size_t rows = lines.size() > label.drawn.size() ? lines.size() : label.drawn.size();
+        for (size_t i = 0; i < rows; i++) {
+            int16_t y = label.y + i * line_h;
+            bool has_new = i < lines.size();
+            bool has_old = i < label.drawn.size();
+            int16_t nx0 = has_new ? lines[i].x : 0;
+            int16_t nx1 = has_new ? nx0 + lines[i].text.size() * gw : 0;
+            int16_t ox0 = has_old ? label.drawn[i].x : 0;
+            int16_t ox1 = has_old ? ox0 + label.drawn[i].text.size() * gw : 0;
+
+            if (has_new) {
+                const std::string& cur = lines[i].text;
+                // Glyphs on the same cell grid as before are compared one by one
+                bool aligned = has_old && ((nx0 - ox0) % gw) == 0;
+                int32_t shift = aligned ? (nx0 - ox0) / gw : 0;
+                size_t j = 0;
+                while (j < cur.size()) {
+                    size_t run = j;
+                    while (run < cur.size()) {
+                        int32_t k = (int32_t)run + shift;
+                        bool same = aligned && k >= 0 && k < (int32_t)label.drawn[i].text.size() &&
+                                    label.drawn[i].text[k] == cur[run];
+                        if (same) break;
+                        run++;
+                    }
+                    if (run > j) draw_glyph_run(nx0 + j * gw, y, cur.data() + j, run - j, style);
+                    j = run + 1;
+                }
+            }
+            if (has_old) {
+                // Old glyph cells the new line no longer covers
+                if (!has_new || nx0 >= ox1 || nx1 <= ox0) {
+                    fill_text_span(ox0, ox1, y, gh, style.bg);
+                } else {
+                    if (ox0 < nx0) fill_text_span(ox0, nx0, y, gh, style.bg);
+                    if (nx1 < ox1) fill_text_span(nx1, ox1, y, gh, style.bg);
+                }
+            }
+        }
+    }
+
+    label.drawn.swap(lines);
+    label.painted = true;
+}
+
+uint16_t TFT7735V::getTextBoxHeight(const char* text, uint16_t w, const tft_text_style_t& style) {
+    if (style.size == 0 || text == nullptr) return 0;
+    uint16_t gh = FONT8X8_HEIGHT * style.size;
+    const std::vector<tft_text_line_t>& layout =
+        text_layouts.lookup(text, w, 0xFFFF, FONT8X8_WIDTH * style.size, gh, style);
+    if (layout.empty()) return 0;
+    return layout.size() * gh + (layout.size() - 1) * style.line_spacing;
+}
+
+void TFT7735V::getTextLayoutCacheStats(uint32_t& hits, uint32_t& misses) const {
+    hits = text_layouts.hits();
+    misses = text_layouts.misses();
+}
+
 // Extended drawing functions (Adafruit/LovyanGFX compatible)
 void TFT7735V::drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color) {
-    if (framebuffer_enabled) {
+    trace_scope trace(this, TFT_TRACE_OP_LINE, { x0, y0, x1, y1, color });
+    if (fb_full()) {
         fb_draw_line(x0, y0, x1, y1, color);
     } else {
         // Direct mode implementation - simple Bresenham line algorithm
@@ -712,7 +2996,8 @@ void TFT7735V::drawFastHLine(uint16_t x, uint16_t y, uint16_t w, uint16_t color)
 }
 
 void TFT7735V::drawRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
-    if (framebuffer_enabled) {
+    trace_scope trace(this, TFT_TRACE_OP_RECT, { x, y, w, h, color });
+    if (fb_full()) {
         fb_draw_rect(x, y, w, h, color);
     } else {
         // Direct mode - draw rectangle outline
@@ -731,7 +3016,8 @@ void TFT7735V::fillRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t
 }
 
 void TFT7735V::drawCircle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color) {
-    if (framebuffer_enabled) {
+    trace_scope trace(this, TFT_TRACE_OP_CIRCLE, { x0, y0, r, color });
+    if (fb_full()) {
         fb_draw_circle(x0, y0, r, color);
     } else {
         // Direct mode - Bresenham circle algorithm
@@ -762,7 +3048,8 @@ void TFT7735V::drawCircle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color)
 }
 
 void TFT7735V::fillCircle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color) {
-    if (framebuffer_enabled) {
+    trace_scope trace(this, TFT_TRACE_OP_FILL_CIRCLE, { x0, y0, r, color });
+    if (fb_full()) {
         fb_fill_circle(x0, y0, r, color);
     } else {
         // Direct mode - filled circle using horizontal lines
@@ -789,7 +3076,9 @@ void TFT7735V::fillCircle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color)
 }
 
 void TFT7735V::drawBitmap(uint16_t x, uint16_t y, const uint8_t *bitmap, uint16_t w, uint16_t h, uint16_t color) {
-    if (framebuffer_enabled) {
+    trace_scope trace(this, TFT_TRACE_OP_BITMAP, { x, y, w, h, color, 0, false,
+                                                   (int32_t)trace_hash(bitmap, ((w + 7) / 8) * h) });
+    if (fb_full()) {
         fb_draw_bitmap(x, y, bitmap, w, h, color, 0, false);
     } else {
         // Direct mode - draw monochrome bitmap
@@ -806,7 +3095,9 @@ void TFT7735V::drawBitmap(uint16_t x, uint16_t y, const uint8_t *bitmap, uint16_
 }
 
 void TFT7735V::drawBitmap(uint16_t x, uint16_t y, const uint8_t *bitmap, uint16_t w, uint16_t h, uint16_t color, uint16_t bg) {
-    if (framebuffer_enabled) {
+    trace_scope trace(this, TFT_TRACE_OP_BITMAP, { x, y, w, h, color, bg, true,
+                                                   (int32_t)trace_hash(bitmap, ((w + 7) / 8) * h) });
+    if (fb_full()) {
         fb_draw_bitmap(x, y, bitmap, w, h, color, bg, true);
     } else {
         // Direct mode - draw monochrome bitmap with background
@@ -822,21 +3113,20 @@ void TFT7735V::drawBitmap(uint16_t x, uint16_t y, const uint8_t *bitmap, uint16_
 }
 
 void TFT7735V::drawRGBBitmap(uint16_t x, uint16_t y, const uint16_t *bitmap, uint16_t w, uint16_t h) {
-    if (framebuffer_enabled) {
+    trace_scope trace(this, TFT_TRACE_OP_RGB_BITMAP, { x, y, w, h, false,
+                                                       (int32_t)trace_hash(bitmap, w * h * sizeof(uint16_t)) });
+    if (fb_full()) {
         fb_draw_rgb_bitmap(x, y, bitmap, nullptr, w, h, false);
     } else {
-        // Direct mode - draw RGB565 bitmap
-        for (uint16_t row = 0; row < h; row++) {
-            for (uint16_t col = 0; col < w; col++) {
-                uint16_t pixel_color = bitmap[row * w + col];
-                draw_pixel(x + col, y + row, pixel_color);
-            }
-        }
+        // Direct mode - stream the rows through one address window
+        drawRGBBitmapRegion(x, y, bitmap, w, 0, 0, w, h);
     }
 }
 
 void TFT7735V::drawRGBBitmap(uint16_t x, uint16_t y, const uint16_t *bitmap, const uint8_t *mask, uint16_t w, uint16_t h) {
-    if (framebuffer_enabled) {
+    trace_scope trace(this, TFT_TRACE_OP_RGB_BITMAP, { x, y, w, h, true,
+                                                       (int32_t)trace_hash(bitmap, w * h * sizeof(uint16_t)) });
+    if (fb_full()) {
         fb_draw_rgb_bitmap(x, y, bitmap, mask, w, h, true);
     } else {
         // Direct mode - draw RGB565 bitmap with mask
@@ -864,7 +3154,7 @@ void TFT7735V::setSPISpeed(uint32_t hz) {
     ESP_LOGI(TAG, "SPI speed set to: %lu Hz", hz);
     
     // If already initialized, update the SPI device speed
-    if (initialized && spi_device) {
+    if (initialized) {
         update_spi_speed();
     }
 }
@@ -978,8 +3268,31 @@ void TFT7735V::apply_brightness() {
     }
 }
 
+// ESP-IDF has no API to retune a registered device, so this re-registers only
+// the device handle: bus, panel state and framebuffers are kept
 void TFT7735V::update_spi_speed() {
-    if (!initialized || !spi_device) {
+    if (!initialized) {
+        return;
+    }
+    
+    // Never swap the device under a running transfer
+    waitForDisplayDone();
+    
+#if TFT7735V_HAS_ESP_LCD
+    // esp_lcd panel IO has a fixed pclk: recreate it on the same bus
+    if (lcd_io != nullptr) {
+        ESP_LOGI(TAG, "Updating panel IO clock to: %lu Hz", spi_frequency);
+        wait_transfers(0);
+        esp_lcd_panel_io_del(lcd_io);
+        lcd_io = nullptr;
+        if (init_esp_lcd_io()) {
+            ESP_LOGI(TAG, "Panel IO clock updated successfully");
+        }
+        return;
+    }
+#endif
+    
+    if (!spi_device) {
         return;
     }
     
@@ -988,6 +3301,7 @@ void TFT7735V::update_spi_speed() {
     ESP_LOGI(TAG, "Updating SPI speed to: %lu Hz", spi_frequency);
     
     // Remove current device
+    bus_release();
     esp_err_t ret = spi_bus_remove_device(spi_device);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to remove SPI device: %s", esp_err_to_name(ret));
@@ -1003,7 +3317,7 @@ void TFT7735V::update_spi_speed() {
     devcfg.pre_cb = nullptr;
     devcfg.flags = SPI_DEVICE_HALFDUPLEX;
     
-    ret = spi_bus_add_device(SPI2_HOST, &devcfg, &spi_device);
+    ret = spi_bus_add_device(spi_host, &devcfg, &spi_device);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to re-add SPI device: %s", esp_err_to_name(ret));
         spi_device = nullptr;
@@ -1013,69 +3327,224 @@ void TFT7735V::update_spi_speed() {
     ESP_LOGI(TAG, "SPI speed updated successfully");
 }
 
-// Framebuffer methods
-bool TFT7735V::init_framebuffer() {
-    if (framebuffer_a != nullptr || framebuffer_b != nullptr || framebuffer_c != nullptr) {
-        ESP_LOGW(TAG, "Triple framebuffers already initialized");
-        return true;
+void TFT7735V::setMISOPin(gpio_num_t miso) {
+    if (initialized) {
+        ESP_LOGW(TAG, "setMISOPin() must be called before begin()");
+        return;
     }
+    pins.miso = miso;
+}
+
+// Read w pixels of GRAM starting at (x, y) via RAMRD. The controller returns
+// 18-bit color, 3 bytes per pixel with each channel in the upper 6 bits.
+bool TFT7735V::read_pixels(uint16_t x, uint16_t y, uint16_t w, uint8_t* rgb666) {
+    set_addr_window_raw(x, y, x + w - 1, y);
     
-    // Allocate triple framebuffers in PSRAM
-    framebuffer_a = (uint16_t*)heap_caps_malloc(framebuffer_size, MALLOC_CAP_SPIRAM);
-    if (framebuffer_a == nullptr) {
-        ESP_LOGE(TAG, "Failed to allocate framebuffer A in PSRAM (%zu bytes)", framebuffer_size);
+    // CS must stay low from the RAMRD command through the data phase
+    esp_err_t ret = spi_device_acquire_bus(spi_device, portMAX_DELAY);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to acquire SPI bus for readback: %s", esp_err_to_name(ret));
         return false;
     }
     
-    framebuffer_b = (uint16_t*)heap_caps_malloc(framebuffer_size, MALLOC_CAP_SPIRAM);
-    if (framebuffer_b == nullptr) {
-        ESP_LOGE(TAG, "Failed to allocate framebuffer B in PSRAM (%zu bytes)", framebuffer_size);
-        heap_caps_free(framebuffer_a);
-        framebuffer_a = nullptr;
+    gpio_set_level(dc_pin, 0); // Command mode
+    spi_transaction_t cmd = {};
+    cmd.length = 8;
+    cmd.tx_data[0] = ST7735_RAMRD;
+    cmd.flags = SPI_TRANS_USE_TXDATA | SPI_TRANS_CS_KEEP_ACTIVE;
+    ret = spi_device_polling_transmit(spi_device, &cmd);
+    
+    if (ret == ESP_OK) {
+        gpio_set_level(dc_pin, 1); // Data mode
+        spi_transaction_ext_t t = {};
+        t.base.flags = SPI_TRANS_VARIABLE_DUMMY;
+        t.base.length = 0;
+        t.base.rxlength = (size_t)w * 3 * 8;
+        t.base.rx_buffer = rgb666;
+        t.dummy_bits = panel->ramrd_dummy_bits;
+        ret = spi_device_polling_transmit(spi_device, &t.base);
+    }
+    
+    spi_device_release_bus(spi_device);
+    
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to read GRAM: %s", esp_err_to_name(ret));
         return false;
     }
+    return true;
+}
+
+// Write one test pattern to the calibration strip at the current clock, then
+// read it back at TFT_SPI_READ_FREQ. Reads are much slower than writes on
+// these controllers, so only the write clock is under test.
+bool TFT7735V::verify_test_pattern(uint8_t pattern) {
+    uint16_t* tx = sram_buffer_a;
+    uint8_t* rx = (uint8_t*)sram_buffer_b;
+    uint16_t colors[TFT_CALIBRATION_PIXELS];
+    
+    uint16_t lfsr = 0xACE1;
+    for (int i = 0; i < TFT_CALIBRATION_PIXELS; i++) {
+        switch (pattern) {
+            case 0: colors[i] = (i & 1) ? 0xFFFF : 0x0000; break;   // Full swing
+            case 1: colors[i] = (i & 1) ? 0x5555 : 0xAAAA; break;   // Alternating bits
+            case 2: colors[i] = 1 << (i % 16); break;               // Walking one
+            default:                                                // Pseudo-random
+                lfsr = (lfsr >> 1) ^ (-(lfsr & 1) & 0xB400);
+                colors[i] = lfsr;
+                break;
+        }
+        tx[i] = __builtin_bswap16(colors[i]);
+    }
     
-    framebuffer_c = (uint16_t*)heap_caps_malloc(framebuffer_size, MALLOC_CAP_SPIRAM);
-    if (framebuffer_c == nullptr) {
-        ESP_LOGE(TAG, "Failed to allocate framebuffer C in PSRAM (%zu bytes)", framebuffer_size);
-        heap_caps_free(framebuffer_a);
-        heap_caps_free(framebuffer_b);
-        framebuffer_a = nullptr;
-        framebuffer_b = nullptr;
+    set_addr_window_raw(0, 0, TFT_CALIBRATION_PIXELS - 1, 0);
+    write_pixels(tx, TFT_CALIBRATION_PIXELS * sizeof(uint16_t), true);
+    
+    uint32_t test_frequency = spi_frequency;
+    spi_frequency = TFT_SPI_READ_FREQ;
+    update_spi_speed();
+    bool ok = read_pixels(0, 0, TFT_CALIBRATION_PIXELS, rx);
+    spi_frequency = test_frequency;
+    update_spi_speed();
+    if (!ok) {
         return false;
     }
     
-    ESP_LOGI(TAG, "Triple framebuffers allocated in PSRAM (3 x %zu bytes = %zu total)", 
-             framebuffer_size, framebuffer_size * 3);
+    for (int i = 0; i < TFT_CALIBRATION_PIXELS; i++) {
+        uint8_t r = rx[i * 3] >> 3;
+        uint8_t g = rx[i * 3 + 1] >> 2;
+        uint8_t b = rx[i * 3 + 2] >> 3;
+        uint8_t want_r = colors[i] >> 11;
+        uint8_t want_g = (colors[i] >> 5) & 0x3F;
+        uint8_t want_b = colors[i] & 0x1F;
+        // BGR panels may return red and blue swapped
+        bool match = (g == want_g) && ((r == want_r && b == want_b) || (r == want_b && b == want_r));
+        if (!match) {
+            ESP_LOGD(TAG, "Pattern %d mismatch at pixel %d: wrote 0x%04X", pattern, i, colors[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Find the highest SPI clock at which GRAM writes read back intact, then back
+// off by margin_percent and switch to it. Returns the chosen frequency.
+uint32_t TFT7735V::calibrateSPISpeed(uint32_t max_hz, uint8_t margin_percent) {
+    if (!initialized || spi_device == nullptr) {
+        ESP_LOGW(TAG, "Calibration needs an initialized spi_master transport");
+        return spi_frequency;
+    }
+    if (pins.miso == GPIO_NUM_NC) {
+        ESP_LOGW(TAG, "Calibration needs a MISO pin (setMISOPin)");
+        return spi_frequency;
+    }
+    
+    // The SRAM buffers are used for the test transfers
+    waitForDisplayDone();
+    
+    uint32_t original_frequency = spi_frequency;
+    uint32_t best = 0;
+    
+    // Achievable clocks are 80 MHz / n; test from slow to fast and stop at
+    // the first failure, everything above it is marginal
+    for (int div = 8; div >= 1; div--) {
+        uint32_t candidate = 80000000 / div;
+        if (candidate > max_hz) break;
+        
+        spi_frequency = candidate;
+        update_spi_speed();
+        
+        bool ok = true;
+        for (uint8_t pattern = 0; pattern < 4 && ok; pattern++) {
+            ok = verify_test_pattern(pattern);
+        }
+        ESP_LOGI(TAG, "Calibration: %lu Hz %s", candidate, ok ? "OK" : "FAILED");
+        if (!ok) break;
+        best = candidate;
+    }
+    
+    if (best == 0) {
+        ESP_LOGW(TAG, "Calibration failed at all clocks, keeping %lu Hz", original_frequency);
+        spi_frequency = original_frequency;
+    } else {
+        // Highest 80 MHz / n clock at or below best minus margin
+        uint32_t target = (uint32_t)((uint64_t)best * (100 - std::min<uint8_t>(margin_percent, 90)) / 100);
+        uint32_t chosen = 80000000 / 8;
+        for (int div = 8; div >= 1; div--) {
+            uint32_t candidate = 80000000 / div;
+            if (candidate <= target) chosen = candidate;
+        }
+        spi_frequency = chosen;
+        ESP_LOGI(TAG, "Calibration: max reliable %lu Hz, using %lu Hz", best, chosen);
+    }
+    
+    update_spi_speed();
+    
+    // The test strip overwrote GRAM
+    forceFullRedraw();
+    return spi_frequency;
+}
+
+// Framebuffer methods
+bool TFT7735V::init_framebuffer() {
+    if (framebuffers[0] != nullptr) {
+        ESP_LOGW(TAG, "Framebuffers already initialized");
+        return true;
+    }
+    
+    // Allocate the framebuffers in PSRAM
+    for (uint8_t i = 0; i < framebuffer_count; i++) {
+        framebuffers[i] = (uint16_t*)heap_caps_malloc(framebuffer_size, MALLOC_CAP_SPIRAM);
+        if (framebuffers[i] == nullptr) {
+            ESP_LOGE(TAG, "Failed to allocate framebuffer %d in PSRAM (%zu bytes)", i, framebuffer_size);
+            free_framebuffer();
+            return false;
+        }
+        // Clear all framebuffers
+        memset(framebuffers[i], 0, framebuffer_size);
+        buffer_states[i] = BUFFER_STATE_IDLE;
+    }
     
-    // Clear all framebuffers
-    memset(framebuffer_a, 0, framebuffer_size);
-    memset(framebuffer_b, 0, framebuffer_size);
-    memset(framebuffer_c, 0, framebuffer_size);
+    ESP_LOGI(TAG, "%d framebuffers allocated in PSRAM (%d x %zu bytes = %zu total)", 
+             framebuffer_count, framebuffer_count, framebuffer_size, framebuffer_size * framebuffer_count);
     
-    // Set initial render buffer (buffer A)
-    current_framebuffer = framebuffer_a;
+    // Set initial render buffer
+    render_buffer_idx = 0;
+    current_framebuffer = framebuffers[0];
     buffer_states[0] = BUFFER_STATE_RENDERING;
+    frame_queue_head = 0;
+    frame_queue_count = 0;
+    transfer_active = false;
+    
+    // Tiles follow the screen grid, a window has none
+    if (!fb_window && !init_tile_tables()) {
+        ESP_LOGW(TAG, "Lazy clear unavailable (tile tables not allocated)");
+    }
     
     return true;
 }
 
 void TFT7735V::free_framebuffer() {
-    if (framebuffer_a != nullptr) {
-        heap_caps_free(framebuffer_a);
-        framebuffer_a = nullptr;
-    }
-    if (framebuffer_b != nullptr) {
-        heap_caps_free(framebuffer_b);
-        framebuffer_b = nullptr;
-    }
-    if (framebuffer_c != nullptr) {
-        heap_caps_free(framebuffer_c);
-        framebuffer_c = nullptr;
+    for (int i = 0; i < TFT_MAX_FRAMEBUFFERS; i++) {
+        if (framebuffers[i] != nullptr) {
+            heap_caps_free(framebuffers[i]);
+            framebuffers[i] = nullptr;
+        }
+        sprite_snapshots[i].sprites.clear();
+        sprite_snapshots[i].band_start.clear();
     }
     current_framebuffer = nullptr;
     framebuffer_enabled = false;
-    ESP_LOGI(TAG, "Triple framebuffers freed");
+    free_tile_tables();
+    if (half_lines != nullptr) {
+        heap_caps_free(half_lines);
+        half_lines = nullptr;
+    }
+    if (res_shift != 0) {
+        // Direct mode draws at panel resolution
+        res_shift = 0;
+        set_logical_size();
+    }
+    ESP_LOGI(TAG, "Framebuffers freed");
 }
 
 bool TFT7735V::enableFramebuffer() {
@@ -1099,6 +3568,8 @@ bool TFT7735V::enableFramebuffer() {
 }
 
 void TFT7735V::disableFramebuffer() {
+    // Queued frames still read from the buffers
+    waitForDisplayDone();
     framebuffer_enabled = false;
     free_framebuffer();
     ESP_LOGI(TAG, "Framebuffer mode disabled");
@@ -1109,6 +3580,9 @@ bool TFT7735V::isFramebufferEnabled() const {
 }
 
 void TFT7735V::display() {
+    trace_scope trace(this, TFT_TRACE_OP_DISPLAY,
+                      { dirty_rect.x, dirty_rect.y, dirty_rect.w, dirty_rect.h,
+                        dirty_rect_enabled && dirty_rect.valid && !force_full_redraw });
     if (!framebuffer_enabled || current_framebuffer == nullptr) {
         ESP_LOGW(TAG, "Framebuffer not enabled or not allocated");
         return;
@@ -1119,98 +3593,237 @@ void TFT7735V::display() {
         return;
     }
     
-    if (display_in_progress) {
-        ESP_LOGW(TAG, "Display operation already in progress");
-        return;
-    }
-    
     if (display_queue == nullptr) {
         ESP_LOGE(TAG, "Display queue not initialized");
         return;
     }
     
-    // Perform buffer swap - find next available buffer for rendering
-    uint8_t next_render_idx = 255; // Invalid index
-    for (int i = 0; i < 3; i++) {
-        if (buffer_states[i] == BUFFER_STATE_IDLE) {
-            next_render_idx = i;
-            break;
+    // Partial mode: clip the transfer to the scanned strip
+    dirty_rect_t partial_rect = { 0, partial_y, width, partial_h, true };
+    if (partial_mode && dirty_rect_enabled && dirty_rect.valid && !force_full_redraw) {
+        uint16_t y0 = std::max(dirty_rect.y, partial_y);
+        uint16_t y1 = std::min<uint16_t>(dirty_rect.y + dirty_rect.h, partial_y + partial_h);
+        if (y0 >= y1) {
+            // Nothing visible changed: keep rendering into the same buffer
+            clearDirty();
+            return;
         }
+        partial_rect.x = dirty_rect.x;
+        partial_rect.w = dirty_rect.w;
+        partial_rect.y = y0;
+        partial_rect.h = y1 - y0;
     }
     
-    if (next_render_idx == 255) {
-        ESP_LOGW(TAG, "No idle buffer available for swap");
-        return;
+    // Find the buffer to render the next frame into. With every other
+    // buffer queued or on the wire, wait for the display task to free one.
+    int64_t stall_start_us = 0;
+    uint8_t next_render_idx;
+    while (true) {
+        portENTER_CRITICAL(&frame_queue_lock);
+        next_render_idx = find_idle_buffer();
+        portEXIT_CRITICAL(&frame_queue_lock);
+        if (next_render_idx != 255) break;
+        if (stall_start_us == 0) stall_start_us = esp_timer_get_time();
+        xSemaphoreTake(buffer_free_semaphore, pdMS_TO_TICKS(100));
+    }
+    if (stall_start_us != 0) {
+        uint32_t stall_us = (uint32_t)(esp_timer_get_time() - stall_start_us);
+        frame_stats.stalls++;
+        frame_stats.last_stall_us = stall_us;
+        frame_stats.total_stall_us += stall_us;
+        if (stall_us > frame_stats.max_stall_us) frame_stats.max_stall_us = stall_us;
+    }
+    
+    // Determine if we should use dirty rectangle optimization
+    bool use_dirty_rect = dirty_rect_enabled && dirty_rect.valid && !force_full_redraw;
+    dirty_rect_t send_rect = dirty_rect;
+    if (use_dirty_rect && res_shift != 0 && half_res_smooth) {
+        // Interpolated pixels left of and above the rect depend on it too
+        if (send_rect.x > 0) { send_rect.x--; send_rect.w++; }
+        if (send_rect.y > 0) { send_rect.y--; send_rect.h++; }
+    }
+    if (partial_mode) {
+        use_dirty_rect = true;
+        send_rect = partial_rect;
+    }
+    if (fb_window && !use_dirty_rect) {
+        // A full frame is the whole window
+        use_dirty_rect = true;
+        send_rect = { (uint16_t)fb_x, (uint16_t)fb_y, fb_w, fb_h, true };
     }
     
-    // Set current render buffer to transferring state
-    buffer_states[render_buffer_idx] = BUFFER_STATE_TRANSFERRING;
-    transfer_buffer_idx = render_buffer_idx;
+    // The frame carries its own damage, so frames queued behind it can
+    // track theirs from scratch
+    tft_queued_frame_t frame;
+    frame.buffer_idx = render_buffer_idx;
+    frame.seq = ++frame_seq;
+    frame.use_dirty_rect = use_dirty_rect;
+    frame.rect = use_dirty_rect ? send_rect : dirty_rect_t{0, 0, 0, 0, false};
+    frame.queued_us = esp_timer_get_time();
+    snapshot_sprites(sprite_snapshots[render_buffer_idx]);
+    
+    // Take semaphore to indicate display is not done
+    xSemaphoreTake(display_done_semaphore, 0);
     
-    // Switch to next render buffer
+    portENTER_CRITICAL(&frame_queue_lock);
+    buffer_states[render_buffer_idx] = BUFFER_STATE_QUEUED;
+    frame_queue[(frame_queue_head + frame_queue_count) % TFT_MAX_FRAMEBUFFERS] = frame;
+    frame_queue_count++;
+    uint8_t depth = frame_queue_count;
+    bool start = !transfer_active;
+    transfer_active = true;
+    display_in_progress = true;
+    display_done_flag = false;
     render_buffer_idx = next_render_idx;
     buffer_states[render_buffer_idx] = BUFFER_STATE_RENDERING;
+    portEXIT_CRITICAL(&frame_queue_lock);
     
-    // Update current framebuffer pointer
-    switch (render_buffer_idx) {
-        case 0: current_framebuffer = framebuffer_a; break;
-        case 1: current_framebuffer = framebuffer_b; break;
-        case 2: current_framebuffer = framebuffer_c; break;
-    }
+    current_framebuffer = framebuffers[render_buffer_idx];
+    clearDirty();
     
-    ESP_LOGI(TAG, "Buffer swap: render_idx=%d, transfer_idx=%d", render_buffer_idx, transfer_buffer_idx);
-    ESP_LOGI(TAG, "Starting async display operation (%dx%d, %d chunks)", width, height, total_chunks);
+    frame_stats.queue_depth = depth;
+    if (depth > frame_stats.max_queue_depth) frame_stats.max_queue_depth = depth;
     
-    // Mark display as in progress
-    display_in_progress = true;
-    display_done_flag = false;
-    current_chunk = 0;
-      // Take semaphore to indicate display is not done
-    xSemaphoreTake(display_done_semaphore, 0);
+    ESP_LOGI(TAG, "Frame %lu queued from buffer %d (depth %d), render_idx=%d",
+             (unsigned long)frame.seq, frame.buffer_idx, depth, render_buffer_idx);
     
-    // Determine if we should use dirty rectangle optimization
-    bool use_dirty_rect = dirty_rect_enabled && dirty_rect.valid && !force_full_redraw;
+    // Otherwise the display task starts it when the frames ahead are done
+    if (start && !send_first_chunk(frame)) {
+        frame_finished(frame.buffer_idx, frame.seq);
+    }
+}
+
+// Starts the transfer of a queued frame
+bool TFT7735V::send_first_chunk(const tft_queued_frame_t& frame) {
+    if (canvas_panel_count != 0) return send_canvas_frame(frame);
+    return post_first_chunk(frame);
+}
+
+// Posts the first chunk of a frame to this panel's display task
+bool TFT7735V::post_first_chunk(const tft_queued_frame_t& frame) {
     uint8_t start_chunk = 0, end_chunk = total_chunks - 1;
     uint8_t chunks_to_send = total_chunks;
     
-    if (use_dirty_rect) {
-        chunks_to_send = calculate_dirty_chunks(dirty_rect, start_chunk, end_chunk);
-        ESP_LOGI(TAG, "Using dirty rect optimization: chunks %d-%d (%d chunks)", 
+    if (frame.use_dirty_rect) {
+        chunks_to_send = calculate_dirty_chunks(frame.rect, start_chunk, end_chunk);
+        ESP_LOGD(TAG, "Using dirty rect optimization: chunks %d-%d (%d chunks)", 
                  start_chunk, end_chunk, chunks_to_send);
     } else {
-        ESP_LOGI(TAG, "Full frame display: %d chunks", total_chunks);
+        ESP_LOGD(TAG, "Full frame display: %d chunks", total_chunks);
     }
     
-    // Send first chunk message to display task
     display_message_t msg = {
         .chunk_idx = start_chunk,
+        .is_first_chunk = true,
         .is_last_chunk = (chunks_to_send == 1),
-        .source_buffer_idx = transfer_buffer_idx,
-        .use_dirty_rect = use_dirty_rect,
-        .dirty_rect = use_dirty_rect ? dirty_rect : dirty_rect_t{0, 0, 0, 0, false}
+        .source_buffer_idx = frame.buffer_idx,
+        .frame_seq = frame.seq,
+        .use_dirty_rect = frame.use_dirty_rect,
+        .dirty_rect = frame.rect,
+        .canvas_start = false
     };
     
-    BaseType_t ret = xQueueSend(display_queue, &msg, 0);
-    if (ret != pdPASS) {
+    if (xQueueSend(display_queue, &msg, 0) != pdPASS) {
         ESP_LOGE(TAG, "Failed to send display message to queue");
-        display_in_progress = false;
-        display_done_flag = true;
-        xSemaphoreGive(display_done_semaphore);
-        // Revert buffer states
-        buffer_states[transfer_buffer_idx] = BUFFER_STATE_IDLE;
-        return;
+        return false;
+    }
+    return true;
+}
+
+// Canvas frame: this panel's display task starts it (pacing and frame
+// statistics, whether or not this panel has damage), then posts the parts
+bool TFT7735V::send_canvas_frame(const tft_queued_frame_t& frame) {
+    display_message_t msg = {
+        .chunk_idx = 0,
+        .is_first_chunk = false,
+        .is_last_chunk = false,
+        .source_buffer_idx = frame.buffer_idx,
+        .frame_seq = frame.seq,
+        .use_dirty_rect = frame.use_dirty_rect,
+        .dirty_rect = frame.rect,
+        .canvas_start = true
+    };
+    if (xQueueSend(display_queue, &msg, 0) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to send canvas frame message to queue");
+        return false;
+    }
+    return true;
+}
+
+// Every panel gets its part of the damage in its own coordinates and
+// transfers it on its own display task
+void TFT7735V::start_canvas_frame(const display_message_t& msg) {
+    uint8_t idx = msg.source_buffer_idx;
+    start_frame(idx);
+    dirty_rect_t rect = msg.use_dirty_rect ? msg.dirty_rect : dirty_rect_t{0, 0, width, height, true};
+    tft_queued_frame_t frame = {};
+    frame.buffer_idx = idx;
+    frame.seq = msg.frame_seq;
+    
+    // One extra reference until every part is posted, so a panel finishing
+    // early cannot complete the frame
+    portENTER_CRITICAL(&frame_queue_lock);
+    canvas_pending[idx] = 1;
+    canvas_frame_bytes = 0;
+    canvas_frame_sprite_us = 0;
+    portEXIT_CRITICAL(&frame_queue_lock);
+    
+    for (int i = -1; i < (int)canvas_panel_count; i++) {
+        TFT7735V* target = (i < 0) ? this : canvas_panels[i].panel;
+        int32_t ox = (i < 0) ? 0 : canvas_panels[i].x;
+        int32_t oy = (i < 0) ? 0 : canvas_panels[i].y;
+        int32_t pw = (i < 0) ? panel_w : target->width;
+        int32_t ph = (i < 0) ? panel_h : target->height;
+        int32_t x0 = std::max<int32_t>(rect.x, ox), y0 = std::max<int32_t>(rect.y, oy);
+        int32_t x1 = std::min<int32_t>(rect.x + rect.w, ox + pw);
+        int32_t y1 = std::min<int32_t>(rect.y + rect.h, oy + ph);
+        if (x0 >= x1 || y0 >= y1) continue;
+        
+        tft_queued_frame_t part = frame;
+        part.use_dirty_rect = true;
+        part.rect = { (uint16_t)(x0 - ox), (uint16_t)(y0 - oy), (uint16_t)(x1 - x0), (uint16_t)(y1 - y0), true };
+        portENTER_CRITICAL(&frame_queue_lock);
+        canvas_pending[idx]++;
+        portEXIT_CRITICAL(&frame_queue_lock);
+        if (!target->post_first_chunk(part)) {
+            portENTER_CRITICAL(&frame_queue_lock);
+            canvas_pending[idx]--;
+            portEXIT_CRITICAL(&frame_queue_lock);
+        }
     }
     
-    ESP_LOGD(TAG, "Display operation started with buffer %d", transfer_buffer_idx);
+    canvas_part_done(idx, frame.seq, 0, 0);
+}
+
+// One panel finished its part of a canvas frame; the last one completes it
+void TFT7735V::canvas_part_done(uint8_t buffer_idx, uint32_t seq, uint32_t bytes, uint32_t sprite_us) {
+    portENTER_CRITICAL(&frame_queue_lock);
+    canvas_frame_bytes += bytes;
+    canvas_frame_sprite_us += sprite_us;
+    bool last = --canvas_pending[buffer_idx] == 0;
+    portEXIT_CRITICAL(&frame_queue_lock);
+    if (!last) return;
+    
+    record_frame_stats(buffer_idx, canvas_frame_bytes, canvas_frame_sprite_us);
+    frame_finished(buffer_idx, seq);
+}
+
+// Idle buffer to render into, 255 if none. Call under frame_queue_lock.
+uint8_t TFT7735V::find_idle_buffer() {
+    for (uint8_t i = 0; i < framebuffer_count; i++) {
+        if (buffer_states[i] == BUFFER_STATE_IDLE) return i;
+    }
+    return 255;
 }
 
 // Framebuffer drawing functions
 void TFT7735V::fb_draw_pixel(uint16_t x, uint16_t y, uint16_t color) {
-    if (x >= width || y >= height || current_framebuffer == nullptr) {
+    if (x < fb_x || y < fb_y || x >= fb_x + fb_w || y >= fb_y + fb_h || current_framebuffer == nullptr) {
         return;
     }
     
-    current_framebuffer[y * width + x] = color;
+    materialize_render(x, y, 1, 1);
+    current_framebuffer[fb_offset(x, y)] = color;
     
     // Track dirty rectangle
     expand_dirty_rect(x, y, 1, 1);
@@ -1219,6 +3832,16 @@ void TFT7735V::fb_draw_pixel(uint16_t x, uint16_t y, uint16_t color) {
 void TFT7735V::fb_fill_screen(uint16_t color) {
     if (current_framebuffer == nullptr) return;
     
+    if (lazy_clear_enabled && tile_lazy[render_buffer_idx] != nullptr) {
+        // O(tiles): only flag the tiles
+        uint16_t tiles = tiles_x * tiles_y;
+        memset(tile_lazy[render_buffer_idx], 1, tiles);
+        std::fill(tile_color[render_buffer_idx], tile_color[render_buffer_idx] + tiles, color);
+        lazy_tile_count[render_buffer_idx] = tiles;
+        expand_dirty_rect(0, 0, width, height);
+        return;
+    }
+    
     for (size_t i = 0; i < (width * height); i++) {
         current_framebuffer[i] = color;
     }
@@ -1229,20 +3852,55 @@ void TFT7735V::fb_fill_screen(uint16_t color) {
 
 void TFT7735V::fb_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
     if (current_framebuffer == nullptr) return;
-    if (x >= width || y >= height) return;
     
-    // Clip rectangle to screen bounds
-    if (x + w > width) w = width - x;
-    if (y + h > height) h = height - y;
+    // Clip rectangle to the framebuffer (screen bounds without a window)
+    int32_t x0 = std::max<int32_t>(fb_x, x), y0 = std::max<int32_t>(fb_y, y);
+    int32_t x1 = std::min<int32_t>(fb_x + fb_w, x + w), y1 = std::min<int32_t>(fb_y + fb_h, y + h);
+    if (x0 >= x1 || y0 >= y1) return;
     
-    for (uint16_t row = y; row < y + h; row++) {
-        for (uint16_t col = x; col < x + w; col++) {
-            current_framebuffer[row * width + col] = color;
-        }
-    }
+    fb_fill_rect_raw(x0, y0, x1 - x0, y1 - y0, color);
     
     // Track dirty rectangle
-    expand_dirty_rect(x, y, w, h);
+    expand_dirty_rect(x0, y0, x1 - x0, y1 - y0);
+}
+
+// Fill an already clipped rectangle, no damage tracking
+void TFT7735V::fb_fill_rect_raw(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {    
+    if (lazy_clear_enabled && tile_lazy[render_buffer_idx] != nullptr) {
+        // Tiles covered completely just take the new color lazily
+        uint8_t b = render_buffer_idx;
+        for (uint16_t ty = y >> TFT_TILE_SHIFT; ty <= (y + h - 1) >> TFT_TILE_SHIFT; ty++) {
+            for (uint16_t tx = x >> TFT_TILE_SHIFT; tx <= (x + w - 1) >> TFT_TILE_SHIFT; tx++) {
+                uint16_t t = ty * tiles_x + tx;
+                uint16_t tile_x0 = tx << TFT_TILE_SHIFT, tile_y0 = ty << TFT_TILE_SHIFT;
+                uint16_t tile_x1 = std::min<uint16_t>(width, tile_x0 + TFT_TILE_SIZE);
+                uint16_t tile_y1 = std::min<uint16_t>(height, tile_y0 + TFT_TILE_SIZE);
+                uint16_t ix0 = std::max(x, tile_x0), iy0 = std::max(y, tile_y0);
+                uint16_t ix1 = std::min<uint16_t>(x + w, tile_x1), iy1 = std::min<uint16_t>(y + h, tile_y1);
+                
+                if (ix0 == tile_x0 && iy0 == tile_y0 && ix1 == tile_x1 && iy1 == tile_y1) {
+                    if (!tile_lazy[b][t]) {
+                        tile_lazy[b][t] = 1;
+                        lazy_tile_count[b]++;
+                    }
+                    tile_color[b][t] = color;
+                    continue;
+                }
+                
+                materialize_tiles(b, ix0, iy0, ix1 - ix0, iy1 - iy0);
+                for (uint16_t row = iy0; row < iy1; row++) {
+                    std::fill(current_framebuffer + row * width + ix0, current_framebuffer + row * width + ix1, color);
+                }
+            }
+        }
+    } else {
+        for (uint16_t row = y; row < y + h; row++) {
+            uint16_t* p = current_framebuffer + fb_offset(x, row);
+            for (uint16_t col = 0; col < w; col++) {
+                p[col] = color;
+            }
+        }
+    }
 }
 
 void TFT7735V::fb_draw_fast_hline(uint16_t x, uint16_t y, uint16_t w, uint16_t color) {
@@ -1271,6 +3929,7 @@ void TFT7735V::fb_draw_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
     
     while (true) {
         if (x0 < width && y0 < height) {
+            materialize_render(x0, y0, 1, 1);
             current_framebuffer[y0 * width + x0] = color;
         }
         
@@ -1307,6 +3966,7 @@ void TFT7735V::fb_draw_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint
 
 void TFT7735V::fb_draw_circle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color) {
     if (current_framebuffer == nullptr) return;
+    materialize_render(x0 - r, y0 - r, 2 * r + 1, 2 * r + 1);
     
     // Bresenham circle algorithm
     int16_t x = r;
@@ -1344,6 +4004,7 @@ void TFT7735V::fb_draw_circle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t col
 
 void TFT7735V::fb_fill_circle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color) {
     if (current_framebuffer == nullptr) return;
+    materialize_render(x0 - r, y0 - r, 2 * r + 1, 2 * r + 1);
     
     // Filled circle using horizontal lines
     int16_t x = r;
@@ -1402,59 +4063,96 @@ void TFT7735V::fb_fill_circle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t col
     expand_dirty_rect(circle_x, circle_y, circle_w, circle_h);
 }
 
-void TFT7735V::fb_draw_bitmap(uint16_t x, uint16_t y, const uint8_t *bitmap, uint16_t w, uint16_t h, uint16_t color, uint16_t bg, bool has_bg) {
-    if (current_framebuffer == nullptr || bitmap == nullptr) return;
-    
-    for (uint16_t row = 0; row < h; row++) {
-        if (y + row >= height) break;
+// Expand one row of a 1bpp source, 8 pixels per byte: whole bytes become
+// span fills or skips, mixed bytes are drawn from the run LUT
+static void expand_1bpp_row(uint16_t* dst, const uint8_t* src, uint16_t w, uint16_t color,
+                            uint16_t bg, bool has_bg, const tft_bit_runs_t* lut) {
+    for (uint16_t x = 0; x < w; x += 8, src++) {
+        uint8_t bits = *src;
+        uint8_t n = (w - x < 8) ? w - x : 8;
+        uint16_t* d = dst + x;
         
-        for (uint16_t col = 0; col < w; col++) {
-            if (x + col >= width) break;
-            
-            uint16_t byte_idx = (row * ((w + 7) / 8)) + (col / 8);
-            uint8_t bit_idx = 7 - (col % 8);
-            bool pixel_set = bitmap[byte_idx] & (1 << bit_idx);
-            
-            if (pixel_set) {
-                current_framebuffer[(y + row) * width + (x + col)] = color;
-            } else if (has_bg) {
-                current_framebuffer[(y + row) * width + (x + col)] = bg;
-            }
+        if (bits == 0x00) {
+            if (has_bg) std::fill(d, d + n, bg);
+            continue;
+        }
+        if (bits == 0xFF) {
+            std::fill(d, d + n, color);
+            continue;
+        }
+        
+        if (has_bg) std::fill(d, d + n, bg);
+        const tft_bit_runs_t& r = lut[bits];
+        for (uint8_t i = 0; i < r.count; i++) {
+            uint8_t start = TFT_RUN_START(r.runs[i]);
+            if (start >= n) break;
+            uint8_t len = std::min<uint8_t>(TFT_RUN_LEN(r.runs[i]), n - start);
+            std::fill(d + start, d + start + len, color);
         }
     }
+}
+
+// Copy the pixels of one row whose mask bit (MSB first) is set
+static void mask_copy_row(uint16_t* dst, const uint16_t* src, const uint8_t* mask, uint16_t w) {
+    for (uint16_t x = 0; x < w; x += 8, mask++) {
+        uint8_t bits = *mask;
+        if (bits == 0x00) continue;
+        
+        uint8_t n = (w - x < 8) ? w - x : 8;
+        if (bits == 0xFF) {
+            memcpy(dst + x, src + x, n * sizeof(uint16_t));
+            continue;
+        }
+        
+        const tft_bit_runs_t& r = tft_bit_runs_msb[bits];
+        for (uint8_t i = 0; i < r.count; i++) {
+            uint8_t start = TFT_RUN_START(r.runs[i]);
+            if (start >= n) break;
+            uint8_t len = std::min<uint8_t>(TFT_RUN_LEN(r.runs[i]), n - start);
+            memcpy(dst + x + start, src + x + start, len * sizeof(uint16_t));
+        }
+    }
+}
+
+void TFT7735V::fb_draw_bitmap(uint16_t x, uint16_t y, const uint8_t *bitmap, uint16_t w, uint16_t h, uint16_t color, uint16_t bg, bool has_bg) {
+    if (current_framebuffer == nullptr || bitmap == nullptr) return;
+    if (x >= width || y >= height || w == 0 || h == 0) return;
+    materialize_render(x, y, w, h);
     
-    // Track dirty rectangle
     uint16_t clipped_w = (x + w > width) ? width - x : w;
     uint16_t clipped_h = (y + h > height) ? height - y : h;
+    uint16_t stride = (w + 7) / 8;
+    
+    for (uint16_t row = 0; row < clipped_h; row++) {
+        expand_1bpp_row(current_framebuffer + (y + row) * width + x, bitmap + row * stride,
+                        clipped_w, color, bg, has_bg, tft_bit_runs_msb);
+    }
+    
+    // Track dirty rectangle
     expand_dirty_rect(x, y, clipped_w, clipped_h);
 }
 
 void TFT7735V::fb_draw_rgb_bitmap(uint16_t x, uint16_t y, const uint16_t *bitmap, const uint8_t *mask, uint16_t w, uint16_t h, bool has_mask) {
     if (current_framebuffer == nullptr || bitmap == nullptr) return;
+    if (x >= width || y >= height || w == 0 || h == 0) return;
+    materialize_render(x, y, w, h);
     
-    for (uint16_t row = 0; row < h; row++) {
-        if (y + row >= height) break;
-        
-        for (uint16_t col = 0; col < w; col++) {
-            if (x + col >= width) break;
-            
-            bool draw_pixel = true;
-            if (has_mask && mask != nullptr) {
-                uint16_t mask_byte_idx = (row * ((w + 7) / 8)) + (col / 8);
-                uint8_t mask_bit_idx = 7 - (col % 8);
-                draw_pixel = mask[mask_byte_idx] & (1 << mask_bit_idx);
-            }
-            
-            if (draw_pixel) {
-                uint16_t pixel_color = bitmap[row * w + col];
-                current_framebuffer[(y + row) * width + (x + col)] = pixel_color;
-            }
+    uint16_t clipped_w = (x + w > width) ? width - x : w;
+    uint16_t clipped_h = (y + h > height) ? height - y : h;
+    
+    if (has_mask && mask != nullptr) {
+        uint16_t mask_stride = (w + 7) / 8;
+        for (uint16_t row = 0; row < clipped_h; row++) {
+            mask_copy_row(current_framebuffer + (y + row) * width + x, bitmap + row * w,
+                          mask + row * mask_stride, clipped_w);
+        }
+    } else {
+        for (uint16_t row = 0; row < clipped_h; row++) {
+            memcpy(current_framebuffer + (y + row) * width + x, bitmap + row * w, clipped_w * sizeof(uint16_t));
         }
     }
     
     // Track dirty rectangle
-    uint16_t clipped_w = (x + w > width) ? width - x : w;
-    uint16_t clipped_h = (y + h > height) ? height - y : h;
     expand_dirty_rect(x, y, clipped_w, clipped_h);
 }
 
@@ -1462,7 +4160,7 @@ void TFT7735V::fb_draw_char(uint16_t x, uint16_t y, unsigned char c, uint16_t co
     if (current_framebuffer == nullptr) return;
     
     // Bounds checking
-    if (x >= width || y >= height) return;
+    if (x >= width || y >= height || size == 0) return;
     
     // Character validation
     if (c < FONT8X8_FIRST_CHAR || c > FONT8X8_LAST_CHAR) {
@@ -1470,35 +4168,30 @@ void TFT7735V::fb_draw_char(uint16_t x, uint16_t y, unsigned char c, uint16_t co
     }
     
     const uint8_t* char_data = font8x8_basic[c - FONT8X8_FIRST_CHAR];
-      // Draw character bitmap with scaling
-    for (int8_t row = 0; row < FONT8X8_HEIGHT; row++) {
-        uint8_t line = char_data[row];
-        for (int8_t col = 0; col < FONT8X8_WIDTH; col++) {
-            bool pixel_set = line & (0x01 << col);
-            
-            // Draw scaled pixel
-            for (uint8_t sy = 0; sy < size; sy++) {
-                for (uint8_t sx = 0; sx < size; sx++) {
-                    uint16_t px = x + col * size + sx;
-                    uint16_t py = y + row * size + sy;
-                    
-                    if (px < width && py < height) {
-                        if (pixel_set) {
-                            current_framebuffer[py * width + px] = color;
-                        } else if (has_bg) {
-                            current_framebuffer[py * width + px] = bg;
-                        }
-                    }
-                }
-            }
-        }
-    }
+    materialize_render(x, y, FONT8X8_WIDTH * size, FONT8X8_HEIGHT * size);
     
-    // Track dirty rectangle
     uint16_t char_width = FONT8X8_WIDTH * size;
     uint16_t char_height = FONT8X8_HEIGHT * size;
     uint16_t clipped_w = (x + char_width > width) ? width - x : char_width;
     uint16_t clipped_h = (y + char_height > height) ? height - y : char_height;
+    
+    // Font rows are LSB = left pixel; runs are scaled by size
+    for (uint16_t py = 0; py < clipped_h; py++) {
+        const tft_bit_runs_t& r = tft_bit_runs_lsb[char_data[py / size]];
+        uint16_t* dst = current_framebuffer + (y + py) * width + x;
+        
+        if (has_bg) {
+            std::fill(dst, dst + clipped_w, bg);
+        }
+        for (uint8_t i = 0; i < r.count; i++) {
+            uint16_t start = TFT_RUN_START(r.runs[i]) * size;
+            if (start >= clipped_w) break;
+            uint16_t end = std::min<uint16_t>(clipped_w, start + TFT_RUN_LEN(r.runs[i]) * size);
+            std::fill(dst + start, dst + end, color);
+        }
+    }
+    
+    // Track dirty rectangle
     expand_dirty_rect(x, y, clipped_w, clipped_h);
 }
 
@@ -1510,13 +4203,13 @@ bool TFT7735V::init_double_buffering() {
     }
     
     // Allocate SRAM buffers (8KB each)
-    sram_buffer_a = (uint16_t*)heap_caps_malloc(SRAM_BUFFER_SIZE, MALLOC_CAP_INTERNAL);
+    sram_buffer_a = (uint16_t*)heap_caps_malloc(SRAM_BUFFER_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
     if (sram_buffer_a == nullptr) {
         ESP_LOGE(TAG, "Failed to allocate SRAM buffer A (%d bytes)", SRAM_BUFFER_SIZE);
         return false;
     }
     
-    sram_buffer_b = (uint16_t*)heap_caps_malloc(SRAM_BUFFER_SIZE, MALLOC_CAP_INTERNAL);
+    sram_buffer_b = (uint16_t*)heap_caps_malloc(SRAM_BUFFER_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
     if (sram_buffer_b == nullptr) {
         ESP_LOGE(TAG, "Failed to allocate SRAM buffer B (%d bytes)", SRAM_BUFFER_SIZE);
         heap_caps_free(sram_buffer_a);
@@ -1548,10 +4241,27 @@ bool TFT7735V::init_double_buffering() {
         return false;
     }
     
+    // Signalled whenever a queued frame's buffer becomes free
+    buffer_free_semaphore = xSemaphoreCreateBinary();
+    if (buffer_free_semaphore == nullptr) {
+        ESP_LOGE(TAG, "Failed to create buffer free semaphore");
+        vSemaphoreDelete(display_done_semaphore);
+        vQueueDelete(display_queue);
+        heap_caps_free(sram_buffer_a);
+        heap_caps_free(sram_buffer_b);
+        sram_buffer_a = nullptr;
+        sram_buffer_b = nullptr;
+        display_queue = nullptr;
+        display_done_semaphore = nullptr;
+        return false;
+    }
+    
     // Create display task
     BaseType_t ret = xTaskCreate(display_task, "display_task", 4096, this, 5, &display_task_handle);
     if (ret != pdPASS) {
         ESP_LOGE(TAG, "Failed to create display task");
+        vSemaphoreDelete(buffer_free_semaphore);
+        buffer_free_semaphore = nullptr;
         vSemaphoreDelete(display_done_semaphore);
         vQueueDelete(display_queue);
         heap_caps_free(sram_buffer_a);
@@ -1574,7 +4284,7 @@ bool TFT7735V::init_double_buffering() {
     
     ESP_LOGI(TAG, "Double buffering initialized: SRAM buffers %d bytes each, %d chunks per frame", 
              SRAM_BUFFER_SIZE, total_chunks);
-    ESP_LOGI(TAG, "Chunk height: %d pixels, Total chunks: %d", CHUNK_HEIGHT, total_chunks);
+    ESP_LOGI(TAG, "Chunk height: %d pixels, Total chunks: %d", chunk_height, total_chunks);
     
     return true;
 }
@@ -1597,6 +4307,11 @@ void TFT7735V::free_double_buffering() {
         display_done_semaphore = nullptr;
     }
     
+    if (buffer_free_semaphore != nullptr) {
+        vSemaphoreDelete(buffer_free_semaphore);
+        buffer_free_semaphore = nullptr;
+    }
+    
     if (display_queue != nullptr) {
         vQueueDelete(display_queue);
         display_queue = nullptr;
@@ -1615,6 +4330,8 @@ void TFT7735V::free_double_buffering() {
     current_sram_buffer = nullptr;
     display_in_progress = false;
     display_done_flag = true;
+    frame_queue_count = 0;
+    transfer_active = false;
     
     ESP_LOGI(TAG, "Double buffering freed");
 }
@@ -1631,25 +4348,29 @@ void TFT7735V::display_task(void* pvParameters) {
             ESP_LOGD(TAG, "Processing chunk %d from buffer %d, last=%d, dirty=%d", 
                      msg.chunk_idx, msg.source_buffer_idx, msg.is_last_chunk, msg.use_dirty_rect);
             
-            // Process the chunk from the specified source buffer
-            if (msg.use_dirty_rect && msg.dirty_rect.valid) {
-                tft->copy_dirty_chunk_and_send(msg.chunk_idx, msg.source_buffer_idx, msg.dirty_rect);
-            } else {
-                tft->copy_chunk_and_send(msg.chunk_idx, msg.source_buffer_idx);
+            if (msg.canvas_start) {
+                tft->start_canvas_frame(msg);
+                continue;
+            }
+            if (msg.is_first_chunk) tft->begin_frame_transfer(msg.source_buffer_idx);
+            
+            // Process the chunk from the specified source buffer. Direct
+            // drawing outside a framebuffer window goes between chunks.
+            {
+                gram_scope gram(tft);
+                tft->bus_acquire();
+                if (msg.use_dirty_rect && msg.dirty_rect.valid) {
+                    tft->copy_dirty_chunk_and_send(msg.chunk_idx, msg.source_buffer_idx, msg.dirty_rect);
+                } else {
+                    tft->copy_chunk_and_send(msg.chunk_idx, msg.source_buffer_idx);
+                }
+                tft->bus_chunk_done();
+                if (tft->fb_window) tft->bus_release();
             }
             
             if (msg.is_last_chunk) {
-                // Mark source buffer as idle now that transfer is complete
-                tft->buffer_states[msg.source_buffer_idx] = BUFFER_STATE_IDLE;
-                
-                // Clear dirty rectangle after successful transfer
-                tft->clearDirty();
-                
-                // Mark display as completed
-                tft->display_in_progress = false;
-                tft->display_done_flag = true;
-                xSemaphoreGive(tft->display_done_semaphore);
-                ESP_LOGI(TAG, "Display operation completed, buffer %d now idle", msg.source_buffer_idx);            } else {
+                tft->complete_display(msg.source_buffer_idx, msg.frame_seq);
+            } else {
                 // Calculate next chunk for dirty rect mode
                 uint8_t next_chunk_idx;
                 bool is_last;
@@ -1670,58 +4391,157 @@ void TFT7735V::display_task(void* pvParameters) {
                     // Send next chunk message
                     display_message_t next_msg = {
                         .chunk_idx = next_chunk_idx,
+                        .is_first_chunk = false,
                         .is_last_chunk = is_last,
                         .source_buffer_idx = msg.source_buffer_idx,
+                        .frame_seq = msg.frame_seq,
                         .use_dirty_rect = msg.use_dirty_rect,
-                        .dirty_rect = msg.dirty_rect
+                        .dirty_rect = msg.dirty_rect,
+                        .canvas_start = false
                     };
                     
                     if (xQueueSend(tft->display_queue, &next_msg, 0) != pdTRUE) {
                         ESP_LOGE(TAG, "Failed to send next chunk message");
                         // Mark buffer as idle on error
-                        tft->buffer_states[msg.source_buffer_idx] = BUFFER_STATE_IDLE;
-                        tft->display_in_progress = false;
-                        tft->display_done_flag = true;
-                        xSemaphoreGive(tft->display_done_semaphore);
+                        tft->complete_display(msg.source_buffer_idx, msg.frame_seq);
                     }
                 } else {
                     // This was actually the last chunk
-                    tft->buffer_states[msg.source_buffer_idx] = BUFFER_STATE_IDLE;
-                    tft->clearDirty();
-                    tft->display_in_progress = false;
-                    tft->display_done_flag = true;
-                    xSemaphoreGive(tft->display_done_semaphore);
-                    ESP_LOGI(TAG, "Display operation completed, buffer %d now idle", msg.source_buffer_idx);
+                    tft->complete_display(msg.source_buffer_idx, msg.frame_seq);
                 }
             }
         }
     }
 }
 
+// First chunk of a frame: per-transfer counters. Canvas parts do not start
+// the frame; the master did that in start_canvas_frame().
+void TFT7735V::begin_frame_transfer(uint8_t source_buffer_idx) {
+    frame_bytes = 0;
+    current_chunk = 0;
+    frame_bus_wait_us = 0;
+    frame_scan_wait_us = 0;
+    frame_sprite_us = 0;
+    if (canvas_master == nullptr && canvas_panel_count == 0) {
+        start_frame(source_buffer_idx);
+    }
+}
+
+// Frame start on the panel that owns the queue: optional pacing, buffer
+// state, frame timing and queue statistics
+void TFT7735V::start_frame(uint8_t source_buffer_idx) {
+    if (frame_interval_us != 0 && last_transfer_start_us != 0) {
+        int64_t wait_us = last_transfer_start_us + frame_interval_us - esp_timer_get_time();
+        if (wait_us >= 1000) vTaskDelay(pdMS_TO_TICKS(wait_us / 1000));
+    }
+    
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&frame_queue_lock);
+    int64_t queued_us = frame_queue[frame_queue_head].queued_us;
+    buffer_states[source_buffer_idx] = BUFFER_STATE_TRANSFERRING;
+    transfer_buffer_idx = source_buffer_idx;
+    portEXIT_CRITICAL(&frame_queue_lock);
+    
+    last_transfer_start_us = now;
+    frame_start_us = now;
+    
+    uint32_t queue_us = (uint32_t)(now - queued_us);
+    frame_stats.queue_us = queue_us;
+    if (queue_us > frame_stats.max_queue_us) frame_stats.max_queue_us = queue_us;
+}
+
+void TFT7735V::complete_display(uint8_t source_buffer_idx, uint32_t seq) {
+    // Queued color transfers still read from the SRAM buffers. Direct
+    // writes outside a framebuffer window share the count, so drain it
+    // under the GRAM lock like the chunks themselves.
+    {
+        gram_scope gram(this);
+        wait_transfers(0);
+        bus_release();
+    }
+    
+    if (canvas_master != nullptr) {
+        canvas_master->canvas_part_done(source_buffer_idx, seq, frame_bytes, frame_sprite_us);
+        return;
+    }
+    if (canvas_panel_count != 0) {
+        canvas_part_done(source_buffer_idx, seq, frame_bytes, frame_sprite_us);
+        return;
+    }
+    record_frame_stats(source_buffer_idx, frame_bytes, frame_sprite_us);
+    frame_finished(source_buffer_idx, seq);
+}
+
+void TFT7735V::record_frame_stats(uint8_t source_buffer_idx, uint32_t bytes, uint32_t sprite_us) {
+    uint32_t frame_us = (uint32_t)(esp_timer_get_time() - frame_start_us);
+    uint32_t prev_frame_us = frame_stats.last_frame_us;
+    frame_stats.frames++;
+    frame_stats.last_frame_us = frame_us;
+    frame_stats.last_frame_bytes = bytes;
+    frame_stats.total_frame_us += frame_us;
+    if (frame_us < frame_stats.min_frame_us) frame_stats.min_frame_us = frame_us;
+    if (frame_us > frame_stats.max_frame_us) frame_stats.max_frame_us = frame_us;
+    if (frame_stats.frames > 1) {
+        int32_t delta = (int32_t)frame_us - (int32_t)prev_frame_us;
+        int32_t abs_delta = (delta < 0) ? -delta : delta;
+        frame_stats.jitter_us += (abs_delta - (int32_t)frame_stats.jitter_us) / 16;
+    }
+    frame_stats.bus_wait_us = frame_bus_wait_us;
+    frame_stats.sprite_us = sprite_us;
+    frame_stats.sprite_count = sprite_snapshots[source_buffer_idx].sprites.size();
+    if (frame_bus_wait_us > frame_stats.max_bus_wait_us) frame_stats.max_bus_wait_us = frame_bus_wait_us;
+    frame_stats.scan_wait_us = frame_scan_wait_us;
+    if (frame_scan_wait_us > frame_stats.max_scan_wait_us) frame_stats.max_scan_wait_us = frame_scan_wait_us;
+    
+    ESP_LOGI(TAG, "Display operation completed in %lu us, buffer %d now idle", frame_us, source_buffer_idx);
+}
+
+// Frees the buffer of the frame at the queue head and starts the next one
+void TFT7735V::frame_finished(uint8_t source_buffer_idx, uint32_t seq) {
+    while (true) {
+        tft_queued_frame_t next;
+        portENTER_CRITICAL(&frame_queue_lock);
+        buffer_states[source_buffer_idx] = BUFFER_STATE_IDLE;
+        if (frame_queue_count > 0) {
+            frame_queue_head = (frame_queue_head + 1) % TFT_MAX_FRAMEBUFFERS;
+            frame_queue_count--;
+        }
+        bool more = frame_queue_count > 0;
+        // Before the drain is signalled, so waitForDisplayDone() sees it
+        frame_seq_done = seq;
+        if (more) {
+            next = frame_queue[frame_queue_head];
+        } else {
+            transfer_active = false;
+            display_in_progress = false;
+            display_done_flag = true;
+        }
+        portEXIT_CRITICAL(&frame_queue_lock);
+        
+        xSemaphoreGive(buffer_free_semaphore);
+        if (!more) xSemaphoreGive(display_done_semaphore);
+        if (frame_done_cb != nullptr) frame_done_cb(seq, frame_done_user);
+        
+        if (!more || send_first_chunk(next)) return;
+        // Could not start it: drop it as well
+        source_buffer_idx = next.buffer_idx;
+        seq = next.seq;
+    }
+}
+
 void TFT7735V::copy_chunk_and_send(uint8_t chunk_idx, uint8_t source_buffer_idx) {
     if (!initialized) {
         return;
     }
     
-    // Get source framebuffer based on buffer index
-    uint16_t* source_framebuffer = nullptr;
-    switch (source_buffer_idx) {
-        case 0: source_framebuffer = framebuffer_a; break;
-        case 1: source_framebuffer = framebuffer_b; break;
-        case 2: source_framebuffer = framebuffer_c; break;
-        default:
-            ESP_LOGE(TAG, "Invalid source buffer index: %d", source_buffer_idx);
-            return;
-    }
-    
-    if (source_framebuffer == nullptr) {
+    if (source_framebuffer(source_buffer_idx) == nullptr) {
         ESP_LOGE(TAG, "Source framebuffer %d is null", source_buffer_idx);
         return;
     }
     
     // Calculate chunk dimensions
-    uint16_t chunk_start_y = chunk_idx * CHUNK_HEIGHT;
-    uint16_t chunk_end_y = (chunk_idx + 1) * CHUNK_HEIGHT;
+    uint16_t chunk_start_y = chunk_idx * chunk_height;
+    uint16_t chunk_end_y = (chunk_idx + 1) * chunk_height;
     if (chunk_end_y > height) {
         chunk_end_y = height;
     }
@@ -1731,65 +4551,303 @@ void TFT7735V::copy_chunk_and_send(uint8_t chunk_idx, uint8_t source_buffer_idx)
     ESP_LOGD(TAG, "Processing chunk %d from buffer %d: y=%d-%d, height=%d", 
              chunk_idx, source_buffer_idx, chunk_start_y, chunk_end_y, actual_chunk_height);
     
-    // Use alternating SRAM buffers for double buffering
-    uint16_t* target_buffer = (chunk_idx % 2 == 0) ? sram_buffer_a : sram_buffer_b;
-    
-    // Copy chunk from PSRAM framebuffer to SRAM buffer
-    uint16_t* src = source_framebuffer + (chunk_start_y * width);
-    size_t chunk_size_pixels = width * actual_chunk_height;
-    
-    // Fast memcpy from PSRAM to SRAM
-    memcpy(target_buffer, src, chunk_size_pixels * sizeof(uint16_t));
-    
-    // Send to display
-    send_chunk_to_display(target_buffer, chunk_idx, actual_chunk_height);
+    // Copy chunk from PSRAM framebuffer to SRAM buffer in wire format and send
+    stage_and_send(source_buffer_idx, 0, chunk_start_y, width, actual_chunk_height);
 }
 
-void TFT7735V::send_chunk_to_display(uint16_t* buffer, uint16_t chunk_idx, uint16_t chunk_height) {
-    if (!initialized || buffer == nullptr) {
+// Next SRAM buffer for staging. The buffers alternate, so with queued
+// transfers only the one before the previous must have finished.
+uint16_t* TFT7735V::acquire_sram_buffer() {
+    current_sram_buffer = (current_sram_buffer == sram_buffer_a) ? sram_buffer_b : sram_buffer_a;
+    wait_transfers(1);
+    return current_sram_buffer;
+}
+
+// Corrected, byte-swapped pixel from the pre-swapped channel tables
+static inline uint16_t lut_pixel(const uint16_t* lut, uint16_t c) {
+    return lut[c >> 11] | lut[32 + ((c >> 5) & 0x3F)] | lut[96 + (c & 0x1F)];
+}
+
+// Framebuffer window into an SRAM buffer, packed but still native
+// (lazy tiles expanded), for composing before encode_pixels()
+void TFT7735V::copy_rows_native(uint8_t idx, uint16_t x, uint16_t y, uint16_t w, uint16_t rows, uint16_t* dst) {
+    const uint16_t* src_fb = framebuffers[idx];
+    const uint8_t* lazy = (lazy_tile_count[idx] != 0) ? tile_lazy[idx] : nullptr;
+    for (uint16_t row = 0; row < rows; row++, dst += w) {
+        uint16_t py = y + row;
+        const uint16_t* src = src_fb + fb_offset(x, py);
+        if (lazy == nullptr) {
+            memcpy(dst, src, w * sizeof(uint16_t));
+            continue;
+        }
+        uint16_t tile_row = (py >> TFT_TILE_SHIFT) * tiles_x;
+        uint16_t col = x;
+        while (col < x + w) {
+            uint16_t t = tile_row + (col >> TFT_TILE_SHIFT);
+            uint16_t end = std::min<uint16_t>(x + w, ((col >> TFT_TILE_SHIFT) + 1) << TFT_TILE_SHIFT);
+            if (lazy[t]) {
+                std::fill(dst + (col - x), dst + (end - x), tile_color[idx][t]);
+            } else {
+                memcpy(dst + (col - x), src + (col - x), (end - col) * sizeof(uint16_t));
+            }
+            col = end;
+        }
+    }
+}
+
+// Native pixels to wire format in place (LUT or byte swap)
+void TFT7735V::encode_pixels(uint16_t* pixels, uint32_t count) {
+    if (color_lut_enabled) {
+        for (uint32_t i = 0; i < count; i++) pixels[i] = lut_pixel(color_lut, pixels[i]);
         return;
     }
+    uint32_t i = 0;
+    if (((uintptr_t)pixels & 3) == 0) {
+        uint32_t* p32 = (uint32_t*)pixels;
+        for (; i + 1 < count; i += 2, p32++) {
+            uint32_t v = *p32;
+            *p32 = ((v & 0x00FF00FF) << 8) | ((v >> 8) & 0x00FF00FF);
+        }
+    }
+    for (; i < count; i++) pixels[i] = __builtin_bswap16(pixels[i]);
+}
+
+// Copy a window of the PSRAM framebuffer into an SRAM buffer, packed
+// (w pixels per row) in the panel's big-endian format: byte-swapped, or
+// through the color LUT, whose channel tables are pre-swapped. Returns the
+// time spent composing sprites, for the calling panel's frame statistics.
+uint32_t TFT7735V::stage_rows(uint8_t idx, uint16_t x, uint16_t y, uint16_t w, uint16_t rows, uint16_t* dst) {
+    const sprite_snapshot_t& snap = sprite_snapshots[idx];
+    if (sprites_in_window(snap, x, y, w, rows)) {
+        // Background and sprites are composed here, never in PSRAM
+        int64_t start_us = esp_timer_get_time();
+        copy_rows_native(idx, x, y, w, rows, dst);
+        compose_sprites(snap, x, y, w, rows, dst);
+        encode_pixels(dst, (uint32_t)w * rows);
+        return (uint32_t)(esp_timer_get_time() - start_us);
+    }
     
-    // Calculate chunk position
-    uint16_t chunk_start_y = chunk_idx * CHUNK_HEIGHT;
+    const uint16_t* src_fb = framebuffers[idx];
+    if (lazy_tile_count[idx] != 0) {
+        // Lazily cleared tiles are expanded here instead of read from PSRAM
+        const uint8_t* lazy = tile_lazy[idx];
+        const uint16_t* colors = tile_color[idx];
+        const uint16_t* lut = color_lut_enabled ? color_lut : nullptr;
+        for (uint16_t row = 0; row < rows; row++) {
+            uint16_t py = y + row;
+            uint16_t tile_row = (py >> TFT_TILE_SHIFT) * tiles_x;
+            const uint16_t* src = src_fb + fb_offset(0, py);
+            uint16_t col = x;
+            while (col < x + w) {
+                uint16_t t = tile_row + (col >> TFT_TILE_SHIFT);
+                uint16_t end = std::min<uint16_t>(x + w, ((col >> TFT_TILE_SHIFT) + 1) << TFT_TILE_SHIFT);
+                if (lazy[t]) {
+                    std::fill(dst, dst + (end - col), lut ? lut_pixel(lut, colors[t]) : __builtin_bswap16(colors[t]));
+                    dst += end - col;
+                    col = end;
+                } else if (lut) {
+                    for (; col < end; col++) {
+                        *dst++ = lut_pixel(lut, src[col]);
+                    }
+                } else {
+                    for (; col < end; col++) {
+                        *dst++ = __builtin_bswap16(src[col]);
+                    }
+                }
+            }
+        }
+        return 0;
+    }
     
-    ESP_LOGD(TAG, "Sending chunk %d to display: y=%d, height=%d", 
-             chunk_idx, chunk_start_y, chunk_height);
+    if (color_lut_enabled) {
+        for (uint16_t row = 0; row < rows; row++) {
+            const uint16_t* src = src_fb + fb_offset(x, y + row);
+            for (uint16_t col = 0; col < w; col++) {
+                dst[col] = lut_pixel(color_lut, src[col]);
+            }
+            dst += w;
+        }
+        return 0;
+    }
     
-    // Set address window for this chunk
-    set_addr_window(0, chunk_start_y, width - 1, chunk_start_y + chunk_height - 1);
+    for (uint16_t row = 0; row < rows; row++) {
+        const uint16_t* src = src_fb + fb_offset(x, y + row);
+        uint16_t col = 0;
+        
+        // Swap two pixels per 32-bit word when both sides are aligned
+        if ((((uintptr_t)src | (uintptr_t)dst) & 3) == 0) {
+            const uint32_t* src32 = (const uint32_t*)src;
+            uint32_t* dst32 = (uint32_t*)dst;
+            for (; col + 1 < w; col += 2) {
+                uint32_t v = *src32++;
+                *dst32++ = ((v & 0x00FF00FF) << 8) | ((v >> 8) & 0x00FF00FF);
+            }
+        }
+        for (; col < w; col++) {
+            dst[col] = __builtin_bswap16(src[col]);
+        }
+        dst += w;
+    }
+    return 0;
+}
+
+// Framebuffer a chunk reads from: the master's on a canvas panel
+const uint16_t* TFT7735V::source_framebuffer(uint8_t buffer_idx) const {
+    const TFT7735V* src = (canvas_master != nullptr) ? canvas_master : this;
+    return (buffer_idx < src->framebuffer_count) ? src->framebuffers[buffer_idx] : nullptr;
+}
+
+// Stage a framebuffer window into the next SRAM buffer and send it, scaled
+// to panel coordinates at half resolution
+void TFT7735V::stage_and_send(uint8_t buffer_idx, uint16_t x, uint16_t y, uint16_t w, uint16_t rows) {
+    // Use alternating SRAM buffers for double buffering
+    uint16_t* target_buffer = acquire_sram_buffer();
     
-    // Convert endianness and send via SPI
-    gpio_set_level(dc_pin, 1); // Data mode
+    if (canvas_master != nullptr) {
+        // Canvas panel: the master stages this panel's window of the canvas
+        frame_sprite_us += canvas_master->stage_rows(buffer_idx, x + canvas_x, y + canvas_y, w, rows, target_buffer);
+        send_chunk_to_display(target_buffer, x, y, w, rows);
+        return;
+    }
     
-    size_t total_pixels = width * chunk_height;
-    const size_t spi_chunk_size = 2048; // Pixels per SPI transaction
+    if (res_shift == 0) {
+        frame_sprite_us += stage_rows(buffer_idx, x, y, w, rows, target_buffer);
+        send_chunk_to_display(target_buffer, x, y, w, rows);
+        return;
+    }
     
-    for (size_t pixel_offset = 0; pixel_offset < total_pixels; pixel_offset += spi_chunk_size) {
-        size_t current_pixels = (total_pixels - pixel_offset > spi_chunk_size) ? 
-                               spi_chunk_size : (total_pixels - pixel_offset);
+    // Odd panel sizes drop the last half of the final column / row
+    uint16_t out_x = x << 1;
+    uint16_t out_y = y << 1;
+    uint16_t out_w = std::min<uint16_t>(w << 1, panel_w - out_x);
+    uint16_t out_h = std::min<uint16_t>(rows << 1, panel_h - out_y);
+    stage_rows_half(buffer_idx, x, y, w, rows, out_w, out_h, target_buffer);
+    send_chunk_to_display(target_buffer, out_x, out_y, out_w, out_h);
+}
+
+// One logical row (native, sprites composed) into a half-resolution line buffer
+void TFT7735V::load_half_line(uint8_t buffer_idx, uint16_t x, uint16_t y, uint16_t w, uint16_t* line) {
+    copy_rows_native(buffer_idx, x, y, w, 1, line);
+    const sprite_snapshot_t& snap = sprite_snapshots[buffer_idx];
+    if (sprites_in_window(snap, x, y, w, 1)) {
+        int64_t start_us = esp_timer_get_time();
+        compose_sprites(snap, x, y, w, 1, line);
+        frame_sprite_us += (uint32_t)(esp_timer_get_time() - start_us);
+    }
+}
+
+// Average of two RGB565 pixels, per channel
+static inline uint16_t avg565(uint16_t a, uint16_t b) {
+    return (a & b) + (((a ^ b) & 0xF7DE) >> 1);
+}
+
+// Logical rows y .. y + rows - 1 as out_w x out_h panel pixels in wire format.
+// Smoothing reads one column right and one row below the window (clamped to
+// the frame) so windows match the full-frame result at their edges.
+void TFT7735V::stage_rows_half(uint8_t buffer_idx, uint16_t x, uint16_t y, uint16_t w, uint16_t rows,
+                               uint16_t out_w, uint16_t out_h, uint16_t* dst) {
+    uint16_t span = std::min<uint16_t>(w + 1, width - x);
+    uint16_t* cur = half_lines;
+    uint16_t* next = half_lines + width + 1;
+    load_half_line(buffer_idx, x, y, span, cur);
+    
+    for (uint16_t r = 0; r < rows; r++) {
+        uint16_t out_row = r << 1;
+        uint16_t* out0 = dst + out_row * out_w;
+        uint16_t* out1 = out0 + out_w;
+        bool second = out_row + 1 < out_h;
+        uint16_t below = std::min<uint16_t>(y + r + 1, height - 1);
         
-        // Convert endianness in-place (temporarily)
-        for (size_t i = 0; i < current_pixels; i++) {
-            buffer[pixel_offset + i] = __builtin_bswap16(buffer[pixel_offset + i]);
+        if (!half_res_smooth) {
+            for (uint16_t i = 0, o = 0; o < out_w; i++, o += 2) {
+                out0[o] = cur[i];
+                if (o + 1 < out_w) out0[o + 1] = cur[i];
+            }
+            if (second) memcpy(out1, out0, out_w * sizeof(uint16_t));
+            if (r + 1 < rows) load_half_line(buffer_idx, x, below, span, cur);
+            continue;
         }
         
-        // Send via SPI
-        spi_transaction_t t = {};
-        t.length = current_pixels * 16; // Length in bits
-        t.tx_buffer = &buffer[pixel_offset];
-        
-        esp_err_t ret = spi_device_polling_transmit(spi_device, &t);
-        if (ret != ESP_OK) {
-            ESP_LOGE(TAG, "Failed to transmit chunk %d: %s", chunk_idx, esp_err_to_name(ret));
+        load_half_line(buffer_idx, x, below, span, next);
+        for (uint16_t i = 0, o = 0; o < out_w; i++, o += 2) {
+            uint16_t j = std::min<uint16_t>(i + 1, span - 1);
+            uint16_t top = avg565(cur[i], cur[j]);
+            out0[o] = cur[i];
+            if (o + 1 < out_w) out0[o + 1] = top;
+            if (second) {
+                out1[o] = avg565(cur[i], next[i]);
+                if (o + 1 < out_w) out1[o + 1] = avg565(top, avg565(next[i], next[j]));
+            }
+        }
+        std::swap(cur, next);
+    }
+    encode_pixels(dst, (uint32_t)out_w * out_h);
+}
+
+void TFT7735V::send_chunk_to_display(uint16_t* buffer, uint16_t x, uint16_t y, uint16_t w, uint16_t rows) {
+    if (!initialized || buffer == nullptr) {
+        return;
+    }
+    
+    ESP_LOGD(TAG, "Sending region to display: (%d,%d) %dx%d", x, y, w, rows);
+    
+    if (tear_avoidance && !(rotation & 1) && !partial_mode) {
+        wait_for_scan(y, w, rows);
+    }
+    
+    // Set address window for this region
+    set_addr_window_raw(x, y, x + w - 1, y + rows - 1);
+    
+    // Buffer is already in wire format and fits one transfer
+    size_t bytes = (size_t)w * rows * sizeof(uint16_t);
+    frame_bytes += bytes;
+    write_pixels(buffer, bytes, false);
+}
+
+// Holds the chunk of panel rows y .. y + rows - 1 until writing it cannot
+// cross the estimated scan line
+void TFT7735V::wait_for_scan(uint16_t y, uint16_t w, uint16_t rows) {
+    // The chunk has to reach the wire when scheduled, not behind queued ones
+    wait_transfers(0);
+    
+    tft_scan_model_t model;
+    model.period_us = scan_period_us ? scan_period_us : panel->refresh_us;
+    model.gate_lines = panel->gate_lines;
+    model.porch_lines = panel->porch_lines;
+    model.sync_us = scan_sync_us + scan_phase_us;
+    model.guard_us = TFT_SCAN_GUARD_US;
+    
+    uint16_t first = scan_line(y);
+    uint16_t last = scan_line(y + rows - 1);
+    
+    // Wire time of the pixel data: 8 bits per byte on SPI, one byte per
+    // WR cycle on the parallel bus
+    uint32_t bits = (transport == TFT_TRANSPORT_ESP_LCD_I80) ? 1 : 8;
+    uint32_t write_us = (uint32_t)((uint64_t)w * rows * 2 * bits * 1000000ULL / spi_frequency);
+    
+    // Sleep to the nearest tick and re-plan from wherever the sleep ended;
+    // only the last scan line's worth of waiting is spent spinning
+    int64_t line_us = model.period_us / (model.gate_lines + model.porch_lines);
+    int64_t tick_us = (int64_t)portTICK_PERIOD_MS * 1000;
+    int64_t wait_start = esp_timer_get_time();
+    while (true) {
+        int64_t now = esp_timer_get_time() + TFT_SCAN_SETUP_US;
+        int64_t start = tft_scan_safe_start(&model, first, last, write_us, now);
+        if (start < 0) {
+            frame_stats.scan_misses++;
             return;
         }
-        
-        // Restore original endianness
-        for (size_t i = 0; i < current_pixels; i++) {
-            buffer[pixel_offset + i] = __builtin_bswap16(buffer[pixel_offset + i]);
+        int64_t wait_us = start - now;
+        if (wait_us <= line_us) {
+            int64_t target = start - TFT_SCAN_SETUP_US;
+            while (esp_timer_get_time() < target) {
+            }
+            break;
         }
+        TickType_t ticks = (TickType_t)((wait_us + tick_us / 2) / tick_us);
+        vTaskDelay(ticks ? ticks : 1);
     }
+    frame_scan_wait_us += (uint32_t)(esp_timer_get_time() - wait_start);
 }
 
 // Public methods for display status
@@ -1797,10 +4855,90 @@ bool TFT7735V::displayDone() const {
     return display_done_flag;
 }
 
+uint32_t TFT7735V::frameSequence() const {
+    return frame_seq;
+}
+
+uint32_t TFT7735V::completedFrameSequence() const {
+    return frame_seq_done;
+}
+
+void TFT7735V::setFrameDoneCallback(tft_frame_done_cb_t callback, void* user) {
+    frame_done_cb = callback;
+    frame_done_user = user;
+}
+
+#if TFT_HAS_COROUTINES
+bool TFT7735V::present_ready(void* ctx, uint32_t arg) {
+    (void)arg;
+    TFT7735V* tft = (TFT7735V*)ctx;
+    // Nothing to wait for when display() would refuse anyway
+    if (!tft->initialized || !tft->framebuffer_enabled || tft->current_framebuffer == nullptr) return true;
+    // Ready once display() would not stall on a full queue
+    portENTER_CRITICAL(&tft->frame_queue_lock);
+    bool idle = tft->find_idle_buffer() != 255;
+    portEXIT_CRITICAL(&tft->frame_queue_lock);
+    return idle;
+}
+
+uint32_t TFT7735V::present_submit(void* ctx, uint32_t arg) {
+    (void)arg;
+    TFT7735V* tft = (TFT7735V*)ctx;
+    tft->display();
+    return tft->frame_seq;
+}
+
+bool TFT7735V::frame_done_ready(void* ctx, uint32_t seq) {
+    TFT7735V* tft = (TFT7735V*)ctx;
+    return (int32_t)(tft->frame_seq_done - seq) >= 0;
+}
+
+uint32_t TFT7735V::frame_done_result(void* ctx, uint32_t seq) {
+    (void)seq;
+    return ((TFT7735V*)ctx)->frame_seq_done;
+}
+
+TFTAwait TFT7735V::present() {
+    TFTAwait wait = { present_ready, present_submit, this, 0, -1 };
+    return wait;
+}
+
+TFTAwait TFT7735V::frameDone(uint32_t seq) {
+    TFTAwait wait = { frame_done_ready, frame_done_result, this, seq, -1 };
+    return wait;
+}
+#endif
+
+bool TFT7735V::setFramebufferCount(uint8_t count) {
+    if (count < 2 || count > TFT_MAX_FRAMEBUFFERS) {
+        ESP_LOGE(TAG, "Framebuffer count must be 2..%d", TFT_MAX_FRAMEBUFFERS);
+        return false;
+    }
+    if (framebuffers[0] != nullptr) {
+        ESP_LOGE(TAG, "Disable the framebuffer before changing the buffer count");
+        return false;
+    }
+    framebuffer_count = count;
+    return true;
+}
+
+uint8_t TFT7735V::getFramebufferCount() const {
+    return framebuffer_count;
+}
+
+uint8_t TFT7735V::getQueueDepth() const {
+    return frame_queue_count;
+}
+
+void TFT7735V::setFrameInterval(uint32_t us) {
+    frame_interval_us = us;
+}
+
 void TFT7735V::waitForDisplayDone() {
     if (display_done_semaphore != nullptr && display_in_progress) {
-        ESP_LOGD(TAG, "Waiting for display operation to complete...");
-        xSemaphoreTake(display_done_semaphore, portMAX_DELAY);
+        ESP_LOGD(TAG, "Waiting for the frame queue to drain...");
+        // A give left over from an earlier drain does not end the wait
+        while (display_in_progress) xSemaphoreTake(display_done_semaphore, portMAX_DELAY);
         xSemaphoreGive(display_done_semaphore); // Give it back immediately
     }
 }
@@ -1812,33 +4950,23 @@ void TFT7735V::swapBuffers() {
     }
     
     // Find next available buffer for rendering
-    uint8_t next_render_idx = 255; // Invalid index
-    for (int i = 0; i < 3; i++) {
-        if (buffer_states[i] == BUFFER_STATE_IDLE) {
-            next_render_idx = i;
-            break;
-        }
+    portENTER_CRITICAL(&frame_queue_lock);
+    uint8_t next_render_idx = find_idle_buffer();
+    uint8_t old_render_idx = render_buffer_idx;
+    if (next_render_idx != 255) {
+        // Switch to next render buffer; the previous one becomes idle
+        render_buffer_idx = next_render_idx;
+        buffer_states[render_buffer_idx] = BUFFER_STATE_RENDERING;
+        buffer_states[old_render_idx] = BUFFER_STATE_IDLE;
     }
+    portEXIT_CRITICAL(&frame_queue_lock);
     
     if (next_render_idx == 255) {
         ESP_LOGW(TAG, "No idle buffer available for manual swap");
         return;
     }
     
-    // Switch to next render buffer
-    uint8_t old_render_idx = render_buffer_idx;
-    render_buffer_idx = next_render_idx;
-    buffer_states[render_buffer_idx] = BUFFER_STATE_RENDERING;
-    
-    // Previous render buffer becomes idle (ready for display)
-    buffer_states[old_render_idx] = BUFFER_STATE_IDLE;
-    
-    // Update current framebuffer pointer
-    switch (render_buffer_idx) {
-        case 0: current_framebuffer = framebuffer_a; break;
-        case 1: current_framebuffer = framebuffer_b; break;
-        case 2: current_framebuffer = framebuffer_c; break;
-    }
+    current_framebuffer = framebuffers[render_buffer_idx];
     
     ESP_LOGI(TAG, "Manual buffer swap: %d -> %d", old_render_idx, render_buffer_idx);
 }
@@ -1874,16 +5002,72 @@ bool TFT7735V::isDirtyRectEnabled() const {
     return dirty_rect_enabled;
 }
 
+tft_frame_stats_t TFT7735V::getFrameStats() const {
+    return frame_stats;
+}
+
+void TFT7735V::resetFrameStats() {
+    size_t psram_bytes = frame_stats.psram_bytes;
+    size_t sram_bytes = frame_stats.sram_bytes;
+    memset(&frame_stats, 0, sizeof(frame_stats));
+    frame_stats.min_frame_us = UINT32_MAX;
+    frame_stats.psram_bytes = psram_bytes;
+    frame_stats.sram_bytes = sram_bytes;
+}
+
+tft_timing_result_t TFT7735V::predictFrame(const tft_timing_params_t* params) const {
+    tft_timing_rect_t dirty = {};
+    if (dirty_rect_enabled && dirty_rect.valid) {
+        dirty.x = dirty_rect.x;
+        dirty.y = dirty_rect.y;
+        dirty.w = dirty_rect.w;
+        dirty.h = dirty_rect.h;
+        dirty.valid = true;
+    } else if (fb_window) {
+        dirty.x = fb_x;
+        dirty.y = fb_y;
+        dirty.w = fb_w;
+        dirty.h = fb_h;
+        dirty.valid = true;
+    }
+    return predictWorkload(&dirty, 1, params);
+}
+
+tft_timing_result_t TFT7735V::predictWorkload(const tft_timing_rect_t* frames, size_t frame_count,
+                                              const tft_timing_params_t* params) const {
+    tft_timing_params_t defaults;
+    if (params == nullptr) {
+        // esp_lcd transports queue transfers, so staging overlaps the wire
+        tft_timing_default_params(&defaults, spi_frequency, transport != TFT_TRANSPORT_SPI_MASTER);
+        params = &defaults;
+    }
+    return tft_timing_predict_workload(params, width, height, chunk_height, frames, frame_count);
+}
+
+// Dirty-track an inclusive, possibly off-screen box (framebuffer mode only)
+void TFT7735V::mark_dirty_bounds(int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+    if (!framebuffer_enabled) return;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= width) x1 = width - 1;
+    if (y1 >= height) y1 = height - 1;
+    if (x0 > x1 || y0 > y1) return;
+    expand_dirty_rect(x0, y0, x1 - x0 + 1, y1 - y0 + 1);
+}
+
 void TFT7735V::expand_dirty_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
     if (!dirty_rect_enabled) {
         return;
     }
     
-    // Clip to screen bounds
-    if (x >= width || y >= height) return;
-    if (x + w > width) w = width - x;
-    if (y + h > height) h = height - y;
-    if (w == 0 || h == 0) return;
+    // Clip to the framebuffer (screen bounds without a window)
+    int32_t x0 = std::max<int32_t>(fb_x, x), y0 = std::max<int32_t>(fb_y, y);
+    int32_t x1 = std::min<int32_t>(fb_x + fb_w, x + w), y1 = std::min<int32_t>(fb_y + fb_h, y + h);
+    if (x0 >= x1 || y0 >= y1) return;
+    x = x0;
+    y = y0;
+    w = x1 - x0;
+    h = y1 - y0;
     
     if (!dirty_rect.valid) {
         // First dirty region
@@ -1917,8 +5101,8 @@ uint8_t TFT7735V::calculate_dirty_chunks(const dirty_rect_t& dirty_rect, uint8_t
     }
     
     // Calculate which chunks are affected by dirty rectangle
-    start_chunk = dirty_rect.y / CHUNK_HEIGHT;
-    end_chunk = (dirty_rect.y + dirty_rect.h - 1) / CHUNK_HEIGHT;
+    start_chunk = dirty_rect.y / chunk_height;
+    end_chunk = (dirty_rect.y + dirty_rect.h - 1) / chunk_height;
     
     // Ensure chunks are within bounds
     if (start_chunk >= total_chunks) start_chunk = total_chunks - 1;
@@ -1938,31 +5122,18 @@ void TFT7735V::copy_dirty_chunk_and_send(uint8_t chunk_idx, uint8_t source_buffe
         return;
     }
     
-    // Get source framebuffer based on buffer index
-    uint16_t* source_framebuffer = nullptr;
-    switch (source_buffer_idx) {
-        case 0: source_framebuffer = framebuffer_a; break;
-        case 1: source_framebuffer = framebuffer_b; break;
-        case 2: source_framebuffer = framebuffer_c; break;
-        default:
-            ESP_LOGE(TAG, "Invalid source buffer index: %d", source_buffer_idx);
-            return;
-    }
-    
-    if (source_framebuffer == nullptr) {
+    if (source_framebuffer(source_buffer_idx) == nullptr) {
         ESP_LOGE(TAG, "Source framebuffer %d is null", source_buffer_idx);
         return;
     }
     
     // Calculate chunk dimensions
-    uint16_t chunk_start_y = chunk_idx * CHUNK_HEIGHT;
-    uint16_t chunk_end_y = (chunk_idx + 1) * CHUNK_HEIGHT;
+    uint16_t chunk_start_y = chunk_idx * chunk_height;
+    uint16_t chunk_end_y = (chunk_idx + 1) * chunk_height;
     if (chunk_end_y > height) {
         chunk_end_y = height;
     }
     
-    uint16_t actual_chunk_height = chunk_end_y - chunk_start_y;
-    
     // Calculate intersection of dirty rect with this chunk
     uint16_t dirty_start_y = std::max(dirty_rect.y, chunk_start_y);
     uint16_t dirty_end_y = std::min((uint16_t)(dirty_rect.y + dirty_rect.h), chunk_end_y);
@@ -1980,81 +5151,6 @@ void TFT7735V::copy_dirty_chunk_and_send(uint8_t chunk_idx, uint8_t source_buffe
     ESP_LOGD(TAG, "Processing dirty chunk %d from buffer %d: dirty region (%d,%d) %dx%d", 
              chunk_idx, source_buffer_idx, dirty_x, dirty_start_y, dirty_w, dirty_height);
     
-    // Use alternating SRAM buffers for double buffering
-    uint16_t* target_buffer = (chunk_idx % 2 == 0) ? sram_buffer_a : sram_buffer_b;
-    
-    // Copy dirty region from PSRAM framebuffer to SRAM buffer
-    // We need to copy full width chunks for efficient SPI transfer
-    uint16_t* src = source_framebuffer + (chunk_start_y * width);
-    size_t chunk_size_pixels = width * actual_chunk_height;
-    
-    // Fast memcpy from PSRAM to SRAM (full chunk for simplicity)
-    memcpy(target_buffer, src, chunk_size_pixels * sizeof(uint16_t));
-    
-    // Send to display with dirty rectangle info
-    send_dirty_chunk_to_display(target_buffer, chunk_idx, actual_chunk_height, dirty_rect);
-}
-
-void TFT7735V::send_dirty_chunk_to_display(uint16_t* buffer, uint16_t chunk_idx, uint16_t chunk_height, const dirty_rect_t& dirty_rect) {
-    if (!initialized || buffer == nullptr) {
-        return;
-    }
-    
-    // Calculate chunk position
-    uint16_t chunk_start_y = chunk_idx * CHUNK_HEIGHT;
-    
-    // Calculate intersection of dirty rect with this chunk
-    uint16_t dirty_start_y = std::max(dirty_rect.y, chunk_start_y);
-    uint16_t dirty_end_y = std::min((uint16_t)(dirty_rect.y + dirty_rect.h), (uint16_t)(chunk_start_y + chunk_height));
-    
-    if (dirty_start_y >= dirty_end_y) {
-        ESP_LOGD(TAG, "Chunk %d not dirty, skipping display", chunk_idx);
-        return;
-    }
-    
-    uint16_t dirty_height = dirty_end_y - dirty_start_y;
-    uint16_t dirty_x = dirty_rect.x;
-    uint16_t dirty_w = dirty_rect.w;
-    
-    ESP_LOGD(TAG, "Sending dirty chunk %d to display: region (%d,%d) %dx%d", 
-             chunk_idx, dirty_x, dirty_start_y, dirty_w, dirty_height);
-    
-    // Set address window for dirty region only
-    set_addr_window(dirty_x, dirty_start_y, dirty_x + dirty_w - 1, dirty_start_y + dirty_height - 1);
-    
-    // Convert endianness and send via SPI
-    gpio_set_level(dc_pin, 1); // Data mode
-    
-    // Calculate offset in buffer for dirty region
-    uint16_t dirty_offset_y = dirty_start_y - chunk_start_y;
-    
-    // Send dirty region line by line
-    for (uint16_t row = 0; row < dirty_height; row++) {
-        uint16_t* line_start = buffer + ((dirty_offset_y + row) * width) + dirty_x;
-        
-        // Convert endianness in-place (temporarily)
-        for (uint16_t col = 0; col < dirty_w; col++) {
-            line_start[col] = __builtin_bswap16(line_start[col]);
-        }
-        
-        // Send line via SPI
-        spi_transaction_t t = {};
-        t.length = dirty_w * 16; // Length in bits
-        t.tx_buffer = line_start;
-        
-        esp_err_t ret = spi_device_polling_transmit(spi_device, &t);
-        if (ret != ESP_OK) {
-            ESP_LOGE(TAG, "Failed to transmit dirty line %d: %s", row, esp_err_to_name(ret));
-            // Restore endianness before returning
-            for (uint16_t col = 0; col < dirty_w; col++) {
-                line_start[col] = __builtin_bswap16(line_start[col]);
-            }
-            return;
-        }
-        
-        // Restore original endianness
-        for (uint16_t col = 0; col < dirty_w; col++) {
-            line_start[col] = __builtin_bswap16(line_start[col]);
-        }
-    }
+    // Copy only the dirty columns, packed, so the region goes out as one transfer
+    stage_and_send(source_buffer_idx, dirty_x, dirty_start_y, dirty_w, dirty_height);
 }
@@ -11,6 +11,40 @@
 #include <esp_log.h>
 #include <esp_heap_caps.h>
 #include "font8x8.h"
+#include "panel_profiles.h"
+#include "tft_timing_model.h"
+#include "tft_scan_model.h"
+#include "tft_shaders.h"
+#include "tft_path.h"
+#include "tft_trace.h"
+#include "tft_text_layout.h"
+#include "tft_coro.h"
+#include "tft_image_cache.h"
+#include <initializer_list>
+
+// esp_lcd panel IO transport (ESP-IDF >= 5.0). Define TFT7735V_HAS_ESP_LCD=0
+// to build without it.
+#ifndef TFT7735V_HAS_ESP_LCD
+#if defined(__has_include)
+#if __has_include(<esp_lcd_panel_io.h>)
+#define TFT7735V_HAS_ESP_LCD 1
+#endif
+#endif
+#endif
+#ifndef TFT7735V_HAS_ESP_LCD
+#define TFT7735V_HAS_ESP_LCD 0
+#endif
+
+#if TFT7735V_HAS_ESP_LCD
+#include <esp_lcd_panel_io.h>
+#include <soc/soc_caps.h>
+#if defined(SOC_LCD_I80_SUPPORTED) && SOC_LCD_I80_SUPPORTED
+#define TFT7735V_HAS_I80 1
+#endif
+#endif
+#ifndef TFT7735V_HAS_I80
+#define TFT7735V_HAS_I80 0
+#endif
 
 // ST7735V Commands
 #define ST7735_NOP         0x00
@@ -30,23 +64,45 @@
 #define ST7735_RAMWR       0x2C
 #define ST7735_RAMRD       0x2E
 #define ST7735_PTLAR       0x30
+#define ST7735_IDMOFF      0x38
+#define ST7735_IDMON       0x39
 #define ST7735_COLMOD      0x3A
 #define ST7735_MADCTL      0x36
+#define ST7735_GMCTRP1     0xE0
+#define ST7735_GMCTRN1     0xE1
 
-// Display dimensions (ST7735V 1.8" 128x160)
+// Default display dimensions (ST7735V 1.8" 128x160). The actual geometry
+// comes from the panel profile, see setPanel().
 #define ST7735_WIDTH       128
 #define ST7735_HEIGHT      160
 
-// Triple buffering configuration
+// Staging buffer configuration
 #define SRAM_BUFFER_SIZE   8192    // 8KB SRAM buffer size
-#define CHUNK_HEIGHT       (SRAM_BUFFER_SIZE / (ST7735_WIDTH * 2))  // Height of each chunk
-#define MAX_CHUNKS         ((ST7735_HEIGHT + CHUNK_HEIGHT - 1) / CHUNK_HEIGHT)  // Total chunks needed
+// Chunk height is derived at runtime: SRAM_BUFFER_SIZE / (width * 2) rows
+
+// SPI clock calibration (needs MISO, see setMISOPin())
+#define TFT_SPI_READ_FREQ      4000000  // GRAM readback clock, well inside controller read timing
+#define TFT_CALIBRATION_PIXELS 32       // Test strip length (row 0)
+
+// Color correction
+#define TFT_GAMMA_MAX_BYTES    16       // Longest GMCTRP1 / GMCTRN1 parameter list
+
+// Tear avoidance
+#define TFT_SCAN_SETUP_US      50       // CASET / RASET / RAMWR ahead of the pixel data
+#define TFT_SCAN_GUARD_US      100      // Clearance around the scan for estimate drift
+
+// Framebuffer queue
+#define TFT_MAX_FRAMEBUFFERS     8
+#define TFT_DEFAULT_FRAMEBUFFERS 3
+
+// Virtual canvas: other panels showing parts of this one's framebuffer
+#define TFT_MAX_CANVAS_PANELS    3
 
-// Triple buffer states
 typedef enum {
     BUFFER_STATE_RENDERING,    // Currently being drawn to
     BUFFER_STATE_TRANSFERRING, // Currently being transferred to display
-    BUFFER_STATE_IDLE          // Available for next render
+    BUFFER_STATE_IDLE,         // Available for next render
+    BUFFER_STATE_QUEUED        // Waiting in the frame queue
 } buffer_state_t;
 
 // Dirty rectangle structure
@@ -55,15 +111,124 @@ typedef struct {
     bool valid;
 } dirty_rect_t;
 
+// Polygon vertex
+typedef struct {
+    int16_t x, y;
+} tft_point_t;
+
+// Batched primitives (drawLines() / fillRects())
+typedef struct {
+    int16_t x0, y0, x1, y1;
+    uint16_t color;
+} tft_line_t;
+
+typedef struct {
+    int16_t x, y, w, h;
+    uint16_t color;
+} tft_rect_t;
+
+// Blit flip flags (drawRGBBitmapRegion())
+#define TFT_FLIP_NONE 0x00
+#define TFT_FLIP_H    0x01
+#define TFT_FLIP_V    0x02
+
+#define TFT_POLYGON_MAX_CROSSINGS 32   // Edge crossings per scanline for polygon fills
+#define TFT_SHADER_SPAN_PIXELS    64   // Staging span for shader fills in direct mode
+#define TFT_BLUR_MAX_RADIUS       15   // Box blur window of up to 31 pixels
+#define TFT_MAX_SPRITES           128  // Sprite slots (addSprite())
+
+// Sprite composed over the framebuffer while staging (see addSprite())
+typedef struct {
+    const uint16_t* pixels;    // w * h RGB565, caller-owned
+    int16_t x, y;
+    uint16_t w, h;
+    int16_t z;                 // Higher z is drawn on top; equal z in creation order
+    uint16_t key;              // Transparent color when keyed
+    bool keyed;
+    uint8_t alpha;             // 255 = opaque
+    bool visible;
+    bool used;
+} tft_sprite_t;
+
+// Lazy clear tiles (16x16 pixels)
+#define TFT_TILE_SHIFT 4
+#define TFT_TILE_SIZE  (1 << TFT_TILE_SHIFT)
+
+// Frame handed to display(), waiting for or in transfer
+typedef struct {
+    uint8_t buffer_idx;
+    uint32_t seq;
+    bool use_dirty_rect;
+    dirty_rect_t rect;         // This frame's own damage
+    int64_t queued_us;         // When display() queued it
+} tft_queued_frame_t;
+
 // Display task message structure
 typedef struct {
     uint8_t chunk_idx;
+    bool is_first_chunk;       // Transfer starts: counters, and the frame itself outside canvas mode
     bool is_last_chunk;
     uint8_t source_buffer_idx; // Which PSRAM buffer to read from
+    uint32_t frame_seq;        // Sequence number of the frame this chunk belongs to
     bool use_dirty_rect;       // Whether to use dirty rect optimization
     dirty_rect_t dirty_rect;   // Dirty rectangle region
+    bool canvas_start;         // Canvas frame: start it and post every panel's part
 } display_message_t;
 
+// Transport backend, selected at begin()
+typedef enum {
+    TFT_TRANSPORT_SPI_MASTER,  // spi_master driven directly, manual DC (default)
+    TFT_TRANSPORT_ESP_LCD_SPI, // esp_lcd panel IO over SPI, queued color transfers
+    TFT_TRANSPORT_ESP_LCD_I80  // esp_lcd panel IO over 8-bit Intel 8080 parallel bus
+} tft_transport_t;
+
+// Parallel bus pins for TFT_TRANSPORT_ESP_LCD_I80 (CS/DC come from the constructor)
+typedef struct {
+    gpio_num_t data[8];        // D0..D7
+    gpio_num_t wr;             // Write strobe
+} tft_i80_pins_t;
+
+// When display_task holds the SPI bus lock. Other devices on the bus
+// (e.g. an SD card) only get the bus between lock periods.
+typedef enum {
+    TFT_BUS_LOCK_PER_TRANSACTION, // Lock per SPI transaction (others may interleave anywhere)
+    TFT_BUS_LOCK_PER_CHUNK_GROUP, // Lock held for N chunks, then released to let others in
+    TFT_BUS_LOCK_PER_FRAME        // Lock held for the whole frame
+} tft_bus_policy_t;
+
+// Frame transfer statistics (for per-panel memory/FPS benchmarking)
+typedef struct {
+    uint32_t frames;           // Completed frames since reset
+    uint32_t last_frame_us;    // display() to last chunk sent
+    uint32_t min_frame_us;
+    uint32_t max_frame_us;
+    uint64_t total_frame_us;   // Sum over all frames, for averaging
+    uint32_t last_frame_bytes; // Pixel bytes sent in the last frame
+    uint32_t jitter_us;        // Smoothed frame-to-frame variation (RFC 3550 style)
+    uint32_t bus_wait_us;      // Time spent waiting for the SPI bus in the last frame
+    uint32_t max_bus_wait_us;
+    uint32_t queue_us;         // display() to transfer start, last frame
+    uint32_t max_queue_us;
+    uint8_t queue_depth;       // Frames queued or in transfer after the last display()
+    uint8_t max_queue_depth;
+    uint32_t stalls;           // display() calls that waited for a free buffer
+    uint32_t last_stall_us;
+    uint32_t max_stall_us;
+    uint64_t total_stall_us;
+    uint32_t scan_wait_us;     // Tear avoidance: chunks held back for the scan, last frame
+    uint32_t max_scan_wait_us;
+    uint32_t scan_misses;      // Tear avoidance: chunks too slow to clear the scan
+    uint32_t sprite_us;        // Staging time spent composing sprites in the last frame
+    uint16_t sprite_count;     // Visible sprites in the last frame
+    size_t psram_bytes;        // Framebuffer memory (all buffers)
+    size_t sram_bytes;         // SRAM staging buffer memory
+} tft_frame_stats_t;
+
+// Called on the display task once the last chunk of frame seq has been sent,
+// possibly after waitForDisplayDone() has already returned: user must
+// outlive the driver or be unregistered first
+typedef void (*tft_frame_done_cb_t)(uint32_t seq, void* user);
+
 // Color definitions
 #define ST7735_BLACK       0x0000
 #define ST7735_WHITE       0xFFFF
@@ -83,17 +248,72 @@ private:
     gpio_num_t bl_pin;
     
     bool initialized;
-    bool spi_initialized;
+    bool spi_initialized;          // We initialized (and own) the SPI bus
+    spi_host_device_t spi_host;
     bool pwm_initialized;
     uint32_t spi_frequency;    uint8_t brightness_level;
-      // Triple buffer framebuffer support
-    uint16_t* framebuffer_a;        // PSRAM buffer A - for rendering
-    uint16_t* framebuffer_b;        // PSRAM buffer B - for transferring
-    uint16_t* framebuffer_c;        // PSRAM buffer C - idle/next
+    // Framebuffers (PSRAM): one rendering, the others queued, in transfer or idle
+    uint16_t* framebuffers[TFT_MAX_FRAMEBUFFERS];
+    uint8_t framebuffer_count;
     uint16_t* current_framebuffer;  // Currently active framebuffer for drawing
-    buffer_state_t buffer_states[3]; // State of each buffer
+    buffer_state_t buffer_states[TFT_MAX_FRAMEBUFFERS];
     uint8_t render_buffer_idx;      // Index of buffer currently being rendered to
     uint8_t transfer_buffer_idx;    // Index of buffer currently being transferred
+    
+    // Frame queue, oldest first; the head is on the wire while transfer_active.
+    // Shared with the display task under frame_queue_lock.
+    tft_queued_frame_t frame_queue[TFT_MAX_FRAMEBUFFERS];
+    uint8_t frame_queue_head;
+    uint8_t frame_queue_count;
+    bool transfer_active;
+    portMUX_TYPE frame_queue_lock;
+    SemaphoreHandle_t buffer_free_semaphore;
+    uint32_t frame_interval_us;     // Minimum time between transfer starts
+    int64_t last_transfer_start_us;
+    
+    // Virtual canvas. The master owns the framebuffers and lists the other
+    // panels; each of those points back at it and stages its window of the
+    // canvas. A frame is done once every panel with a part of it finished.
+    struct canvas_panel_t {
+        TFT7735V* panel;
+        uint16_t x, y;
+    };
+    canvas_panel_t canvas_panels[TFT_MAX_CANVAS_PANELS];
+    uint8_t canvas_panel_count;
+    TFT7735V* canvas_master;
+    uint16_t canvas_x, canvas_y;
+    uint8_t canvas_pending[TFT_MAX_FRAMEBUFFERS];   // Parts still in transfer
+    uint32_t canvas_frame_bytes;
+    uint32_t canvas_frame_sprite_us;
+    bool send_canvas_frame(const tft_queued_frame_t& frame);
+    void start_canvas_frame(const display_message_t& msg);
+    void canvas_part_done(uint8_t buffer_idx, uint32_t seq, uint32_t bytes, uint32_t sprite_us);
+    
+    // Framebuffer window: the framebuffers cover fb_w x fb_h pixels at
+    // (fb_x, fb_y), the whole screen unless setFramebufferWindow() was used.
+    // Dirty rects stay in screen coordinates. With a window, drawing outside
+    // it goes straight to the panel between display task chunks (gram_mutex,
+    // recursive so direct helpers can nest).
+    bool fb_window;
+    int16_t fb_x, fb_y;
+    uint16_t fb_w, fb_h;
+    SemaphoreHandle_t gram_mutex;
+    size_t fb_offset(int32_t x, int32_t y) const { return (size_t)(y - fb_y) * fb_w + (x - fb_x); }
+    bool fb_full() const { return framebuffer_enabled && !fb_window; }
+    uint8_t direct_spans(int32_t y, int32_t x0, int32_t x1, int32_t* spans) const;
+    void fill_rect_direct(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color);
+    void write_row_direct(int32_t x, int32_t y, const uint16_t* pixels, int32_t n);
+    class gram_scope {
+    public:
+        gram_scope(TFT7735V* tft) : tft(tft->fb_window && tft->gram_mutex != nullptr ? tft : nullptr) {
+            if (this->tft != nullptr) xSemaphoreTakeRecursive(this->tft->gram_mutex, portMAX_DELAY);
+        }
+        ~gram_scope() {
+            if (tft != nullptr) xSemaphoreGiveRecursive(tft->gram_mutex);
+        }
+    private:
+        TFT7735V* tft;
+    };
     bool framebuffer_enabled;
     size_t framebuffer_size;
       // Double SRAM buffering support
@@ -106,28 +326,112 @@ private:
     volatile bool display_in_progress;    volatile bool display_done_flag;
     uint8_t current_chunk;
     uint8_t total_chunks;
+    uint16_t chunk_height;         // Rows per SRAM chunk for the current width
+    
+    // Lazy clear: per framebuffer, tiles flagged "cleared to tile_color" whose
+    // pixels have not been written yet
+    bool lazy_clear_enabled;
+    uint8_t tiles_x, tiles_y;
+    uint8_t* tile_lazy[TFT_MAX_FRAMEBUFFERS];
+    uint16_t* tile_color[TFT_MAX_FRAMEBUFFERS];
+    uint16_t lazy_tile_count[TFT_MAX_FRAMEBUFFERS];
+    
+    // Color correction: custom gamma curves (re-sent after every init) and a
+    // per-channel LUT applied while staging, stored pre-swapped for the wire
+    uint8_t gamma_positive[TFT_GAMMA_MAX_BYTES];
+    uint8_t gamma_negative[TFT_GAMMA_MAX_BYTES];
+    bool gamma_custom;
+    uint16_t color_lut[128];       // R 0..31, G 32..95, B 96..127
+    bool color_lut_enabled;
+    
+    // Half resolution: the framebuffer is width x height = panel size >> 1
+    // and staging doubles every pixel (optionally interpolated)
+    uint8_t res_shift;             // 0 = native, 1 = half resolution
+    bool half_res_smooth;
+    uint16_t panel_w, panel_h;     // Panel size in the current rotation
+    uint16_t* half_lines;          // Two logical rows + 1 pixel each, internal RAM
+    
+    // Partial display mode: only rows partial_y .. partial_y + partial_h - 1
+    // are scanned and transferred
+    bool partial_mode;
+    bool partial_idle;
+    uint16_t partial_y, partial_h;
+    
+    // Tear avoidance: display() chunks wait until the estimated scan is clear
+    // of them. scan_sync_us is when the init sequence ended; scan_period_us
+    // 0 means the profile's refresh period
+    bool tear_avoidance;
+    uint32_t scan_period_us;
+    int32_t scan_phase_us;
+    int64_t scan_sync_us;
+    uint32_t frame_scan_wait_us;
+    
+    // Panel profile (geometry + controller command set)
+    const tft_panel_profile_t* panel;
+    
+    // Frame statistics
+    tft_frame_stats_t frame_stats;
+    int64_t frame_start_us;
+    uint32_t frame_bytes;
+    uint32_t frame_bus_wait_us;
+    
+    // Frame sequence numbers: frame_seq counts display() calls that started
+    // a transfer, frame_seq_done is the last one fully sent
+    uint32_t frame_seq;
+    volatile uint32_t frame_seq_done;
+    tft_frame_done_cb_t frame_done_cb;
+    void* frame_done_user;
+    
+    // SPI bus sharing
+    tft_bus_policy_t bus_policy;
+    uint8_t bus_chunks_per_group;
+    uint8_t bus_chunks_held;       // Chunks sent since the bus was acquired
+    bool bus_acquired;
     
     // Dirty rectangle optimization
     dirty_rect_t dirty_rect;       // Current dirty rectangle
     bool dirty_rect_enabled;       // Whether dirty rect optimization is enabled
     bool force_full_redraw;        // Force full frame redraw flag
     
+    // Transport backend
+    tft_transport_t transport;
+    tft_i80_pins_t i80_pins;
+    bool ramwr_pending;            // esp_lcd: RAMWR goes out with the next color transfer
+    uint8_t transfers_in_flight;   // esp_lcd: queued color transfers not yet completed (gram_mutex with a window)
+#if TFT7735V_HAS_ESP_LCD
+    esp_lcd_panel_io_handle_t lcd_io;
+    SemaphoreHandle_t transfer_done_semaphore;
+#if TFT7735V_HAS_I80
+    esp_lcd_i80_bus_handle_t i80_bus;
+#endif
+    static bool on_color_trans_done(esp_lcd_panel_io_handle_t io, esp_lcd_panel_io_event_data_t* edata, void* user_ctx);
+    bool init_esp_lcd_io();
+#endif
+    bool init_transport();
+    void free_transport();
+    
     // Private methods for SPI communication
     void spi_pre_transfer_callback(spi_transaction_t *t);
     void write_command(uint8_t cmd);
     void write_data(uint8_t data);
     void write_data16(uint16_t data);
     void write_data_buffer(const uint8_t* data, size_t len);
+    void write_pixels(const void* data, size_t len, bool wait);
+    void wait_transfers(uint8_t max_in_flight);
+    void send_command(uint8_t cmd, const uint8_t* data, size_t len);
     void hardware_reset();
     void init_sequence();
     void init_pwm();
     void update_spi_speed();
+    bool read_pixels(uint16_t x, uint16_t y, uint16_t w, uint8_t* rgb666);
+    bool verify_test_pattern(uint8_t pattern);
     void apply_brightness();    // Framebuffer methods
     bool init_framebuffer();
     void free_framebuffer();
     void fb_draw_pixel(uint16_t x, uint16_t y, uint16_t color);
     void fb_fill_screen(uint16_t color);
     void fb_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
+    void fb_fill_rect_raw(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
     void fb_draw_fast_hline(uint16_t x, uint16_t y, uint16_t w, uint16_t color);
     void fb_draw_fast_vline(uint16_t x, uint16_t y, uint16_t h, uint16_t color);
     void fb_draw_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color);
@@ -146,12 +450,116 @@ private:
     static void display_task(void* pvParameters);
     void copy_chunk_and_send(uint8_t chunk_idx, uint8_t source_buffer_idx);
     void copy_dirty_chunk_and_send(uint8_t chunk_idx, uint8_t source_buffer_idx, const dirty_rect_t& dirty_rect);
-    void send_chunk_to_display(uint16_t* buffer, uint16_t chunk_idx, uint16_t chunk_height);
-    void send_dirty_chunk_to_display(uint16_t* buffer, uint16_t chunk_idx, uint16_t chunk_height, const dirty_rect_t& dirty_rect);
+    uint32_t stage_rows(uint8_t buffer_idx, uint16_t x, uint16_t y, uint16_t w, uint16_t rows, uint16_t* dst);
+    uint16_t* acquire_sram_buffer();
+    void copy_rows_native(uint8_t buffer_idx, uint16_t x, uint16_t y, uint16_t w, uint16_t rows, uint16_t* dst);
+    void encode_pixels(uint16_t* pixels, uint32_t count);
+    void send_chunk_to_display(uint16_t* buffer, uint16_t x, uint16_t y, uint16_t w, uint16_t rows);
+    void wait_for_scan(uint16_t y, uint16_t w, uint16_t rows);
+    void update_chunk_geometry();
+    void set_logical_size();
+    void stage_rows_half(uint8_t buffer_idx, uint16_t x, uint16_t y, uint16_t w, uint16_t rows,
+                         uint16_t out_w, uint16_t out_h, uint16_t* dst);
+    void load_half_line(uint8_t buffer_idx, uint16_t x, uint16_t y, uint16_t w, uint16_t* line);
+    void stage_and_send(uint8_t buffer_idx, uint16_t x, uint16_t y, uint16_t w, uint16_t rows);
+    
+    // Lazy clear
+    bool init_tile_tables();
+    void free_tile_tables();
+    void reset_tile_tables();
+    void materialize_tiles(uint8_t buffer_idx, int32_t x, int32_t y, int32_t w, int32_t h);
+    void materialize_render(int32_t x, int32_t y, int32_t w, int32_t h);
+    void complete_display(uint8_t source_buffer_idx, uint32_t seq);
+    void frame_finished(uint8_t source_buffer_idx, uint32_t seq);
+    bool send_first_chunk(const tft_queued_frame_t& frame);
+    bool post_first_chunk(const tft_queued_frame_t& frame);
+    void record_frame_stats(uint8_t source_buffer_idx, uint32_t bytes, uint32_t sprite_us);
+    const uint16_t* source_framebuffer(uint8_t buffer_idx) const;
+    void begin_frame_transfer(uint8_t source_buffer_idx);
+    void start_frame(uint8_t source_buffer_idx);
+    uint8_t find_idle_buffer();
+    void bus_acquire();
+    void bus_release();
+    void bus_chunk_done();
+#if TFT_HAS_COROUTINES
+    static bool present_ready(void* ctx, uint32_t arg);
+    static uint32_t present_submit(void* ctx, uint32_t arg);
+    static bool frame_done_ready(void* ctx, uint32_t seq);
+    static uint32_t frame_done_result(void* ctx, uint32_t seq);
+#endif
     
     // Dirty rectangle methods
     void expand_dirty_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+    void mark_dirty_bounds(int32_t x0, int32_t y0, int32_t x1, int32_t y1);
+    void plot_pixels(const tft_point_t* points, const uint16_t* colors, uint16_t color, size_t count);
+    void plot_line(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t color);
+    
+    // Shader fills
+    template <typename Shader>
+    void shade_span(int16_t x, int16_t y, int16_t w, const Shader& shader);
+    static uint8_t polygon_row_crossings(const tft_point_t* points, uint16_t count, int16_t y,
+                                         int16_t* xs, uint8_t max_crossings);
+    
+    // Path fills
+    dirty_rect_t fill_segments(std::vector<tft_path_segment_t>& segments, uint16_t color, tft_fill_rule_t rule,
+                               bool overlapping = false);
     uint8_t calculate_dirty_chunks(const dirty_rect_t& dirty_rect, uint8_t& start_chunk, uint8_t& end_chunk);
+    
+    // Region effects
+    bool clip_effect_region(int16_t& x, int16_t& y, int16_t& w, int16_t& h);
+    void blend_region(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color, uint8_t alpha);
+    
+    // Sprites. display() snapshots the visible sprites sorted by z into
+    // per-band lists (one band per staging chunk), one snapshot per queued
+    // buffer, that the display task composes from while the app keeps
+    // moving the live ones.
+    struct sprite_snapshot_t {
+        std::vector<tft_sprite_t> sprites;
+        std::vector<uint16_t> band_start;   // Band b: items [start[b], start[b + 1])
+        std::vector<uint16_t> band_items;   // Indices into sprites
+        uint16_t band_height;
+    };
+    std::vector<tft_sprite_t> sprites;
+    sprite_snapshot_t sprite_snapshots[TFT_MAX_FRAMEBUFFERS];
+    uint32_t frame_sprite_us;
+    tft_sprite_t* sprite_slot(int16_t id);
+    void mark_sprite(const tft_sprite_t& s);
+    void snapshot_sprites(sprite_snapshot_t& snap);
+    bool sprites_in_window(const sprite_snapshot_t& snap, uint16_t x, uint16_t y, uint16_t w, uint16_t rows) const;
+    void compose_sprites(const sprite_snapshot_t& snap, uint16_t x, uint16_t y, uint16_t w, uint16_t rows, uint16_t* dst);
+    
+    // Call tracing. Only the outermost public call is recorded; public calls
+    // the driver makes internally are part of that call's workload.
+    TFTTraceRecorder* tracer;
+    uint8_t trace_depth;
+    // Sprites added by replayTrace(): own id by recorded id, and stand-in
+    // pixels by own id, kept until the sprite is removed
+    std::vector<int16_t> replay_sprite_ids;
+    std::vector<std::vector<uint16_t> > replay_sprite_pixels;
+    int16_t replay_sprite(int32_t recorded_id) const;
+    const uint16_t* keep_replay_sprite_pixels(int16_t id, std::vector<uint16_t>& pixels);
+    
+    class trace_scope {
+    public:
+        trace_scope(TFT7735V* tft, uint8_t op, std::initializer_list<int32_t> args)
+            : tft(tft->tracer != nullptr ? tft : nullptr) {
+            if (this->tft != nullptr) this->tft->trace_enter(op, args);
+        }
+        ~trace_scope() {
+            if (tft != nullptr) tft->trace_depth--;
+        }
+    private:
+        TFT7735V* tft;
+    };
+    
+    bool tracing() const { return tracer != nullptr && trace_depth == 0; }
+    void trace_enter(uint8_t op, std::initializer_list<int32_t> args);
+    uint32_t trace_hash(const void* data, size_t len) const;
+    static void trace_bounds(const tft_point_t* points, size_t count, int32_t* bounds);
+    static void trace_bounds(const tft_line_t* lines, size_t count, int32_t* bounds);
+    static void trace_bounds(const tft_rect_t* rects, size_t count, int32_t* bounds);
+    void set_addr_window_raw(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
+    uint16_t scan_line(uint16_t y) const;
 
 public:
     // Constructor with configurable pins
@@ -165,14 +573,132 @@ public:
     // Destructor
     ~TFT7735V();
       // Initialization
+    bool setPanel(const tft_panel_profile_t& profile); // Call before begin()
+    const tft_panel_profile_t& getPanel() const;
     bool begin(uint32_t freq_hz = 40000000);
+    bool begin(uint32_t freq_hz, tft_transport_t transport);
+    void setParallelPins(const tft_i80_pins_t& pins); // For TFT_TRANSPORT_ESP_LCD_I80
+    tft_transport_t getTransport() const;
+    void setSPIHost(spi_host_device_t host);      // Call before begin(); default SPI2_HOST
+    
+    // SPI bus sharing (e.g. SD card on the same bus)
+    void setBusPolicy(tft_bus_policy_t policy, uint8_t chunks_per_group = 2);
+    tft_bus_policy_t getBusPolicy() const;
     void end();    // Framebuffer control (enabled by default)
     bool enableFramebuffer();
     void disableFramebuffer();
     bool isFramebufferEnabled() const;    void display();  // Push framebuffer to display (async)
-    void swapBuffers(); // Manual buffer swap for triple buffering
-    bool displayDone() const;  // Check if async display is complete
-    void waitForDisplayDone(); // Wait for async display to complete
+    void swapBuffers(); // Manual buffer swap
+    bool displayDone() const;  // Check if all queued frames are on the panel
+    void waitForDisplayDone(); // Wait for the frame queue to drain
+    
+    // Frame queue. display() queues the frame with its own dirty rect and
+    // returns; it only blocks (counted in stalls) when every other buffer
+    // is queued or on the wire. count buffers means up to count - 1 frames
+    // in flight; set it before begin() or while the framebuffer is disabled.
+    // setFrameInterval() spaces transfer starts at least us apart (0 = off).
+    bool setFramebufferCount(uint8_t count);
+    uint8_t getFramebufferCount() const;
+    uint8_t getQueueDepth() const;      // Frames queued or in transfer
+    void setFrameInterval(uint32_t us);
+    
+    // Frame sequence numbers. frameSequence() is the frame the last display()
+    // started (0 before the first); completedFrameSequence() reaches it once
+    // that frame is on the panel.
+    uint32_t frameSequence() const;
+    uint32_t completedFrameSequence() const;
+    void setFrameDoneCallback(tft_frame_done_cb_t callback, void* user = nullptr);
+    
+#if TFT_HAS_COROUTINES
+    // Awaitables for TFTTask coroutines (see tft_coro.h). present() resumes
+    // once display() has a free buffer, calls it and yields the frame's
+    // sequence number; frameDone(seq) resumes when that frame is on the panel.
+    TFTAwait present();
+    TFTAwait frameDone(uint32_t seq);
+#endif
+    
+    // Lazy clear: fill_screen() only flags 16x16 tiles; tiles are written on
+    // first draw or expanded straight into the SRAM staging buffer
+    void setLazyClear(bool enable);
+    bool isLazyClearEnabled() const;
+    
+    // Color correction. Gamma curves are the panel's GMCTRP1 / GMCTRN1
+    // parameters (getGammaCurveLength() bytes each) and cost nothing per
+    // pixel. The LUT maps each 5/6/5-bit channel (red and blue 32 entries,
+    // green 64, nullptr = identity) once per transmitted pixel in
+    // framebuffer mode.
+    bool setGammaCurves(const uint8_t* positive, const uint8_t* negative);
+    uint8_t getGammaCurveLength() const;
+    void setColorLUT(const uint8_t* red, const uint8_t* green, const uint8_t* blue);
+    void clearColorLUT();
+    bool isColorLUTEnabled() const;
+    
+    // Half resolution (framebuffer mode): getWidth() / getHeight() become
+    // half the panel size, so drawing and PSRAM traffic drop 4x, and every
+    // pixel is sent as a 2x2 block. smooth interpolates the in-between
+    // pixels instead of repeating them. The framebuffer contents are not
+    // rescaled: redraw after switching. Leaves partial mode.
+    bool setHalfResolution(bool enable, bool smooth = false);
+    bool isHalfResolution() const;
+    
+    // Virtual canvas (framebuffer mode). Before begin(), addCanvasPanel()
+    // places another panel, already begun, at (x, y) of this panel's canvas;
+    // this panel sits at (0, 0). getWidth() / getHeight() then cover every
+    // panel and drawing spans them. display() splits the damage per panel
+    // and each panel sends its part on its own display task: panels on
+    // separate SPI hosts transfer concurrently, panels sharing a bus
+    // interleave per chunk group. The added panel's framebuffer is released
+    // and this panel's color LUT, sprites and lazy clear apply to all.
+    // No half resolution, partial mode or rotation change in canvas mode.
+    bool addCanvasPanel(TFT7735V& panel, uint16_t x, uint16_t y);
+    uint8_t getCanvasPanelCount() const;
+    
+    // Framebuffer window. Before begin(), setFramebufferWindow() makes the
+    // framebuffers cover only the w x h area at (x, y), so PSRAM use follows
+    // the animated part of the screen instead of the panel size. Drawing
+    // inside the window is buffered and sent by display() as usual; drawing
+    // outside it is written to the panel right away. Outside the window there
+    // is nothing to read back: anti-aliased edges are thresholded, region
+    // effects are clipped to the window and sprites only show inside it.
+    // No half resolution, canvas, partial mode, lazy clear or rotation change
+    // with a window.
+    bool setFramebufferWindow(int16_t x, int16_t y, uint16_t w, uint16_t h);
+    bool getFramebufferWindow(int16_t& x, int16_t& y, uint16_t& w, uint16_t& h) const;
+    
+    // Partial display mode (PTLAR + PTLON): the panel drives only the strip
+    // of rows y .. y + h - 1 and display() transfers nothing outside it. idle
+    // additionally enables 8-color idle mode. Portrait rotations (0/2) only,
+    // since the strip is a range of scan lines. exitPartialMode() returns to
+    // normal mode and the next display() resends the whole frame.
+    bool enterPartialMode(uint16_t y, uint16_t h, bool idle = false);
+    void exitPartialMode();
+    bool isPartialMode() const;
+    
+    // Tear avoidance without a TE pin. The panel's scan line is estimated
+    // from the profile's refresh period and the end of the init sequence, and
+    // each display() chunk starts only when writing it keeps ahead of the
+    // scan or behind it, so no refresh shows it half old and half new.
+    // Chunks too slow to fit between two passes of the scan go out right
+    // away (scan_misses in the frame stats). The panel oscillator drifts from
+    // its nominal rate: setScanTiming() overrides the period (0 = profile)
+    // and shifts the estimate by phase_us; tune both until the tear line
+    // stays gone. Portrait rotations (0/2) only, since the scan runs along
+    // rows; landscape frames are sent unscheduled, and so are frames in
+    // partial mode, which refreshes at a different rate.
+    void setTearAvoidance(bool enable);
+    bool isTearAvoidanceEnabled() const;
+    void setScanTiming(uint32_t period_us, int32_t phase_us = 0);
+    void getScanTiming(uint32_t& period_us, int32_t& phase_us) const;
+    
+    // Drawing-call trace (see tft_trace.h). Every public drawing call and
+    // display() is recorded while a recorder is attached; nullptr detaches.
+    // replayTrace() re-issues a recorded stream, with deterministic stand-ins
+    // for payloads that were only hashed (bitmaps, sprite images, text, point
+    // lists, paths).
+    // timed waits out the recorded gaps between calls.
+    void setTraceRecorder(TFTTraceRecorder* recorder);
+    TFTTraceRecorder* getTraceRecorder() const;
+    uint32_t replayTrace(const uint8_t* data, size_t len, bool timed = false);
     
     // Basic display control
     void display_on();
@@ -183,6 +709,8 @@ public:
     
     // Advanced configuration functions
     void setSPISpeed(uint32_t hz);
+    void setMISOPin(gpio_num_t miso);   // Optional, call before begin(); enables readback
+    uint32_t calibrateSPISpeed(uint32_t max_hz = 80000000, uint8_t margin_percent = 20);
     void setBrightness(uint8_t level);  // 0-255, supports PWM
     void setRotation(uint8_t r);        // 0/1/2/3 for 0°/90°/180°/270°
     void setOffsets(int16_t x, int16_t y);
@@ -212,6 +740,66 @@ public:
     void drawBitmap(uint16_t x, uint16_t y, const uint8_t *bitmap, uint16_t w, uint16_t h, uint16_t color, uint16_t bg);
     void drawRGBBitmap(uint16_t x, uint16_t y, const uint16_t *bitmap, uint16_t w, uint16_t h);
     void drawRGBBitmap(uint16_t x, uint16_t y, const uint16_t *bitmap, const uint8_t *mask, uint16_t w, uint16_t h);
+    void drawRGBBitmapRegion(int16_t x, int16_t y, const uint16_t* src, uint16_t src_stride,
+                             uint16_t src_x, uint16_t src_y, uint16_t w, uint16_t h, uint8_t flip = TFT_FLIP_NONE);
+    // Per-pixel alpha, 255 = opaque; direct mode draws the pixels with alpha >= 128
+    void drawRGBBitmapAlpha(int16_t x, int16_t y, const uint16_t* bitmap, const uint8_t* alpha, uint16_t w, uint16_t h);
+    // Image from a TFTImageCache (tft_image_cache.h), decoded on a miss.
+    // Opaque images take the row-memcpy drawRGBBitmapRegion() path.
+    bool drawCachedImage(TFTImageCache& cache, uint32_t asset_id, int16_t x, int16_t y, uint32_t params = 0);
+    
+    // Batched primitives: one bounds pass and one damage update per call
+    void drawPixels(const tft_point_t* points, size_t count, uint16_t color);
+    void drawPixels(const tft_point_t* points, const uint16_t* colors, size_t count);
+    void drawLines(const tft_line_t* lines, size_t count);
+    void fillRects(const tft_rect_t* rects, size_t count);
+    
+    // Shader fills (see tft_shaders.h: TFTLinearGradient, TFTRadialGradient,
+    // TFTPatternShader, tftShader(functor))
+    template <typename Shader>
+    void fillRectShader(int16_t x, int16_t y, int16_t w, int16_t h, const Shader& shader);
+    template <typename Shader>
+    void fillCircleShader(int16_t x0, int16_t y0, int16_t r, const Shader& shader);
+    template <typename Shader>
+    void fillPolygonShader(const tft_point_t* points, uint16_t count, const Shader& shader);
+    void fillPolygon(const tft_point_t* points, uint16_t count, uint16_t color);
+    
+    // Vector paths (see tft_path.h). Anti-aliased in framebuffer mode, 50%
+    // coverage threshold in direct mode. Returns the pixels actually touched.
+    dirty_rect_t fillPath(const TFTPath& path, uint16_t color, tft_fill_rule_t rule = TFT_FILL_NONZERO,
+                          const tft_affine_t* transform = nullptr);
+    
+    // Thick strokes: segment quads plus join/cap pieces rasterized as one
+    // union, so every covered pixel is written once and overlapping pieces
+    // do not thicken the anti-aliased edges. Points are pixel centers.
+    dirty_rect_t drawPolyline(const tft_point_t* points, uint16_t count, uint16_t color,
+                              const tft_stroke_style_t& style, bool closed = false);
+    dirty_rect_t drawThickLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, float line_width,
+                               uint16_t color, tft_line_cap_t cap = TFT_CAP_BUTT);
+    
+    // Region effects, applied in place to the framebuffer (false in direct
+    // mode). Damage is exactly the clipped region.
+    bool dimRegion(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t level);  // 255 unchanged, 0 black
+    bool tintRegion(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color, uint8_t amount);
+    bool invertRegion(int16_t x, int16_t y, int16_t w, int16_t h);
+    bool blurRegion(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t radius, uint8_t passes = 1);
+    
+    // Sprites (framebuffer mode): composed over the framebuffer band by band
+    // in the SRAM staging buffer at transfer time, so the framebuffer keeps
+    // only the background and moving a sprite costs no PSRAM writes. Old and
+    // new positions are marked dirty on every change; the next display()
+    // picks up the current state. Pixels must stay valid until the frame
+    // that shows them is done. addSprite() returns an id, or -1 when full.
+    int16_t addSprite(const uint16_t* pixels, uint16_t w, uint16_t h, int16_t x = 0, int16_t y = 0, int16_t z = 0);
+    bool removeSprite(int16_t id);
+    void clearSprites();
+    bool moveSprite(int16_t id, int16_t x, int16_t y);
+    bool setSpriteImage(int16_t id, const uint16_t* pixels);     // Same size
+    bool setSpriteZ(int16_t id, int16_t z);
+    bool setSpriteColorKey(int16_t id, uint16_t key, bool enable = true);
+    bool setSpriteAlpha(int16_t id, uint8_t alpha);
+    bool showSprite(int16_t id, bool visible);
+    uint16_t getSpriteCount() const;
     
     // Text rendering functions
     void setCursor(uint16_t x, uint16_t y);
@@ -236,9 +824,18 @@ public:
     void drawText(uint16_t x, uint16_t y, const char* text, uint16_t color, uint16_t bg, uint8_t size);
     
     // Text measurement functions
-    uint16_t getTextWidth(const char* text, uint8_t size = 1);
+    uint16_t getTextWidth(const char* text, uint8_t size = 1);     // Widest '\n'-separated line
     uint16_t getTextHeight(uint8_t size = 1);
     
+    // Text boxes (see tft_text_layout.h): word wrap, alignment and ellipsis
+    // inside a box, opaque background. Layouts are cached by text, box and style.
+    void drawTextBox(int16_t x, int16_t y, uint16_t w, uint16_t h, const char* text, const tft_text_style_t& style);
+    // Redraws only the glyphs that differ from the label's previous text
+    void drawLabel(TFTTextLabel& label, const char* text);
+    // Height the text needs when wrapped to width w
+    uint16_t getTextBoxHeight(const char* text, uint16_t w, const tft_text_style_t& style);
+    void getTextLayoutCacheStats(uint32_t& hits, uint32_t& misses) const;
+    
     // Direct SPI operations (bypass framebuffer)
     void set_addr_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
     void push_colors(const uint16_t* colors, uint32_t len);
@@ -251,6 +848,17 @@ public:
     void forceFullRedraw();
     bool isDirtyRectEnabled() const;
     
+    // Frame statistics
+    tft_frame_stats_t getFrameStats() const;
+    void resetFrameStats();
+    
+    // Timing model: predicted cost of pushing the current dirty region (or a
+    // full frame) with this panel, clock and chunk size. params == nullptr
+    // uses tft_timing_default_params() for the active transport.
+    tft_timing_result_t predictFrame(const tft_timing_params_t* params = nullptr) const;
+    tft_timing_result_t predictWorkload(const tft_timing_rect_t* frames, size_t frame_count,
+                                        const tft_timing_params_t* params = nullptr) const;
+    
     // Pin configuration structure
     struct PinConfig {
         gpio_num_t mosi;
@@ -259,6 +867,7 @@ public:
         gpio_num_t dc;
         gpio_num_t reset;
         gpio_num_t bl;
+        gpio_num_t miso;   // GPIO_NUM_NC unless readback is wired
     };
     
 private:
@@ -274,6 +883,107 @@ private:
     uint8_t text_size;
     bool text_wrap;
     bool text_has_bg;
+    TFTTextLayoutCache text_layouts;
+    
+    void draw_glyph_run(int16_t x, int16_t y, const char* text, size_t len, const tft_text_style_t& style);
+    void fill_text_span(int16_t x0, int16_t x1, int16_t y, int16_t h, uint16_t color);
 };
 
+// Shader fill templates
+
+template <typename Shader>
+void TFT7735V::shade_span(int16_t x, int16_t y, int16_t w, const Shader& shader) {
+    if (y < 0 || y >= (int16_t)height || w <= 0) return;
+    if (x < 0) { w += x; x = 0; }
+    if (x + w > (int16_t)width) w = width - x;
+    if (w <= 0) return;
+    
+    if (framebuffer_enabled) {
+        if (current_framebuffer == nullptr) return;
+        int16_t fx0 = (x > fb_x) ? x : fb_x;
+        int16_t fx1 = (x + w < fb_x + (int16_t)fb_w) ? x + w : fb_x + fb_w;
+        if (fx0 < fx1 && y >= fb_y && y < fb_y + (int16_t)fb_h) {
+            materialize_render(fx0, y, fx1 - fx0, 1);
+            shader.span(fx0, y, fx1 - fx0, current_framebuffer + fb_offset(fx0, y));
+        }
+        if (!fb_window) return;
+    }
+    
+    // Direct mode (or outside the framebuffer window) - shade into a small
+    // buffer and stream it
+    uint16_t buffer[TFT_SHADER_SPAN_PIXELS];
+    int32_t spans[4];
+    uint8_t count = direct_spans(y, x, x + w, spans);
+    gram_scope gram(this);
+    for (uint8_t s = 0; s < count; s++) {
+        int16_t sx = spans[2 * s], sw = spans[2 * s + 1] - spans[2 * s];
+        set_addr_window(sx, y, sx + sw - 1, y);
+        while (sw > 0) {
+            uint16_t n = (sw > TFT_SHADER_SPAN_PIXELS) ? TFT_SHADER_SPAN_PIXELS : sw;
+            shader.span(sx, y, n, buffer);
+            for (uint16_t i = 0; i < n; i++) {
+                buffer[i] = __builtin_bswap16(buffer[i]);
+            }
+            write_pixels(buffer, n * sizeof(uint16_t), true);
+            sx += n;
+            sw -= n;
+        }
+    }
+}
+
+template <typename Shader>
+void TFT7735V::fillRectShader(int16_t x, int16_t y, int16_t w, int16_t h, const Shader& shader) {
+    trace_scope trace(this, TFT_TRACE_OP_SHADER_RECT, { x, y, w, h });
+    if (w <= 0 || h <= 0) return;
+    int16_t y_end = (y + h > (int16_t)height) ? height : y + h;
+    for (int16_t row = (y < 0) ? 0 : y; row < y_end; row++) {
+        shade_span(x, row, w, shader);
+    }
+    mark_dirty_bounds(x, y, x + w - 1, y + h - 1);
+}
+
+template <typename Shader>
+void TFT7735V::fillCircleShader(int16_t x0, int16_t y0, int16_t r, const Shader& shader) {
+    trace_scope trace(this, TFT_TRACE_OP_SHADER_CIRCLE, { x0, y0, r });
+    if (r < 0) return;
+    int32_t limit = (int32_t)r * r + r;
+    int16_t dx = r;
+    for (int16_t dy = 0; dy <= r; dy++) {
+        while (dx > 0 && (int32_t)dx * dx + (int32_t)dy * dy > limit) dx--;
+        shade_span(x0 - dx, y0 + dy, 2 * dx + 1, shader);
+        if (dy != 0) {
+            shade_span(x0 - dx, y0 - dy, 2 * dx + 1, shader);
+        }
+    }
+    mark_dirty_bounds(x0 - r, y0 - r, x0 + r, y0 + r);
+}
+
+template <typename Shader>
+void TFT7735V::fillPolygonShader(const tft_point_t* points, uint16_t count, const Shader& shader) {
+    if (points == nullptr || count < 3) return;
+    
+    int16_t min_x = points[0].x, max_x = points[0].x;
+    int16_t min_y = points[0].y, max_y = points[0].y;
+    for (uint16_t i = 1; i < count; i++) {
+        if (points[i].x < min_x) min_x = points[i].x;
+        if (points[i].x > max_x) max_x = points[i].x;
+        if (points[i].y < min_y) min_y = points[i].y;
+        if (points[i].y > max_y) max_y = points[i].y;
+    }
+    trace_scope trace(this, TFT_TRACE_OP_SHADER_POLYGON,
+                      { count, min_x, min_y, max_x - min_x, max_y - min_y,
+                        (int32_t)trace_hash(points, count * sizeof(tft_point_t)) });
+    
+    // Even-odd fill between sorted crossings at each pixel-center row
+    int16_t xs[TFT_POLYGON_MAX_CROSSINGS];
+    int16_t y_end = (max_y > (int16_t)height) ? height : max_y;
+    for (int16_t y = (min_y < 0) ? 0 : min_y; y < y_end; y++) {
+        uint8_t n = polygon_row_crossings(points, count, y, xs, TFT_POLYGON_MAX_CROSSINGS);
+        for (uint8_t i = 0; i + 1 < n; i += 2) {
+            shade_span(xs[i], y, xs[i + 1] - xs[i], shader);
+        }
+    }
+    mark_dirty_bounds(min_x, min_y, max_x - 1, max_y - 1);
+}
+
 #endif // TFT7735V_H
@@ -0,0 +1,524 @@
+#include "bitmap_lut.h"
+
+// Generated: for every byte value, the runs of set bits in pixel order.
+// Each run is (start << 4) | length.
+
+// Bit 7 is the leftmost pixel (bitmaps, masks)
+const tft_bit_runs_t tft_bit_runs_msb[256] = {
+    { 0, { 0x00, 0x00, 0x00, 0x00 } },   // 0x00
+    { 1, { 0x71, 0x00, 0x00, 0x00 } },   // 0x01
+    { 1, { 0x61, 0x00, 0x00, 0x00 } },   // 0x02
+    { 1, { 0x62, 0x00, 0x00, 0x00 } },   // 0x03
+    { 1, { 0x51, 0x00, 0x00, 0x00 } },   // 0x04
+    { 2, { 0x51, 0x71, 0x00, 0x00 } },   // 0x05
+    { 1, { 0x52, 0x00, 0x00, 0x00 } },   // 0x06
+    { 1, { 0x53, 0x00, 0x00, 0x00 } },   // 0x07
+    { 1, { 0x41, 0x00, 0x00, 0x00 } },   // 0x08
+    { 2, { 0x41, 0x71, 0x00, 0x00 } },   // 0x09
+    { 2, { 0x41, 0x61, 0x00, 0x00 } },   // 0x0A
+    { 2, { 0x41, 0x62, 0x00, 0x00 } },   // 0x0B
+    { 1, { 0x42, 0x00, 0x00, 0x00 } },   // 0x0C
+    { 2, { 0x42, 0x71, 0x00, 0x00 } },   // 0x0D
+    { 1, { 0x43, 0x00, 0x00, 0x00 } },   // 0x0E
+    { 1, { 0x44, 0x00, 0x00, 0x00 } },   // 0x0F
+    { 1, { 0x31, 0x00, 0x00, 0x00 } },   // 0x10
+    { 2, { 0x31, 0x71, 0x00, 0x00 } },   // 0x11
+    { 2, { 0x31, 0x61, 0x00, 0x00 } },   // 0x12
+    { 2, { 0x31, 0x62, 0x00, 0x00 } },   // 0x13
+    { 2, { 0x31, 0x51, 0x00, 0x00 } },   // 0x14
+    { 3, { 0x31, 0x51, 0x71, 0x00 } },   // 0x15
+    { 2, { 0x31, 0x52, 0x00, 0x00 } },   // 0x16
+    { 2, { 0x31, 0x53, 0x00, 0x00 } },   // 0x17
+    { 1, { 0x32, 0x00, 0x00, 0x00 } },   // 0x18
+    { 2, { 0x32, 0x71, 0x00, 0x00 } },   // 0x19
+    { 2, { 0x32, 0x61, 0x00, 0x00 } },   // 0x1A
+    { 2, { 0x32, 0x62, 0x00, 0x00 } },   // 0x1B
+    { 1, { 0x33, 0x00, 0x00, 0x00 } },   // 0x1C
+    { 2, { 0x33, 0x71, 0x00, 0x00 } },   // 0x1D
+    { 1, { 0x34, 0x00, 0x00, 0x00 } },   // 0x1E
+    { 1, { 0x35, 0x00, 0x00, 0x00 } },   // 0x1F
+    { 1, { 0x21, 0x00, 0x00, 0x00 } },   // 0x20
+    { 2, { 0x21, 0x71, 0x00, 0x00 } },   // 0x21
+    { 2, { 0x21, 0x61, 0x00, 0x00 } },   // 0x22
+    { 2, { 0x21, 0x62, 0x00, 0x00 } },   // 0x23
+    { 2, { 0x21, 0x51, 0x00, 0x00 } },   // 0x24
+    { 3, { 0x21, 0x51, 0x71, 0x00 } },   // 0x25
+    { 2, { 0x21, 0x52, 0x00, 0x00 } },   // 0x26
+    { 2, { 0x21, 0x53, 0x00, 0x00 } },   // 0x27
+    { 2, { 0x21, 0x41, 0x00, 0x00 } },   // 0x28
+    { 3, { 0x21, 0x41, 0x71, 0x00 } },   // 0x29
+    { 3, { 0x21, 0x41, 0x61, 0x00 } },   // 0x2A
+    { 3, { 0x21, 0x41, 0x62, 0x00 } },   // 0x2B
+    { 2, { 0x21, 0x42, 0x00, 0x00 } },   // 0x2C
+    { 3, { 0x21, 0x42, 0x71, 0x00 } },   // 0x2D
+    { 2, { 0x21, 0x43, 0x00, 0x00 } },   // 0x2E
+    { 2, { 0x21, 0x44, 0x00, 0x00 } },   // 0x2F
+    { 1, { 0x22, 0x00, 0x00, 0x00 } },   // 0x30
+    { 2, { 0x22, 0x71, 0x00, 0x00 } },   // 0x31
+    { 2, { 0x22, 0x61, 0x00, 0x00 } },   // 0x32
+    { 2, { 0x22, 0x62, 0x00, 0x00 } },   // 0x33
+    { 2, { 0x22, 0x51, 0x00, 0x00 } },   // 0x34
+    { 3, { 0x22, 0x51, 0x71, 0x00 } },   // 0x35
+    { 2, { 0x22, 0x52, 0x00, 0x00 } },   // 0x36
+    { 2, { 0x22, 0x53, 0x00, 0x00 } },   // 0x37
+    { 1, { 0x23, 0x00, 0x00, 0x00 } },   // 0x38
+    { 2, { 0x23, 0x71, 0x00, 0x00 } },   // 0x39
+    { 2, { 0x23, 0x61, 0x00, 0x00 } },   // 0x3A
+    { 2, { 0x23, 0x62, 0x00, 0x00 } },   // 0x3B
+    { 1, { 0x24, 0x00, 0x00, 0x00 } },   // 0x3C
+    { 2, { 0x24, 0x71, 0x00, 0x00 } },   // 0x3D
+    { 1, { 0x25, 0x00, 0x00, 0x00 } },   // 0x3E
+    { 1, { 0x26, 0x00, 0x00, 0x00 } },   // 0x3F
+    { 1, { 0x11, 0x00, 0x00, 0x00 } },   // 0x40
+    { 2, { 0x11, 0x71, 0x00, 0x00 } },   // 0x41
+    { 2, { 0x11, 0x61, 0x00, 0x00 } },   // 0x42
+    { 2, { 0x11, 0x62, 0x00, 0x00 } },   // 0x43
+    { 2, { 0x11, 0x51, 0x00, 0x00 } },   // 0x44
+    { 3, { 0x11, 0x51, 0x71, 0x00 } },   // 0x45
+    { 2, { 0x11, 0x52, 0x00, 0x00 } },   // 0x46
+    { 2, { 0x11, 0x53, 0x00, 0x00 } },   // 0x47
+    { 2, { 0x11, 0x41, 0x00, 0x00 } },   // 0x48
+    { 3, { 0x11, 0x41, 0x71, 0x00 } },   // 0x49
+    { 3, { 0x11, 0x41, 0x61, 0x00 } },   // 0x4A
+    { 3, { 0x11, 0x41, 0x62, 0x00 } },   // 0x4B
+    { 2, { 0x11, 0x42, 0x00, 0x00 } },   // 0x4C
+    { 3, { 0x11, 0x42, 0x71, 0x00 } },   // 0x4D
+    { 2, { 0x11, 0x43, 0x00, 0x00 } },   // 0x4E
+    { 2, { 0x11, 0x44, 0x00, 0x00 } },   // 0x4F
+    { 2, { 0x11, 0x31, 0x00, 0x00 } },   // 0x50
+    { 3, { 0x11, 0x31, 0x71, 0x00 } },   // 0x51
+    { 3, { 0x11, 0x31, 0x61, 0x00 } },   // 0x52
+    { 3, { 0x11, 0x31, 0x62, 0x00 } },   // 0x53
+    { 3, { 0x11, 0x31, 0x51, 0x00 } },   // 0x54
+    { 4, { 0x11, 0x31, 0x51, 0x71 } },   // 0x55
+    { 3, { 0x11, 0x31, 0x52, 0x00 } },   // 0x56
+    { 3, { 0x11, 0x31, 0x53, 0x00 } },   // 0x57
+    { 2, { 0x11, 0x32, 0x00, 0x00 } },   // 0x58
+    { 3, { 0x11, 0x32, 0x71, 0x00 } },   // 0x59
+    { 3, { 0x11, 0x32, 0x61, 0x00 } },   // 0x5A
+    { 3, { 0x11, 0x32, 0x62, 0x00 } },   // 0x5B
+    { 2, { 0x11, 0x33, 0x00, 0x00 } },   // 0x5C
+    { 3, { 0x11, 0x33, 0x71, 0x00 } },   // 0x5D
+    { 2, { 0x11, 0x34, 0x00, 0x00 } },   // 0x5E
+    { 2, { 0x11, 0x35, 0x00, 0x00 } },   // 0x5F
+    { 1, { 0x12, 0x00, 0x00, 0x00 } },   // 0x60
+    { 2, { 0x12, 0x71, 0x00, 0x00 } },   // 0x61
+    { 2, { 0x12, 0x61, 0x00, 0x00 } },   // 0x62
+    { 2, { 0x12, 0x62, 0x00, 0x00 } },   // 0x63
+    { 2, { 0x12, 0x51, 0x00, 0x00 } },   // 0x64
+    { 3, { 0x12, 0x51, 0x71, 0x00 } },   // 0x65
+    { 2, { 0x12, 0x52, 0x00, 0x00 } },   // 0x66
+    { 2, { 0x12, 0x53, 0x00, 0x00 } },   // 0x67
+    { 2, { 0x12, 0x41, 0x00, 0x00 } },   // 0x68
+    { 3, { 0x12, 0x41, 0x71, 0x00 } },   // 0x69
+    { 3, { 0x12, 0x41, 0x61, 0x00 } },   // 0x6A
+    { 3, { 0x12, 0x41, 0x62, 0x00 } },   // 0x6B
+    { 2, { 0x12, 0x42, 0x00, 0x00 } },   // 0x6C
+    { 3, { 0x12, 0x42, 0x71, 0x00 } },   // 0x6D
+    { 2, { 0x12, 0x43, 0x00, 0x00 } },   // 0x6E
+    { 2, { 0x12, 0x44, 0x00, 0x00 } },   // 0x6F
+    { 1, { 0x13, 0x00, 0x00, 0x00 } },   // 0x70
+    { 2, { 0x13, 0x71, 0x00, 0x00 } },   // 0x71
+    { 2, { 0x13, 0x61, 0x00, 0x00 } },   // 0x72
+    { 2, { 0x13, 0x62, 0x00, 0x00 } },   // 0x73
+    { 2, { 0x13, 0x51, 0x00, 0x00 } },   // 0x74
+    { 3, { 0x13, 0x51, 0x71, 0x00 } },   // 0x75
+    { 2, { 0x13, 0x52, 0x00, 0x00 } },   // 0x76
+    { 2, { 0x13, 0x53, 0x00, 0x00 } },   // 0x77
+    { 1, { 0x14, 0x00, 0x00, 0x00 } },   // 0x78
+    { 2, { 0x14, 0x71, 0x00, 0x00 } },   // 0x79
+    { 2, { 0x14, 0x61, 0x00, 0x00 } },   // 0x7A
+    { 2, { 0x14, 0x62, 0x00, 0x00 } },   // 0x7B
+    { 1, { 0x15, 0x00, 0x00, 0x00 } },   // 0x7C
+    { 2, { 0x15, 0x71, 0x00, 0x00 } },   // 0x7D
+    { 1, { 0x16, 0x00, 0x00, 0x00 } },   // 0x7E
+    { 1, { 0x17, 0x00, 0x00, 0x00 } },   // 0x7F
+    { 1, { 0x01, 0x00, 0x00, 0x00 } },   // 0x80
+    { 2, { 0x01, 0x71, 0x00, 0x00 } },   // 0x81
+    { 2, { 0x01, 0x61, 0x00, 0x00 } },   // 0x82
+    { 2, { 0x01, 0x62, 0x00, 0x00 } },   // 0x83
+    { 2, { 0x01, 0x51, 0x00, 0x00 } },   // 0x84
+    { 3, { 0x01, 0x51, 0x71, 0x00 } },   // 0x85
+    { 2, { 0x01, 0x52, 0x00, 0x00 } },   // 0x86
+    { 2, { 0x01, 0x53, 0x00, 0x00 } },   // 0x87
+    { 2, { 0x01, 0x41, 0x00, 0x00 } },   // 0x88
+    { 3, { 0x01, 0x41, 0x71, 0x00 } },   // 0x89
+    { 3, { 0x01, 0x41, 0x61, 0x00 } },   // 0x8A
+    { 3, { 0x01, 0x41, 0x62, 0x00 } },   // 0x8B
+    { 2, { 0x01, 0x42, 0x00, 0x00 } },   // 0x8C
+    { 3, { 0x01, 0x42, 0x71, 0x00 } },   // 0x8D
+    { 2, { 0x01, 0x43, 0x00, 0x00 } },   // 0x8E
+    { 2, { 0x01, 0x44, 0x00, 0x00 } },   // 0x8F
+    { 2, { 0x01, 0x31, 0x00, 0x00 } },   // 0x90
+    { 3, { 0x01, 0x31, 0x71, 0x00 } },   // 0x91
+    { 3, { 0x01, 0x31, 0x61, 0x00 } },   // 0x92
+    { 3, { 0x01, 0x31, 0x62, 0x00 } },   // 0x93
+    { 3, { 0x01, 0x31, 0x51, 0x00 } },   // 0x94
+    { 4, { 0x01, 0x31, 0x51, 0x71 } },   // 0x95
+    { 3, { 0x01, 0x31, 0x52, 0x00 } },   // 0x96
+    { 3, { 0x01, 0x31, 0x53, 0x00 } },   // 0x97
+    { 2, { 0x01, 0x32, 0x00, 0x00 } },   // 0x98
+    { 3, { 0x01, 0x32, 0x71, 0x00 } },   // 0x99
+    { 3, { 0x01, 0x32, 0x61, 0x00 } },   // 0x9A
+    { 3, { 0x01, 0x32, 0x62, 0x00 } },   // 0x9B
+    { 2, { 0x01, 0x33, 0x00, 0x00 } },   // 0x9C
+    { 3, { 0x01, 0x33, 0x71, 0x00 } },   // 0x9D
+    { 2, { 0x01, 0x34, 0x00, 0x00 } },   // 0x9E
+    { 2, { 0x01, 0x35, 0x00, 0x00 } },   // 0x9F
+    { 2, { 0x01, 0x21, 0x00, 0x00 } },   // 0xA0
+    { 3, { 0x01, 0x21, 0x71, 0x00 } },   // 0xA1
+    { 3, { 0x01, 0x21, 0x61, 0x00 } },   // 0xA2
+    { 3, { 0x01, 0x21, 0x62, 0x00 } },   // 0xA3
+    { 3, { 0x01, 0x21, 0x51, 0x00 } },   // 0xA4
+    { 4, { 0x01, 0x21, 0x51, 0x71 } },   // 0xA5
+    { 3, { 0x01, 0x21, 0x52, 0x00 } },   // 0xA6
+    { 3, { 0x01, 0x21, 0x53, 0x00 } },   // 0xA7
+    { 3, { 0x01, 0x21, 0x41, 0x00 } },   // 0xA8
+    { 4, { 0x01, 0x21, 0x41, 0x71 } },   // 0xA9
+    { 4, { 0x01, 0x21, 0x41, 0x61 } },   // 0xAA
+    { 4, { 0x01, 0x21, 0x41, 0x62 } },   // 0xAB
+    { 3, { 0x01, 0x21, 0x42, 0x00 } },   // 0xAC
+    { 4, { 0x01, 0x21, 0x42, 0x71 } },   // 0xAD
+    { 3, { 0x01, 0x21, 0x43, 0x00 } },   // 0xAE
+    { 3, { 0x01, 0x21, 0x44, 0x00 } },   // 0xAF
+    { 2, { 0x01, 0x22, 0x00, 0x00 } },   // 0xB0
+    { 3, { 0x01, 0x22, 0x71, 0x00 } },   // 0xB1
+    { 3, { 0x01, 0x22, 0x61, 0x00 } },   // 0xB2
+    { 3, { 0x01, 0x22, 0x62, 0x00 } },   // 0xB3
+    { 3, { 0x01, 0x22, 0x51, 0x00 } },   // 0xB4
+    { 4, { 0x01, 0x22, 0x51, 0x71 } },   // 0xB5
+    { 3, { 0x01, 0x22, 0x52, 0x00 } },   // 0xB6
+    { 3, { 0x01, 0x22, 0x53, 0x00 } },   // 0xB7
+    { 2, { 0x01, 0x23, 0x00, 0x00 } },   // 0xB8
+    { 3, { 0x01, 0x23, 0x71, 0x00 } },   // 0xB9
+    { 3, { 0x01, 0x23, 0x61, 0x00 } },   // 0xBA
+    { 3, { 0x01, 0x23, 0x62, 0x00 } },   // 0xBB
+    { 2, { 0x01, 0x24, 0x00, 0x00 } },   // 0xBC
+    { 3, { 0x01, 0x24, 0x71, 0x00 } },   // 0xBD
+    { 2, { 0x01, 0x25, 0x00, 0x00 } },   // 0xBE
+    { 2, { 0x01, 0x26, 0x00, 0x00 } },   // 0xBF
+    { 1, { 0x02, 0x00, 0x00, 0x00 } },   // 0xC0
+    { 2, { 0x02, 0x71, 0x00, 0x00 } },   // 0xC1
+    { 2, { 0x02, 0x61, 0x00, 0x00 } },   // 0xC2
+    { 2, { 0x02, 0x62, 0x00, 0x00 } },   // 0xC3
+    { 2, { 0x02, 0x51, 0x00, 0x00 } },   // 0xC4
+    { 3, { 0x02, 0x51, 0x71, 0x00 } },   // 0xC5
+    { 2, { 0x02, 0x52, 0x00, 0x00 } },   // 0xC6
+    { 2, { 0x02, 0x53, 0x00, 0x00 } },   // 0xC7
+    { 2, { 0x02, 0x41, 0x00, 0x00 } },   // 0xC8
+    { 3, { 0x02, 0x41, 0x71, 0x00 } },   // 0xC9
+    { 3, { 0x02, 0x41, 0x61, 0x00 } },   // 0xCA
+    { 3, { 0x02, 0x41, 0x62, 0x00 } },   // 0xCB
+    { 2, { 0x02, 0x42, 0x00, 0x00 } },   // 0xCC
+    { 3, { 0x02, 0x42, 0x71, 0x00 } },   // 0xCD
+    { 2, { 0x02, 0x43, 0x00, 0x00 } },   // 0xCE
+    { 2, { 0x02, 0x44, 0x00, 0x00 } },   // 0xCF
+    { 2, { 0x02, 0x31, 0x00, 0x00 } },   // 0xD0
+    { 3, { 0x02, 0x31, 0x71, 0x00 } },   // 0xD1
+    { 3, { 0x02, 0x31, 0x61, 0x00 } },   // 0xD2
+    { 3, { 0x02, 0x31, 0x62, 0x00 } },   // 0xD3
+    { 3, { 0x02, 0x31, 0x51, 0x00 } },   // 0xD4
+    { 4, { 0x02, 0x31, 0x51, 0x71 } },   // 0xD5
+    { 3, { 0x02, 0x31, 0x52, 0x00 } },   // 0xD6
+    { 3, { 0x02, 0x31, 0x53, 0x00 } },   // 0xD7
+    { 2, { 0x02, 0x32, 0x00, 0x00 } },   // 0xD8
+    { 3, { 0x02, 0x32, 0x71, 0x00 } },   // 0xD9
+    { 3, { 0x02, 0x32, 0x61, 0x00 } },   // 0xDA
+    { 3, { 0x02, 0x32, 0x62, 0x00 } },   // 0xDB
+    { 2, { 0x02, 0x33, 0x00, 0x00 } },   // 0xDC
+    { 3, { 0x02, 0x33, 0x71, 0x00 } },   // 0xDD
+    { 2, { 0x02, 0x34, 0x00, 0x00 } },   // 0xDE
+    { 2, { 0x02, 0x35, 0x00, 0x00 } },   // 0xDF
+    { 1, { 0x03, 0x00, 0x00, 0x00 } },   // 0xE0
+    { 2, { 0x03, 0x71, 0x00, 0x00 } },   // 0xE1
+    { 2, { 0x03, 0x61, 0x00, 0x00 } },   // 0xE2
+    { 2, { 0x03, 0x62, 0x00, 0x00 } },   // 0xE3
+    { 2, { 0x03, 0x51, 0x00, 0x00 } },   // 0xE4
+    { 3, { 0x03, 0x51, 0x71, 0x00 } },   // 0xE5
+    { 2, { 0x03, 0x52, 0x00, 0x00 } },   // 0xE6
+    { 2, { 0x03, 0x53, 0x00, 0x00 } },   // 0xE7
+    { 2, { 0x03, 0x41, 0x00, 0x00 } },   // 0xE8
+    { 3, { 0x03, 0x41, 0x71, 0x00 } },   // 0xE9
+    { 3, { 0x03, 0x41, 0x61, 0x00 } },   // 0xEA
+    { 3, { 0x03, 0x41, 0x62, 0x00 } },   // 0xEB
+    { 2, { 0x03, 0x42, 0x00, 0x00 } },   // 0xEC
+    { 3, { 0x03, 0x42, 0x71, 0x00 } },   // 0xED
+    { 2, { 0x03, 0x43, 0x00, 0x00 } },   // 0xEE
+    { 2, { 0x03, 0x44, 0x00, 0x00 } },   // 0xEF
+    { 1, { 0x04, 0x00, 0x00, 0x00 } },   // 0xF0
+    { 2, { 0x04, 0x71, 0x00, 0x00 } },   // 0xF1
+    { 2, { 0x04, 0x61, 0x00, 0x00 } },   // 0xF2
+    { 2, { 0x04, 0x62, 0x00, 0x00 } },   // 0xF3
+    { 2, { 0x04, 0x51, 0x00, 0x00 } },   // 0xF4
+    { 3, { 0x04, 0x51, 0x71, 0x00 } },   // 0xF5
+    { 2, { 0x04, 0x52, 0x00, 0x00 } },   // 0xF6
+    { 2, { 0x04, 0x53, 0x00, 0x00 } },   // 0xF7
+    { 1, { 0x05, 0x00, 0x00, 0x00 } },   // 0xF8
+    { 2, { 0x05, 0x71, 0x00, 0x00 } },   // 0xF9
+    { 2, { 0x05, 0x61, 0x00, 0x00 } },   // 0xFA
+    { 2, { 0x05, 0x62, 0x00, 0x00 } },   // 0xFB
+    { 1, { 0x06, 0x00, 0x00, 0x00 } },   // 0xFC
+    { 2, { 0x06, 0x71, 0x00, 0x00 } },   // 0xFD
+    { 1, { 0x07, 0x00, 0x00, 0x00 } },   // 0xFE
+    { 1, { 0x08, 0x00, 0x00, 0x00 } },   // 0xFF
+};
+
+// Bit 0 is the leftmost pixel (font8x8)
+const tft_bit_runs_t tft_bit_runs_lsb[256] = {
+    { 0, { 0x00, 0x00, 0x00, 0x00 } },   // 0x00
+    { 1, { 0x01, 0x00, 0x00, 0x00 } },   // 0x01
+    { 1, { 0x11, 0x00, 0x00, 0x00 } },   // 0x02
+    { 1, { 0x02, 0x00, 0x00, 0x00 } },   // 0x03
+    { 1, { 0x21, 0x00, 0x00, 0x00 } },   // 0x04
+    { 2, { 0x01, 0x21, 0x00, 0x00 } },   // 0x05
+    { 1, { 0x12, 0x00, 0x00, 0x00 } },   // 0x06
+    { 1, { 0x03, 0x00, 0x00, 0x00 } },   // 0x07
+    { 1, { 0x31, 0x00, 0x00, 0x00 } },   // 0x08
+    { 2, { 0x01, 0x31, 0x00, 0x00 } },   // 0x09
+    { 2, { 0x11, 0x31, 0x00, 0x00 } },   // 0x0A
+    { 2, { 0x02, 0x31, 0x00, 0x00 } },   // 0x0B
+    { 1, { 0x22, 0x00, 0x00, 0x00 } },   // 0x0C
+    { 2, { 0x01, 0x22, 0x00, 0x00 } },   // 0x0D
+    { 1, { 0x13, 0x00, 0x00, 0x00 } },   // 0x0E
+    { 1, { 0x04, 0x00, 0x00, 0x00 } },   // 0x0F
+    { 1, { 0x41, 0x00, 0x00, 0x00 } },   // 0x10
+    { 2, { 0x01, 0x41, 0x00, 0x00 } },   // 0x11
+    { 2, { 0x11, 0x41, 0x00, 0x00 } },   // 0x12
+    { 2, { 0x02, 0x41, 0x00, 0x00 } },   // 0x13
+    { 2, { 0x21, 0x41, 0x00, 0x00 } },   // 0x14
+    { 3, { 0x01, 0x21, 0x41, 0x00 } },   // 0x15
+    { 2, { 0x12, 0x41, 0x00, 0x00 } },   // 0x16
+    { 2, { 0x03, 0x41, 0x00, 0x00 } },   // 0x17
+    { 1, { 0x32, 0x00, 0x00, 0x00 } },   // 0x18
+    { 2, { 0x01, 0x32, 0x00, 0x00 } },   // 0x19
+    { 2, { 0x11, 0x32, 0x00, 0x00 } },   // 0x1A
+    { 2, { 0x02, 0x32, 0x00, 0x00 } },   // 0x1B
+    { 1, { 0x23, 0x00, 0x00, 0x00 } },   // 0x1C
+    { 2, { 0x01, 0x23, 0x00, 0x00 } },   // 0x1D
+    { 1, { 0x14, 0x00, 0x00, 0x00 } },   // 0x1E
+    { 1, { 0x05, 0x00, 0x00, 0x00 } },   // 0x1F
+    { 1, { 0x51, 0x00, 0x00, 0x00 } },   // 0x20
+    { 2, { 0x01, 0x51, 0x00, 0x00 } },   // 0x21
+    { 2, { 0x11, 0x51, 0x00, 0x00 } },   // 0x22
+    { 2, { 0x02, 0x51, 0x00, 0x00 } },   // 0x23
+    { 2, { 0x21, 0x51, 0x00, 0x00 } },   // 0x24
+    { 3, { 0x01, 0x21, 0x51, 0x00 } },   // 0x25
+    { 2, { 0x12, 0x51, 0x00, 0x00 } },   // 0x26
+    { 2, { 0x03, 0x51, 0x00, 0x00 } },   // 0x27
+    { 2, { 0x31, 0x51, 0x00, 0x00 } },   // 0x28
+    { 3, { 0x01, 0x31, 0x51, 0x00 } },   // 0x29
+    { 3, { 0x11, 0x31, 0x51, 0x00 } },   // 0x2A
+    { 3, { 0x02, 0x31, 0x51, 0x00 } },   // 0x2B
+    { 2, { 0x22, 0x51, 0x00, 0x00 } },   // 0x2C
+    { 3, { 0x01, 0x22, 0x51, 0x00 } },   // 0x2D
+    { 2, { 0x13, 0x51, 0x00, 0x00 } },   // 0x2E
+    { 2, { 0x04, 0x51, 0x00, 0x00 } },   // 0x2F
+    { 1, { 0x42, 0x00, 0x00, 0x00 } },   // 0x30
+    { 2, { 0x01, 0x42, 0x00, 0x00 } },   // 0x31
+    { 2, { 0x11, 0x42, 0x00, 0x00 } },   // 0x32
+    { 2, { 0x02, 0x42, 0x00, 0x00 } },   // 0x33
+    { 2, { 0x21, 0x42, 0x00, 0x00 } },   // 0x34
+    { 3, { 0x01, 0x21, 0x42, 0x00 } },   // 0x35
+    { 2, { 0x12, 0x42, 0x00, 0x00 } },   // 0x36
+    { 2, { 0x03, 0x42, 0x00, 0x00 } },   // 0x37
+    { 1, { 0x33, 0x00, 0x00, 0x00 } },   // 0x38
+    { 2, { 0x01, 0x33, 0x00, 0x00 } },   // 0x39
+    { 2, { 0x11, 0x33, 0x00, 0x00 } },   // 0x3A
+    { 2, { 0x02, 0x33, 0x00, 0x00 } },   // 0x3B
+    { 1, { 0x24, 0x00, 0x00, 0x00 } },   // 0x3C
+    { 2, { 0x01, 0x24, 0x00, 0x00 } },   // 0x3D
+    { 1, { 0x15, 0x00, 0x00, 0x00 } },   // 0x3E
+    { 1, { 0x06, 0x00, 0x00, 0x00 } },   // 0x3F
+    { 1, { 0x61, 0x00, 0x00, 0x00 } },   // 0x40
+    { 2, { 0x01, 0x61, 0x00, 0x00 } },   // 0x41
+    { 2, { 0x11, 0x61, 0x00, 0x00 } },   // 0x42
+    { 2, { 0x02, 0x61, 0x00, 0x00 } },   // 0x43
+    { 2, { 0x21, 0x61, 0x00, 0x00 } },   // 0x44
+    { 3, { 0x01, 0x21, 0x61, 0x00 } },   // 0x45
+    { 2, { 0x12, 0x61, 0x00, 0x00 } },   // 0x46
+    { 2, { 0x03, 0x61, 0x00, 0x00 } },   // 0x47
+    { 2, { 0x31, 0x61, 0x00, 0x00 } },   // 0x48
+    { 3, { 0x01, 0x31, 0x61, 0x00 } },   // 0x49
+    { 3, { 0x11, 0x31, 0x61, 0x00 } },   // 0x4A
+    { 3, { 0x02, 0x31, 0x61, 0x00 } },   // 0x4B
+    { 2, { 0x22, 0x61, 0x00, 0x00 } },   // 0x4C
+    { 3, { 0x01, 0x22, 0x61, 0x00 } },   // 0x4D
+    { 2, { 0x13, 0x61, 0x00, 0x00 } },   // 0x4E
+    { 2, { 0x04, 0x61, 0x00, 0x00 } },   // 0x4F
+    { 2, { 0x41, 0x61, 0x00, 0x00 } },   // 0x50
+    { 3, { 0x01, 0x41, 0x61, 0x00 } },   // 0x51
+    { 3, { 0x11, 0x41, 0x61, 0x00 } },   // 0x52
+    { 3, { 0x02, 0x41, 0x61, 0x00 } },   // 0x53
+    { 3, { 0x21, 0x41, 0x61, 0x00 } },   // 0x54
+    { 4, { 0x01, 0x21, 0x41, 0x61 } },   // 0x55
+    { 3, { 0x12, 0x41, 0x61, 0x00 } },   // 0x56
+    { 3, { 0x03, 0x41, 0x61, 0x00 } },   // 0x57
+    { 2, { 0x32, 0x61, 0x00, 0x00 } },   // 0x58
+    { 3, { 0x01, 0x32, 0x61, 0x00 } },   // 0x59
+    { 3, { 0x11, 0x32, 0x61, 0x00 } },   // 0x5A
+    { 3, { 0x02, 0x32, 0x61, 0x00 } },   // 0x5B
+    { 2, { 0x23, 0x61, 0x00, 0x00 } },   // 0x5C
+    { 3, { 0x01, 0x23, 0x61, 0x00 } },   // 0x5D
+    { 2, { 0x14, 0x61, 0x00, 0x00 } },   // 0x5E
+    { 2, { 0x05, 0x61, 0x00, 0x00 } },   // 0x5F
+    { 1, { 0x52, 0x00, 0x00, 0x00 } },   // 0x60
+    { 2, { 0x01, 0x52, 0x00, 0x00 } },   // 0x61
+    { 2, { 0x11, 0x52, 0x00, 0x00 } },   // 0x62
+    { 2, { 0x02, 0x52, 0x00, 0x00 } },   // 0x63
+    { 2, { 0x21, 0x52, 0x00, 0x00 } },   // 0x64
+    { 3, { 0x01, 0x21, 0x52, 0x00 } },   // 0x65
+    { 2, { 0x12, 0x52, 0x00, 0x00 } },   // 0x66
+    { 2, { 0x03, 0x52, 0x00, 0x00 } },   // 0x67
+    { 2, { 0x31, 0x52, 0x00, 0x00 } },   // 0x68
+    { 3, { 0x01, 0x31, 0x52, 0x00 } },   // 0x69
+    { 3, { 0x11, 0x31, 0x52, 0x00 } },   // 0x6A
+    { 3, { 0x02, 0x31, 0x52, 0x00 } },   // 0x6B
+    { 2, { 0x22, 0x52, 0x00, 0x00 } },   // 0x6C
+    { 3, { 0x01, 0x22, 0x52, 0x00 } },   // 0x6D
+    { 2, { 0x13, 0x52, 0x00, 0x00 } },   // 0x6E
+    { 2, { 0x04, 0x52, 0x00, 0x00 } },   // 0x6F
+    { 1, { 0x43, 0x00, 0x00, 0x00 } },   // 0x70
+    { 2, { 0x01, 0x43, 0x00, 0x00 } },   // 0x71
+    { 2, { 0x11, 0x43, 0x00, 0x00 } },   // 0x72
+    { 2, { 0x02, 0x43, 0x00, 0x00 } },   // 0x73
+    { 2, { 0x21, 0x43, 0x00, 0x00 } },   // 0x74
+    { 3, { 0x01, 0x21, 0x43, 0x00 } },   // 0x75
+    { 2, { 0x12, 0x43, 0x00, 0x00 } },   // 0x76
+    { 2, { 0x03, 0x43, 0x00, 0x00 } },   // 0x77
+    { 1, { 0x34, 0x00, 0x00, 0x00 } },   // 0x78
+    { 2, { 0x01, 0x34, 0x00, 0x00 } },   // 0x79
+    { 2, { 0x11, 0x34, 0x00, 0x00 } },   // 0x7A
+    { 2, { 0x02, 0x34, 0x00, 0x00 } },   // 0x7B
+    { 1, { 0x25, 0x00, 0x00, 0x00 } },   // 0x7C
+    { 2, { 0x01, 0x25, 0x00, 0x00 } },   // 0x7D
+    { 1, { 0x16, 0x00, 0x00, 0x00 } },   // 0x7E
+    { 1, { 0x07, 0x00, 0x00, 0x00 } },   // 0x7F
+    { 1, { 0x71, 0x00, 0x00, 0x00 } },   // 0x80
+    { 2, { 0x01, 0x71, 0x00, 0x00 } },   // 0x81
+    { 2, { 0x11, 0x71, 0x00, 0x00 } },   // 0x82
+    { 2, { 0x02, 0x71, 0x00, 0x00 } },   // 0x83
+    { 2, { 0x21, 0x71, 0x00, 0x00 } },   // 0x84
+    { 3, { 0x01, 0x21, 0x71, 0x00 } },   // 0x85
+    { 2, { 0x12, 0x71, 0x00, 0x00 } },   // 0x86
+    { 2, { 0x03, 0x71, 0x00, 0x00 } },   // 0x87
+    { 2, { 0x31, 0x71, 0x00, 0x00 } },   // 0x88
+    { 3, { 0x01, 0x31, 0x71, 0x00 } },   // 0x89
+    { 3, { 0x11, 0x31, 0x71, 0x00 } },   // 0x8A
+    { 3, { 0x02, 0x31, 0x71, 0x00 } },   // 0x8B
+    { 2, { 0x22, 0x71, 0x00, 0x00 } },   // 0x8C
+    { 3, { 0x01, 0x22, 0x71, 0x00 } },   // 0x8D
+    { 2, { 0x13, 0x71, 0x00, 0x00 } },   // 0x8E
+    { 2, { 0x04, 0x71, 0x00, 0x00 } },   // 0x8F
+    { 2, { 0x41, 0x71, 0x00, 0x00 } },   // 0x90
+    { 3, { 0x01, 0x41, 0x71, 0x00 } },   // 0x91
+    { 3, { 0x11, 0x41, 0x71, 0x00 } },   // 0x92
+    { 3, { 0x02, 0x41, 0x71, 0x00 } },   // 0x93
+    { 3, { 0x21, 0x41, 0x71, 0x00 } },   // 0x94
+    { 4, { 0x01, 0x21, 0x41, 0x71 } },   // 0x95
+    { 3, { 0x12, 0x41, 0x71, 0x00 } },   // 0x96
+    { 3, { 0x03, 0x41, 0x71, 0x00 } },   // 0x97
+    { 2, { 0x32, 0x71, 0x00, 0x00 } },   // 0x98
+    { 3, { 0x01, 0x32, 0x71, 0x00 } },   // 0x99
+    { 3, { 0x11, 0x32, 0x71, 0x00 } },   // 0x9A
+    { 3, { 0x02, 0x32, 0x71, 0x00 } },   // 0x9B
+    { 2, { 0x23, 0x71, 0x00, 0x00 } },   // 0x9C
+    { 3, { 0x01, 0x23, 0x71, 0x00 } },   // 0x9D
+    { 2, { 0x14, 0x71, 0x00, 0x00 } },   // 0x9E
+    { 2, { 0x05, 0x71, 0x00, 0x00 } },   // 0x9F
+    { 2, { 0x51, 0x71, 0x00, 0x00 } },   // 0xA0
+    { 3, { 0x01, 0x51, 0x71, 0x00 } },   // 0xA1
+    { 3, { 0x11, 0x51, 0x71, 0x00 } },   // 0xA2
+    { 3, { 0x02, 0x51, 0x71, 0x00 } },   // 0xA3
+    { 3, { 0x21, 0x51, 0x71, 0x00 } },   // 0xA4
+    { 4, { 0x01, 0x21, 0x51, 0x71 } },   // 0xA5
+    { 3, { 0x12, 0x51, 0x71, 0x00 } },   // 0xA6
+    { 3, { 0x03, 0x51, 0x71, 0x00 } },   // 0xA7
+    { 3, { 0x31, 0x51, 0x71, 0x00 } },   // 0xA8
+    { 4, { 0x01, 0x31, 0x51, 0x71 } },   // 0xA9
+    { 4, { 0x11, 0x31, 0x51, 0x71 } },   // 0xAA
+    { 4, { 0x02, 0x31, 0x51, 0x71 } },   // 0xAB
+    { 3, { 0x22, 0x51, 0x71, 0x00 } },   // 0xAC
+    { 4, { 0x01, 0x22, 0x51, 0x71 } },   // 0xAD
+    { 3, { 0x13, 0x51, 0x71, 0x00 } },   // 0xAE
+    { 3, { 0x04, 0x51, 0x71, 0x00 } },   // 0xAF
+    { 2, { 0x42, 0x71, 0x00, 0x00 } },   // 0xB0
+    { 3, { 0x01, 0x42, 0x71, 0x00 } },   // 0xB1
+    { 3, { 0x11, 0x42, 0x71, 0x00 } },   // 0xB2
+    { 3, { 0x02, 0x42, 0x71, 0x00 } },   // 0xB3
+    { 3, { 0x21, 0x42, 0x71, 0x00 } },   // 0xB4
+    { 4, { 0x01, 0x21, 0x42, 0x71 } },   // 0xB5
+    { 3, { 0x12, 0x42, 0x71, 0x00 } },   // 0xB6
+    { 3, { 0x03, 0x42, 0x71, 0x00 } },   // 0xB7
+    { 2, { 0x33, 0x71, 0x00, 0x00 } },   // 0xB8
+    { 3, { 0x01, 0x33, 0x71, 0x00 } },   // 0xB9
+    { 3, { 0x11, 0x33, 0x71, 0x00 } },   // 0xBA
+    { 3, { 0x02, 0x33, 0x71, 0x00 } },   // 0xBB
+    { 2, { 0x24, 0x71, 0x00, 0x00 } },   // 0xBC
+    { 3, { 0x01, 0x24, 0x71, 0x00 } },   // 0xBD
+    { 2, { 0x15, 0x71, 0x00, 0x00 } },   // 0xBE
+    { 2, { 0x06, 0x71, 0x00, 0x00 } },   // 0xBF
+    { 1, { 0x62, 0x00, 0x00, 0x00 } },   // 0xC0
+    { 2, { 0x01, 0x62, 0x00, 0x00 } },   // 0xC1
+    { 2, { 0x11, 0x62, 0x00, 0x00 } },   // 0xC2
+    { 2, { 0x02, 0x62, 0x00, 0x00 } },   // 0xC3
+    { 2, { 0x21, 0x62, 0x00, 0x00 } },   // 0xC4
+    { 3, { 0x01, 0x21, 0x62, 0x00 } },   // 0xC5
+    { 2, { 0x12, 0x62, 0x00, 0x00 } },   // 0xC6
+    { 2, { 0x03, 0x62, 0x00, 0x00 } },   // 0xC7
+    { 2, { 0x31, 0x62, 0x00, 0x00 } },   // 0xC8
+    { 3, { 0x01, 0x31, 0x62, 0x00 } },   // 0xC9
+    { 3, { 0x11, 0x31, 0x62, 0x00 } },   // 0xCA
+    { 3, { 0x02, 0x31, 0x62, 0x00 } },   // 0xCB
+    { 2, { 0x22, 0x62, 0x00, 0x00 } },   // 0xCC
+    { 3, { 0x01, 0x22, 0x62, 0x00 } },   // 0xCD
+    { 2, { 0x13, 0x62, 0x00, 0x00 } },   // 0xCE
+    { 2, { 0x04, 0x62, 0x00, 0x00 } },   // 0xCF
+    { 2, { 0x41, 0x62, 0x00, 0x00 } },   // 0xD0
+    { 3, { 0x01, 0x41, 0x62, 0x00 } },   // 0xD1
+    { 3, { 0x11, 0x41, 0x62, 0x00 } },   // 0xD2
+    { 3, { 0x02, 0x41, 0x62, 0x00 } },   // 0xD3
+    { 3, { 0x21, 0x41, 0x62, 0x00 } },   // 0xD4
+    { 4, { 0x01, 0x21, 0x41, 0x62 } },   // 0xD5
+    { 3, { 0x12, 0x41, 0x62, 0x00 } },   // 0xD6
+    { 3, { 0x03, 0x41, 0x62, 0x00 } },   // 0xD7
+    { 2, { 0x32, 0x62, 0x00, 0x00 } },   // 0xD8
+    { 3, { 0x01, 0x32, 0x62, 0x00 } },   // 0xD9
+    { 3, { 0x11, 0x32, 0x62, 0x00 } },   // 0xDA
+    { 3, { 0x02, 0x32, 0x62, 0x00 } },   // 0xDB
+    { 2, { 0x23, 0x62, 0x00, 0x00 } },   // 0xDC
+    { 3, { 0x01, 0x23, 0x62, 0x00 } },   // 0xDD
+    { 2, { 0x14, 0x62, 0x00, 0x00 } },   // 0xDE
+    { 2, { 0x05, 0x62, 0x00, 0x00 } },   // 0xDF
+    { 1, { 0x53, 0x00, 0x00, 0x00 } },   // 0xE0
+    { 2, { 0x01, 0x53, 0x00, 0x00 } },   // 0xE1
+    { 2, { 0x11, 0x53, 0x00, 0x00 } },   // 0xE2
+    { 2, { 0x02, 0x53, 0x00, 0x00 } },   // 0xE3
+    { 2, { 0x21, 0x53, 0x00, 0x00 } },   // 0xE4
+    { 3, { 0x01, 0x21, 0x53, 0x00 } },   // 0xE5
+    { 2, { 0x12, 0x53, 0x00, 0x00 } },   // 0xE6
+    { 2, { 0x03, 0x53, 0x00, 0x00 } },   // 0xE7
+    { 2, { 0x31, 0x53, 0x00, 0x00 } },   // 0xE8
+    { 3, { 0x01, 0x31, 0x53, 0x00 } },   // 0xE9
+    { 3, { 0x11, 0x31, 0x53, 0x00 } },   // 0xEA
+    { 3, { 0x02, 0x31, 0x53, 0x00 } },   // 0xEB
+    { 2, { 0x22, 0x53, 0x00, 0x00 } },   // 0xEC
+    { 3, { 0x01, 0x22, 0x53, 0x00 } },   // 0xED
+    { 2, { 0x13, 0x53, 0x00, 0x00 } },   // 0xEE
+    { 2, { 0x04, 0x53, 0x00, 0x00 } },   // 0xEF
+    { 1, { 0x44, 0x00, 0x00, 0x00 } },   // 0xF0
+    { 2, { 0x01, 0x44, 0x00, 0x00 } },   // 0xF1
+    { 2, { 0x11, 0x44, 0x00, 0x00 } },   // 0xF2
+    { 2, { 0x02, 0x44, 0x00, 0x00 } },   // 0xF3
+    { 2, { 0x21, 0x44, 0x00, 0x00 } },   // 0xF4
+    { 3, { 0x01, 0x21, 0x44, 0x00 } },   // 0xF5
+    { 2, { 0x12, 0x44, 0x00, 0x00 } },   // 0xF6
+    { 2, { 0x03, 0x44, 0x00, 0x00 } },   // 0xF7
+    { 1, { 0x35, 0x00, 0x00, 0x00 } },   // 0xF8
+    { 2, { 0x01, 0x35, 0x00, 0x00 } },   // 0xF9
+    { 2, { 0x11, 0x35, 0x00, 0x00 } },   // 0xFA
+    { 2, { 0x02, 0x35, 0x00, 0x00 } },   // 0xFB
+    { 1, { 0x26, 0x00, 0x00, 0x00 } },   // 0xFC
+    { 2, { 0x01, 0x26, 0x00, 0x00 } },   // 0xFD
+    { 1, { 0x17, 0x00, 0x00, 0x00 } },   // 0xFE
+    { 1, { 0x08, 0x00, 0x00, 0x00 } },   // 0xFF
+};
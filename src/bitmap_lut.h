@@ -0,0 +1,19 @@
+#ifndef BITMAP_LUT_H
+#define BITMAP_LUT_H
+
+#include <stdint.h>
+
+// Runs of set bits in one 1bpp source byte: up to 4 runs, each packed as
+// (start << 4) | length, in left-to-right pixel order
+typedef struct {
+    uint8_t count;
+    uint8_t runs[4];
+} tft_bit_runs_t;
+
+#define TFT_RUN_START(r) ((r) >> 4)
+#define TFT_RUN_LEN(r)   ((r) & 0x0F)
+
+extern const tft_bit_runs_t tft_bit_runs_msb[256];  // Bit 7 = leftmost pixel
+extern const tft_bit_runs_t tft_bit_runs_lsb[256];  // Bit 0 = leftmost pixel
+
+#endif // BITMAP_LUT_H
@@ -0,0 +1,124 @@
+#include "panel_profiles.h"
+
+// ST7735V 1.8" 128x160 - same sequence the driver always used
+static const uint8_t st7735v_init_cmds[] = {
+    8,
+    0x01, TFT_INIT_DELAY, 150,                     // SWRESET
+    0x11, TFT_INIT_DELAY, 255,                     // SLPOUT, 500 ms
+    0x3A, 1, 0x05,                                 // COLMOD: RGB565
+    0x36, 1, 0x00,                                 // MADCTL: default orientation
+    0x2A, 4, 0x00, 0x00, 0x00, 0x7F,               // CASET: 0..127
+    0x2B, 4, 0x00, 0x00, 0x00, 0x9F,               // RASET: 0..159
+    0x13, TFT_INIT_DELAY, 10,                      // NORON
+    0x29, TFT_INIT_DELAY, 100,                     // DISPON
+};
+
+// ST7789 240x240 / 240x320 (both use a 240x320 GRAM)
+static const uint8_t st7789_240x240_init_cmds[] = {
+    9,
+    0x01, TFT_INIT_DELAY, 150,                     // SWRESET
+    0x11, TFT_INIT_DELAY, 255,                     // SLPOUT, 500 ms
+    0x3A, 1 | TFT_INIT_DELAY, 0x55, 10,            // COLMOD: RGB565
+    0x36, 1, 0x00,                                 // MADCTL
+    0x2A, 4, 0x00, 0x00, 0x00, 0xEF,               // CASET: 0..239
+    0x2B, 4, 0x00, 0x00, 0x00, 0xEF,               // RASET: 0..239
+    0x21, TFT_INIT_DELAY, 10,                      // INVON (ST7789 panels are inverted)
+    0x13, TFT_INIT_DELAY, 10,                      // NORON
+    0x29, TFT_INIT_DELAY, 100,                     // DISPON
+};
+
+static const uint8_t st7789_240x320_init_cmds[] = {
+    9,
+    0x01, TFT_INIT_DELAY, 150,                     // SWRESET
+    0x11, TFT_INIT_DELAY, 255,                     // SLPOUT, 500 ms
+    0x3A, 1 | TFT_INIT_DELAY, 0x55, 10,            // COLMOD: RGB565
+    0x36, 1, 0x00,                                 // MADCTL
+    0x2A, 4, 0x00, 0x00, 0x00, 0xEF,               // CASET: 0..239
+    0x2B, 4, 0x00, 0x00, 0x01, 0x3F,               // RASET: 0..319
+    0x21, TFT_INIT_DELAY, 10,                      // INVON
+    0x13, TFT_INIT_DELAY, 10,                      // NORON
+    0x29, TFT_INIT_DELAY, 100,                     // DISPON
+};
+
+// ILI9341 240x320
+static const uint8_t ili9341_init_cmds[] = {
+    24,
+    0x01, TFT_INIT_DELAY, 150,                     // SWRESET
+    0xEF, 3, 0x03, 0x80, 0x02,
+    0xCF, 3, 0x00, 0xC1, 0x30,                     // Power control B
+    0xED, 4, 0x64, 0x03, 0x12, 0x81,               // Power on sequence control
+    0xE8, 3, 0x85, 0x00, 0x78,                     // Driver timing control A
+    0xCB, 5, 0x39, 0x2C, 0x00, 0x34, 0x02,         // Power control A
+    0xF7, 1, 0x20,                                 // Pump ratio control
+    0xEA, 2, 0x00, 0x00,                           // Driver timing control B
+    0xC0, 1, 0x23,                                 // PWCTR1
+    0xC1, 1, 0x10,                                 // PWCTR2
+    0xC5, 2, 0x3E, 0x28,                           // VMCTR1
+    0xC7, 1, 0x86,                                 // VMCTR2
+    0x36, 1, 0x48,                                 // MADCTL: MX | BGR
+    0x37, 1, 0x00,                                 // VSCRSADD
+    0x3A, 1, 0x55,                                 // COLMOD: RGB565
+    0xB1, 2, 0x00, 0x18,                           // FRMCTR1: 79 Hz
+    0xB6, 3, 0x08, 0x82, 0x27,                     // Display function control
+    0xF2, 1, 0x00,                                 // 3-gamma function disable
+    0x26, 1, 0x01,                                 // Gamma curve 1
+    0xE0, 15, 0x0F, 0x31, 0x2B, 0x0C, 0x0E, 0x08,  // GMCTRP1
+              0x4E, 0xF1, 0x37, 0x07, 0x10, 0x03,
+              0x0E, 0x09, 0x00,
+    0xE1, 15, 0x00, 0x0E, 0x14, 0x03, 0x11, 0x07,  // GMCTRN1
+              0x31, 0xC1, 0x48, 0x08, 0x0F, 0x0C,
+              0x31, 0x36, 0x0F,
+    0x11, TFT_INIT_DELAY, 150,                     // SLPOUT
+    0x13, TFT_INIT_DELAY, 10,                      // NORON
+    0x29, TFT_INIT_DELAY, 150,                     // DISPON
+};
+
+const tft_panel_profile_t TFT_PANEL_ST7735V_128X160 = {
+    "ST7735V 128x160",
+    128, 160,
+    st7735v_init_cmds,
+    { 0x00, 0x60, 0xC0, 0xA0 },
+    { 0, 0, 0, 0 },
+    { 0, 0, 0, 0 },
+    8,
+    16,
+    12403, 160, 91,     // FRMCTR1 reset value: 850 kHz / (42 * 251 lines) = 80.6 Hz
+};
+
+// 240x240 glass on a 240x320 GRAM: the visible area shifts by 80 lines when
+// the scan direction is mirrored
+const tft_panel_profile_t TFT_PANEL_ST7789_240X240 = {
+    "ST7789 240x240",
+    240, 240,
+    st7789_240x240_init_cmds,
+    { 0x00, 0x60, 0xC0, 0xA0 },
+    { 0, 0, 0, 80 },
+    { 0, 0, 80, 0 },
+    8,
+    14,
+    16667, 320, 24,     // FRCTRL2 / PORCTRL reset values: 60 Hz
+};
+
+const tft_panel_profile_t TFT_PANEL_ST7789_240X320 = {
+    "ST7789 240x320",
+    240, 320,
+    st7789_240x320_init_cmds,
+    { 0x00, 0x60, 0xC0, 0xA0 },
+    { 0, 0, 0, 0 },
+    { 0, 0, 0, 0 },
+    8,
+    14,
+    16667, 320, 24,     // FRCTRL2 / PORCTRL reset values: 60 Hz
+};
+
+const tft_panel_profile_t TFT_PANEL_ILI9341_240X320 = {
+    "ILI9341 240x320",
+    240, 320,
+    ili9341_init_cmds,
+    { 0x48, 0x28, 0x88, 0xE8 },
+    { 0, 0, 0, 0 },
+    { 0, 0, 0, 0 },
+    8,
+    15,
+    12644, 320, 4,      // FRMCTR1 above: 615 kHz / (24 * 324 lines) = 79 Hz
+};
@@ -0,0 +1,35 @@
+#ifndef PANEL_PROFILES_H
+#define PANEL_PROFILES_H
+
+#include <stdint.h>
+
+// Init command table encoding (Adafruit-style):
+//   num_commands,
+//   cmd, num_args | TFT_INIT_DELAY, args..., [delay_ms if TFT_INIT_DELAY set], ...
+// A delay byte of 255 means 500 ms.
+#define TFT_INIT_DELAY     0x80
+
+// Controller profile: panel geometry and the controller-specific parts of the
+// command set. Everything the driver needs to know about a panel lives here.
+typedef struct {
+    const char* name;
+    uint16_t native_width;      // Panel width in rotation 0
+    uint16_t native_height;     // Panel height in rotation 0
+    const uint8_t* init_cmds;   // Init command table (see encoding above)
+    uint8_t madctl[4];          // MADCTL value for rotation 0..3
+    int16_t col_offset[4];      // GRAM column offset for rotation 0..3
+    int16_t row_offset[4];      // GRAM row offset for rotation 0..3
+    uint8_t ramrd_dummy_bits;   // Dummy clocks between RAMRD and the first pixel
+    uint8_t gamma_bytes;        // Parameter bytes of GMCTRP1 / GMCTRN1
+    uint32_t refresh_us;        // Refresh period with the init table's frame rate setting
+    uint16_t gate_lines;        // GRAM rows scanned per refresh
+    uint16_t porch_lines;       // Blank lines per refresh (front + back porch)
+} tft_panel_profile_t;
+
+// Built-in profiles
+extern const tft_panel_profile_t TFT_PANEL_ST7735V_128X160;
+extern const tft_panel_profile_t TFT_PANEL_ST7789_240X240;
+extern const tft_panel_profile_t TFT_PANEL_ST7789_240X320;
+extern const tft_panel_profile_t TFT_PANEL_ILI9341_240X320;
+
+#endif // PANEL_PROFILES_H
@@ -0,0 +1,160 @@
+#include "tft_coro.h"
+
+#if TFT_HAS_COROUTINES
+
+#include <stdlib.h>
+
+#ifdef ESP_PLATFORM
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_timer.h>
+#else
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+struct host_wake_t {
+    std::mutex lock;
+    std::condition_variable cv;
+    bool flag = false;
+};
+#endif
+
+void TFTTask::promise_type::unhandled_exception() {
+    abort();
+}
+
+bool TFTAwait::is_ready(int64_t now) const {
+    if (ready != nullptr && ready(ctx, arg)) return true;
+    return deadline_us >= 0 && now >= deadline_us;
+}
+
+bool TFTAwait::await_ready() const {
+    return ready != nullptr && ready(ctx, arg);
+}
+
+void TFTAwait::await_suspend(TFTTask::handle_t h) const {
+    h.promise().scheduler->park(h, *this);
+}
+
+TFTScheduler::TFTScheduler() : poll_us(TFT_CORO_POLL_US), wake_handle(nullptr) {
+#ifndef ESP_PLATFORM
+    wake_handle = new host_wake_t;
+#endif
+}
+
+TFTScheduler::~TFTScheduler() {
+    for (size_t i = 0; i < waiters.size(); i++) waiters[i].handle.destroy();
+#ifndef ESP_PLATFORM
+    delete (host_wake_t*)wake_handle;
+#endif
+}
+
+int64_t TFTScheduler::now_us() {
+#ifdef ESP_PLATFORM
+    return esp_timer_get_time();
+#else
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+void TFTScheduler::spawn(TFTTask&& task) {
+    if (!task.handle) return;
+    task.handle.promise().scheduler = this;
+    park(task.handle, yield());
+    task.handle = nullptr;
+}
+
+void TFTScheduler::park(TFTTask::handle_t h, const TFTAwait& wait) {
+    Waiter w = { h, wait };
+    waiters.push_back(w);
+}
+
+TFTAwait TFTScheduler::sleep(uint32_t ms) {
+    TFTAwait wait = { nullptr, nullptr, nullptr, 0, now_us() + (int64_t)ms * 1000 };
+    return wait;
+}
+
+TFTAwait TFTScheduler::yield() {
+    TFTAwait wait = { nullptr, nullptr, nullptr, 0, 0 };
+    return wait;
+}
+
+bool TFTScheduler::runOnce() {
+    // Coroutines parking while this pass runs wait for the next one
+    std::vector<Waiter> current;
+    current.swap(waiters);
+    int64_t now = now_us();
+    bool resumed = false;
+
+    for (size_t i = 0; i < current.size(); i++) {
+        Waiter& w = current[i];
+        if (!w.wait.is_ready(now)) {
+            waiters.push_back(w);
+            continue;
+        }
+        w.handle.resume();
+        if (w.handle.done()) w.handle.destroy();
+        resumed = true;
+    }
+    return resumed;
+}
+
+void TFTScheduler::run() {
+#ifdef ESP_PLATFORM
+    wake_handle = xTaskGetCurrentTaskHandle();
+#endif
+    while (!waiters.empty()) {
+        if (runOnce()) continue;
+
+        // Sleep until the nearest deadline, re-checking conditions every poll_us
+        int64_t now = now_us();
+        int64_t wait_us = -1;
+        for (size_t i = 0; i < waiters.size(); i++) {
+            const TFTAwait& w = waiters[i].wait;
+            int64_t d = (w.ready != nullptr) ? poll_us : -1;
+            if (w.deadline_us >= 0) {
+                int64_t until = w.deadline_us - now;
+                if (until < 0) until = 0;
+                if (d < 0 || until < d) d = until;
+            }
+            if (d >= 0 && (wait_us < 0 || d < wait_us)) wait_us = d;
+        }
+        if (wait_us == 0) continue;
+        idle(wait_us < 0 ? poll_us : (uint32_t)wait_us);
+    }
+}
+
+void TFTScheduler::idle(uint32_t max_us) {
+#ifdef ESP_PLATFORM
+    TickType_t ticks = pdMS_TO_TICKS((max_us + 999) / 1000);
+    if (ticks == 0) ticks = 1;
+    ulTaskNotifyTake(pdTRUE, ticks);
+#else
+    host_wake_t* hw = (host_wake_t*)wake_handle;
+    std::unique_lock<std::mutex> guard(hw->lock);
+    hw->cv.wait_for(guard, std::chrono::microseconds(max_us), [hw] { return hw->flag; });
+    hw->flag = false;
+#endif
+}
+
+void TFTScheduler::notify() {
+#ifdef ESP_PLATFORM
+    if (wake_handle != nullptr) xTaskNotifyGive((TaskHandle_t)wake_handle);
+#else
+    host_wake_t* hw = (host_wake_t*)wake_handle;
+    {
+        std::lock_guard<std::mutex> guard(hw->lock);
+        hw->flag = true;
+    }
+    hw->cv.notify_one();
+#endif
+}
+
+void TFTScheduler::wake(uint32_t seq, void* scheduler) {
+    (void)seq;
+    if (scheduler != nullptr) ((TFTScheduler*)scheduler)->notify();
+}
+
+#endif // TFT_HAS_COROUTINES
@@ -0,0 +1,130 @@
+#ifndef TFT_CORO_H
+#define TFT_CORO_H
+
+// C++20 coroutine support for render loops:
+//
+//   TFTTask render(TFT7735V& tft, TFTScheduler& sched) {
+//       while (true) {
+//           draw_frame(tft);
+//           uint32_t seq = co_await tft.present();   // Waits for a free buffer, then display()
+//           co_await tft.frameDone(seq);              // Frame is on the panel
+//           co_await sched.sleep(10);
+//       }
+//   }
+//
+// All coroutines run on the task that calls TFTScheduler::run(); suspended
+// coroutines cost one small list entry, no task or stack each. Only available
+// when the compiler implements coroutines (-std=c++20); TFT_HAS_COROUTINES
+// tells which. Without ESP_PLATFORM the scheduler idles with std::chrono and
+// a condition variable, so coroutine code can be exercised on the host.
+
+#if defined(__has_include)
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define TFT_HAS_COROUTINES 1
+#endif
+#endif
+
+#ifndef TFT_HAS_COROUTINES
+#define TFT_HAS_COROUTINES 0
+#endif
+
+#if TFT_HAS_COROUTINES
+
+#include <stdint.h>
+#include <stddef.h>
+#include <coroutine>
+#include <vector>
+
+#define TFT_CORO_POLL_US 1000   // Default re-check interval for condition waits
+
+class TFTScheduler;
+
+// Coroutine return type. The coroutine starts suspended and runs once it is
+// handed to TFTScheduler::spawn(); the scheduler frees it when it returns.
+class TFTTask {
+public:
+    struct promise_type {
+        TFTScheduler* scheduler = nullptr;
+
+        TFTTask get_return_object() {
+            return TFTTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception();
+    };
+    typedef std::coroutine_handle<promise_type> handle_t;
+
+    TFTTask(TFTTask&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+    TFTTask(const TFTTask&) = delete;
+    TFTTask& operator=(const TFTTask&) = delete;
+    ~TFTTask() { if (handle) handle.destroy(); }
+
+private:
+    friend class TFTScheduler;
+    explicit TFTTask(handle_t h) : handle(h) {}
+    handle_t handle;
+};
+
+// Wait condition: resumes once ready(ctx, arg) returns true or the deadline
+// passes (deadline_us < 0: none). co_await yields result(ctx, arg), or arg
+// when result is nullptr. ready and result run on the scheduler's task.
+struct TFTAwait {
+    bool (*ready)(void* ctx, uint32_t arg);
+    uint32_t (*result)(void* ctx, uint32_t arg);
+    void* ctx;
+    uint32_t arg;
+    int64_t deadline_us;
+
+    bool is_ready(int64_t now_us) const;
+
+    bool await_ready() const;
+    void await_suspend(TFTTask::handle_t h) const;
+    uint32_t await_resume() const { return result ? result(ctx, arg) : arg; }
+};
+
+class TFTScheduler {
+public:
+    TFTScheduler();
+    ~TFTScheduler();    // Destroys coroutines that have not finished
+
+    void spawn(TFTTask&& task);
+
+    // Resumes every coroutine whose wait is over; false if none was
+    bool runOnce();
+    // Runs until all coroutines have returned, sleeping while none is ready
+    void run();
+    size_t pending() const { return waiters.size(); }
+
+    // Wakes run() early. Safe from other tasks, not from ISRs.
+    void notify();
+    // tft_frame_done_cb_t adapter: tft.setFrameDoneCallback(TFTScheduler::wake, &sched)
+    static void wake(uint32_t seq, void* scheduler);
+
+    // Condition waits are re-checked this often while nothing notifies
+    void setPollInterval(uint32_t us) { poll_us = us ? us : 1; }
+
+    TFTAwait sleep(uint32_t ms);
+    TFTAwait yield();       // Lets every other ready coroutine run first
+
+    static int64_t now_us();
+
+private:
+    friend struct TFTAwait;
+
+    struct Waiter {
+        TFTTask::handle_t handle;
+        TFTAwait wait;
+    };
+    std::vector<Waiter> waiters;
+    uint32_t poll_us;
+    void* wake_handle;      // Task handle on ESP, host wait state otherwise
+
+    void park(TFTTask::handle_t h, const TFTAwait& wait);
+    void idle(uint32_t max_us);
+};
+
+#endif // TFT_HAS_COROUTINES
+
+#endif // TFT_CORO_H
@@ -0,0 +1,178 @@
+#include "tft_image_cache.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#else
+#include <chrono>
+#endif
+
+static int64_t cache_now_us() {
+#ifdef ESP_PLATFORM
+    return esp_timer_get_time();
+#else
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// PSRAM when there is some, internal RAM otherwise
+static void* cache_alloc(size_t bytes) {
+#ifdef ESP_PLATFORM
+    void* p = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM);
+    return p ? p : heap_caps_malloc(bytes, MALLOC_CAP_8BIT);
+#else
+    return malloc(bytes);
+#endif
+}
+
+static void cache_free(void* p) {
+#ifdef ESP_PLATFORM
+    heap_caps_free(p);
+#else
+    free(p);
+#endif
+}
+
+TFTImageCache::TFTImageCache(size_t budget_bytes, const tft_image_decoder_t& decoder)
+    : decoder(decoder), budget(budget_bytes), used(0), clock(0) {
+    memset(&stats, 0, sizeof(stats));
+}
+
+TFTImageCache::~TFTImageCache() {
+    clear();
+}
+
+TFTImageCache::Entry* TFTImageCache::find(uint32_t asset_id, uint32_t params) {
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (entries[i].asset_id == asset_id && entries[i].params == params) return &entries[i];
+    }
+    return nullptr;
+}
+
+const tft_cached_image_t* TFTImageCache::get(uint32_t asset_id, uint32_t params) {
+    Entry* e = find(asset_id, params);
+    if (e != nullptr) {
+        stats.hits++;
+        e->last_used = ++clock;
+        return &e->image;
+    }
+    e = load(asset_id, params);
+    return e ? &e->image : nullptr;
+}
+
+TFTImageCache::Entry* TFTImageCache::load(uint32_t asset_id, uint32_t params) {
+    stats.misses++;
+    tft_image_info_t info;
+    if (decoder.info == nullptr || decoder.decode == nullptr ||
+        !decoder.info(asset_id, params, decoder.user, &info) || info.w == 0 || info.h == 0) {
+        stats.failures++;
+        return nullptr;
+    }
+
+    // One block: pixels first (aligned), then the alpha plane
+    size_t pixels = (size_t)info.w * info.h;
+    size_t bytes = pixels * sizeof(uint16_t) + (info.has_alpha ? pixels : 0);
+    if (!make_room(bytes)) {
+        stats.failures++;
+        return nullptr;
+    }
+    uint8_t* block = (uint8_t*)cache_alloc(bytes);
+    if (block == nullptr) {
+        stats.failures++;
+        return nullptr;
+    }
+
+    Entry e;
+    e.asset_id = asset_id;
+    e.params = params;
+    e.image.w = info.w;
+    e.image.h = info.h;
+    e.image.pixels = (const uint16_t*)block;
+    e.image.alpha = info.has_alpha ? block + pixels * sizeof(uint16_t) : nullptr;
+    e.bytes = bytes;
+    e.last_used = ++clock;
+    e.pinned = false;
+
+    int64_t start = cache_now_us();
+    bool ok = decoder.decode(asset_id, params, decoder.user, (uint16_t*)block,
+                             info.has_alpha ? block + pixels * sizeof(uint16_t) : nullptr);
+    stats.decode_us += (uint64_t)(cache_now_us() - start);
+    if (!ok) {
+        cache_free(block);
+        stats.failures++;
+        return nullptr;
+    }
+
+    entries.push_back(e);
+    used += bytes;
+    return &entries.back();
+}
+
+// Evicts least recently used unpinned entries until bytes more fit
+bool TFTImageCache::make_room(size_t bytes) {
+    if (bytes > budget) return false;
+    while (used + bytes > budget) {
+        size_t victim = entries.size();
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (entries[i].pinned) continue;
+            if (victim == entries.size() || entries[i].last_used < entries[victim].last_used) victim = i;
+        }
+        if (victim == entries.size()) return false;
+        release(victim);
+        stats.evictions++;
+    }
+    return true;
+}
+
+void TFTImageCache::release(size_t index) {
+    used -= entries[index].bytes;
+    cache_free((void*)entries[index].image.pixels);
+    entries[index] = entries.back();
+    entries.pop_back();
+}
+
+bool TFTImageCache::pin(uint32_t asset_id, uint32_t params) {
+    Entry* e = find(asset_id, params);
+    if (e == nullptr) e = load(asset_id, params);
+    if (e == nullptr) return false;
+    e->pinned = true;
+    return true;
+}
+
+void TFTImageCache::unpin(uint32_t asset_id, uint32_t params) {
+    Entry* e = find(asset_id, params);
+    if (e != nullptr) e->pinned = false;
+}
+
+void TFTImageCache::remove(uint32_t asset_id, uint32_t params) {
+    Entry* e = find(asset_id, params);
+    if (e != nullptr) release(e - &entries[0]);
+}
+
+void TFTImageCache::clear() {
+    while (!entries.empty()) release(entries.size() - 1);
+}
+
+void TFTImageCache::setBudget(size_t budget_bytes) {
+    budget = budget_bytes;
+    make_room(0);
+}
+
+tft_image_cache_stats_t TFTImageCache::getStats() const {
+    tft_image_cache_stats_t s = stats;
+    s.bytes_used = used;
+    s.budget = budget;
+    s.entries = entries.size();
+    s.pinned = 0;
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (entries[i].pinned) s.pinned++;
+    }
+    return s;
+}
+
+void TFTImageCache::resetStats() {
+    memset(&stats, 0, sizeof(stats));
+}
@@ -0,0 +1,92 @@
+#ifndef TFT_IMAGE_CACHE_H
+#define TFT_IMAGE_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+// Cache of decoded images: RGB565 pixels plus optional 8-bit alpha, keyed by
+// asset id and decode parameters (scale, variant, ...; meaning is up to the
+// decoder). Entries live in PSRAM under a fixed byte budget; the least
+// recently used unpinned entry is evicted to make room. Without ESP_PLATFORM
+// entries come from malloc, so decoders can be exercised on the host.
+
+typedef struct {
+    uint16_t w, h;
+    bool has_alpha;
+} tft_image_info_t;
+
+// info() reports the decoded size without decoding; decode() fills w * h
+// native RGB565 pixels and, when has_alpha, w * h alpha bytes (255 = opaque).
+// Both return false when the asset cannot be decoded.
+typedef struct {
+    bool (*info)(uint32_t asset_id, uint32_t params, void* user, tft_image_info_t* out);
+    bool (*decode)(uint32_t asset_id, uint32_t params, void* user, uint16_t* pixels, uint8_t* alpha);
+    void* user;
+} tft_image_decoder_t;
+
+typedef struct {
+    uint16_t w, h;
+    const uint16_t* pixels;
+    const uint8_t* alpha;      // nullptr for opaque images
+} tft_cached_image_t;
+
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;           // Lookups that ran the decoder
+    uint32_t evictions;
+    uint32_t failures;         // Decode errors and images that do not fit
+    uint64_t decode_us;        // Time spent in decode() on misses
+    size_t bytes_used;
+    size_t budget;
+    uint16_t entries;
+    uint16_t pinned;
+} tft_image_cache_stats_t;
+
+class TFTImageCache {
+public:
+    TFTImageCache(size_t budget_bytes, const tft_image_decoder_t& decoder);
+    ~TFTImageCache();
+
+    // Decoded image, decoding it on a miss; nullptr if it cannot be decoded
+    // or does not fit. The pointer is valid until the next call; the pixels
+    // until the entry is evicted or removed, so pin images kept around.
+    const tft_cached_image_t* get(uint32_t asset_id, uint32_t params = 0);
+
+    // Pinned entries are never evicted (pin decodes if needed)
+    bool pin(uint32_t asset_id, uint32_t params = 0);
+    void unpin(uint32_t asset_id, uint32_t params = 0);
+
+    void remove(uint32_t asset_id, uint32_t params = 0);
+    void clear();                          // Drops pinned entries too
+    void setBudget(size_t budget_bytes);   // Evicts down to the new budget
+
+    tft_image_cache_stats_t getStats() const;
+    void resetStats();
+
+    TFTImageCache(const TFTImageCache&) = delete;
+    TFTImageCache& operator=(const TFTImageCache&) = delete;
+
+private:
+    struct Entry {
+        uint32_t asset_id;
+        uint32_t params;
+        tft_cached_image_t image;
+        size_t bytes;
+        uint32_t last_used;
+        bool pinned;
+    };
+    std::vector<Entry> entries;
+    tft_image_decoder_t decoder;
+    size_t budget;
+    size_t used;
+    uint32_t clock;
+    tft_image_cache_stats_t stats;
+
+    Entry* find(uint32_t asset_id, uint32_t params);
+    Entry* load(uint32_t asset_id, uint32_t params);
+    bool make_room(size_t bytes);
+    void release(size_t index);
+};
+
+#endif // TFT_IMAGE_CACHE_H
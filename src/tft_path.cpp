@@ -0,0 +1,623 @@
+#include "tft_path.h"
+#include <math.h>
+#include <algorithm>
+
+tft_affine_t tftAffineIdentity() {
+    tft_affine_t t = { 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f };
+    return t;
+}
+
+tft_affine_t tftAffineTranslate(float tx, float ty) {
+    tft_affine_t t = { 1.0f, 0.0f, 0.0f, 1.0f, tx, ty };
+    return t;
+}
+
+tft_affine_t tftAffineScale(float sx, float sy) {
+    tft_affine_t t = { sx, 0.0f, 0.0f, sy, 0.0f, 0.0f };
+    return t;
+}
+
+tft_affine_t tftAffineRotate(float radians) {
+    float s = sinf(radians), c = cosf(radians);
+    tft_affine_t t = { c, s, -s, c, 0.0f, 0.0f };
+    return t;
+}
+
+tft_affine_t tftAffineMultiply(const tft_affine_t& o, const tft_affine_t& i) {
+    tft_affine_t t;
+    t.a = o.a * i.a + o.c * i.b;
+    t.b = o.b * i.a + o.d * i.b;
+    t.c = o.a * i.c + o.c * i.d;
+    t.d = o.b * i.c + o.d * i.d;
+    t.tx = o.a * i.tx + o.c * i.ty + o.tx;
+    t.ty = o.b * i.tx + o.d * i.ty + o.ty;
+    return t;
+}
+
+TFTPath::TFTPath() : has_current(false) {
+}
+
+uint8_t TFTPath::coord_count(uint8_t verb) {
+    switch (verb) {
+        case TFT_PATH_VERB_MOVE:
+        case TFT_PATH_VERB_LINE:  return 2;
+        case TFT_PATH_VERB_QUAD:  return 4;
+        case TFT_PATH_VERB_CUBIC: return 6;
+        default:                  return 0;
+    }
+}
+
+// Drawing without a moveTo starts at the origin
+void TFTPath::ensure_current() {
+    if (!has_current) {
+        moveTo(0.0f, 0.0f);
+    }
+}
+
+void TFTPath::moveTo(float x, float y) {
+    verbs.push_back(TFT_PATH_VERB_MOVE);
+    coords.push_back(x);
+    coords.push_back(y);
+    has_current = true;
+}
+
+void TFTPath::lineTo(float x, float y) {
+    ensure_current();
+    verbs.push_back(TFT_PATH_VERB_LINE);
+    coords.push_back(x);
+    coords.push_back(y);
+}
+
+void TFTPath::quadTo(float cx, float cy, float x, float y) {
+    ensure_current();
+    verbs.push_back(TFT_PATH_VERB_QUAD);
+    coords.push_back(cx);
+    coords.push_back(cy);
+    coords.push_back(x);
+    coords.push_back(y);
+}
+
+void TFTPath::cubicTo(float c1x, float c1y, float c2x, float c2y, float x, float y) {
+    ensure_current();
+    verbs.push_back(TFT_PATH_VERB_CUBIC);
+    coords.push_back(c1x);
+    coords.push_back(c1y);
+    coords.push_back(c2x);
+    coords.push_back(c2y);
+    coords.push_back(x);
+    coords.push_back(y);
+}
+
+void TFTPath::close() {
+    if (has_current) {
+        verbs.push_back(TFT_PATH_VERB_CLOSE);
+    }
+}
+
+void TFTPath::clear() {
+    verbs.clear();
+    coords.clear();
+    has_current = false;
+}
+
+void TFTPath::flatten(std::vector<tft_path_segment_t>& out, const tft_affine_t* transform,
+                      float tolerance) const {
+    tft_affine_t t = transform ? *transform : tftAffineIdentity();
+    if (tolerance < 0.01f) tolerance = 0.01f;
+
+    float start_x = 0.0f, start_y = 0.0f;   // Subpath start (device space)
+    float cur_x = 0.0f, cur_y = 0.0f;
+    bool open = false;
+    size_t ci = 0;
+
+    // Transformed control points
+    float px[4], py[4];
+
+    for (size_t vi = 0; vi < verbs.size(); vi++) {
+        uint8_t verb = verbs[vi];
+        uint8_t n = coord_count(verb) / 2;
+        px[0] = cur_x;
+        py[0] = cur_y;
+        for (uint8_t k = 0; k < n; k++) {
+            float x = coords[ci++], y = coords[ci++];
+            px[k + 1] = t.a * x + t.c * y + t.tx;
+            py[k + 1] = t.b * x + t.d * y + t.ty;
+        }
+
+        switch (verb) {
+            case TFT_PATH_VERB_MOVE:
+            case TFT_PATH_VERB_CLOSE:
+                if (open && (cur_x != start_x || cur_y != start_y)) {
+                    tft_path_segment_t s = { cur_x, cur_y, start_x, start_y };
+                    out.push_back(s);
+                }
+                if (verb == TFT_PATH_VERB_MOVE) {
+                    start_x = px[1];
+                    start_y = py[1];
+                }
+                cur_x = start_x;
+                cur_y = start_y;
+                open = true;
+                continue;
+
+            case TFT_PATH_VERB_LINE: {
+                tft_path_segment_t s = { cur_x, cur_y, px[1], py[1] };
+                out.push_back(s);
+                break;
+            }
+
+            case TFT_PATH_VERB_QUAD: {
+                // Chord error of n uniform steps is |p0 - 2p1 + p2| / (4 n^2)
+                float ddx = px[0] - 2.0f * px[1] + px[2];
+                float ddy = py[0] - 2.0f * py[1] + py[2];
+                float dd = sqrtf(ddx * ddx + ddy * ddy);
+                int steps = (int)ceilf(sqrtf(dd / (4.0f * tolerance)));
+                if (steps < 1) steps = 1;
+                if (steps > 100) steps = 100;
+                float lx = px[0], ly = py[0];
+                for (int i = 1; i <= steps; i++) {
+                    float u = (float)i / steps, v = 1.0f - u;
+                    float x = v * v * px[0] + 2.0f * v * u * px[1] + u * u * px[2];
+                    float y = v * v * py[0] + 2.0f * v * u * py[1] + u * u * py[2];
+                    tft_path_segment_t s = { lx, ly, x, y };
+                    out.push_back(s);
+                    lx = x;
+                    ly = y;
+                }
+                break;
+            }
+
+            case TFT_PATH_VERB_CUBIC: {
+                // Chord error is bounded by 3 * max|second difference| / (4 n^2)
+                float d1x = px[0] - 2.0f * px[1] + px[2], d1y = py[0] - 2.0f * py[1] + py[2];
+                float d2x = px[1] - 2.0f * px[2] + px[3], d2y = py[1] - 2.0f * py[2] + py[3];
+                float dd = fmaxf(sqrtf(d1x * d1x + d1y * d1y), sqrtf(d2x * d2x + d2y * d2y));
+                int steps = (int)ceilf(sqrtf(3.0f * dd / (4.0f * tolerance)));
+                if (steps < 1) steps = 1;
+                if (steps > 100) steps = 100;
+                float lx = px[0], ly = py[0];
+                for (int i = 1; i <= steps; i++) {
+                    float u = (float)i / steps, v = 1.0f - u;
+                    float b0 = v * v * v, b1 = 3.0f * v * v * u, b2 = 3.0f * v * u * u, b3 = u * u * u;
+                    float x = b0 * px[0] + b1 * px[1] + b2 * px[2] + b3 * px[3];
+                    float y = b0 * py[0] + b1 * py[1] + b2 * py[2] + b3 * py[3];
+                    tft_path_segment_t s = { lx, ly, x, y };
+                    out.push_back(s);
+                    lx = x;
+                    ly = y;
+                }
+                break;
+            }
+
+            default:
+                continue;
+        }
+
+        cur_x = px[n];
+        cur_y = py[n];
+    }
+
+    // Implicitly close the last subpath
+    if (open && (cur_x != start_x || cur_y != start_y)) {
+        tft_path_segment_t s = { cur_x, cur_y, start_x, start_y };
+        out.push_back(s);
+    }
+}
+
+size_t TFTPath::serialize(uint8_t* data, size_t capacity) const {
+    size_t needed = 3 + verbs.size() + coords.size() * 2 + 1;
+    if (data == nullptr || capacity < needed) {
+        return needed;
+    }
+
+    size_t pos = 0;
+    data[pos++] = 'T';
+    data[pos++] = 'P';
+    data[pos++] = TFT_PATH_FORMAT_VERSION;
+
+    size_t ci = 0;
+    for (size_t vi = 0; vi < verbs.size(); vi++) {
+        data[pos++] = verbs[vi];
+        for (uint8_t k = 0; k < coord_count(verbs[vi]); k++) {
+            float v = coords[ci++] * 16.0f;
+            if (v > 32767.0f) v = 32767.0f;
+            if (v < -32768.0f) v = -32768.0f;
+            int16_t q = (int16_t)lrintf(v);
+            data[pos++] = (uint8_t)(q & 0xFF);
+            data[pos++] = (uint8_t)((q >> 8) & 0xFF);
+        }
+    }
+    data[pos++] = TFT_PATH_VERB_END;
+    return pos;
+}
+
+bool TFTPath::deserialize(const uint8_t* data, size_t len) {
+    clear();
+    if (data == nullptr || len < 4 || data[0] != 'T' || data[1] != 'P' ||
+        data[2] != TFT_PATH_FORMAT_VERSION) {
+        return false;
+    }
+
+    size_t pos = 3;
+    while (pos < len) {
+        uint8_t verb = data[pos++];
+        if (verb == TFT_PATH_VERB_END) {
+            return true;
+        }
+        if (verb > TFT_PATH_VERB_CLOSE) {
+            break;
+        }
+        uint8_t n = coord_count(verb);
+        if (pos + n * 2 > len) {
+            break;
+        }
+        float c[6];
+        for (uint8_t k = 0; k < n; k++) {
+            int16_t q = (int16_t)(data[pos] | (data[pos + 1] << 8));
+            c[k] = q / 16.0f;
+            pos += 2;
+        }
+        switch (verb) {
+            case TFT_PATH_VERB_MOVE:  moveTo(c[0], c[1]); break;
+            case TFT_PATH_VERB_LINE:  lineTo(c[0], c[1]); break;
+            case TFT_PATH_VERB_QUAD:  quadTo(c[0], c[1], c[2], c[3]); break;
+            case TFT_PATH_VERB_CUBIC: cubicTo(c[0], c[1], c[2], c[3], c[4], c[5]); break;
+            case TFT_PATH_VERB_CLOSE: close(); break;
+        }
+    }
+
+    // Truncated or corrupt
+    clear();
+    return false;
+}
+
+tft_stroke_style_t tftStrokeStyle(float width, tft_line_join_t join, tft_line_cap_t cap) {
+    tft_stroke_style_t style;
+    style.width = width;
+    style.join = join;
+    style.cap = cap;
+    style.miter_limit = 4.0f;
+    style.dash = nullptr;
+    style.dash_count = 0;
+    style.dash_offset = 0.0f;
+    return style;
+}
+
+// Append a closed polygon with positive signed area
+static void add_piece(const float* px, const float* py, int n, std::vector<tft_path_segment_t>& out) {
+    float area = 0.0f;
+    for (int i = 0; i < n; i++) {
+        int j = (i + 1 == n) ? 0 : i + 1;
+        area += px[i] * py[j] - px[j] * py[i];
+    }
+    if (area == 0.0f) return;
+    for (int i = 0; i < n; i++) {
+        int j = (i + 1 == n) ? 0 : i + 1;
+        tft_path_segment_t s;
+        if (area > 0.0f) {
+            s.x0 = px[i]; s.y0 = py[i]; s.x1 = px[j]; s.y1 = py[j];
+        } else {
+            s.x0 = px[j]; s.y0 = py[j]; s.x1 = px[i]; s.y1 = py[i];
+        }
+        out.push_back(s);
+    }
+}
+
+static void add_disc(float cx, float cy, float r, std::vector<tft_path_segment_t>& out) {
+    // Enough sides to stay within ~0.1 px of the true circle
+    int n = 8;
+    if (r > 0.1f) {
+        n = (int)ceilf(3.14159265f / acosf(1.0f - 0.1f / r));
+        if (n < 8) n = 8;
+        if (n > 64) n = 64;
+    }
+    float px[64], py[64];
+    for (int i = 0; i < n; i++) {
+        float a = 6.2831853f * i / n;
+        px[i] = cx + r * cosf(a);
+        py[i] = cy + r * sinf(a);
+    }
+    add_piece(px, py, n, out);
+}
+
+// Join at (x, y) between unit directions d0 -> d1
+static void add_join(float x, float y, float d0x, float d0y, float d1x, float d1y,
+                     const tft_stroke_style_t& style, std::vector<tft_path_segment_t>& out) {
+    float hw = style.width * 0.5f;
+    if (style.join == TFT_JOIN_ROUND) {
+        add_disc(x, y, hw, out);
+        return;
+    }
+    
+    float cross = d0x * d1y - d0y * d1x;
+    float dot = d0x * d1x + d0y * d1y;
+    if (fabsf(cross) < 1e-6f) return;   // Straight on or full reversal
+    
+    // Outer side is opposite the turn
+    float side = (cross > 0.0f) ? -1.0f : 1.0f;
+    float n0x = -d0y * side, n0y = d0x * side;
+    float n1x = -d1y * side, n1y = d1x * side;
+    float ax = x + n0x * hw, ay = y + n0y * hw;
+    float bx = x + n1x * hw, by = y + n1y * hw;
+    
+    // Miter length / width = 1 / cos(theta / 2)
+    float ratio = sqrtf(2.0f / (1.0f + dot));
+    if (style.join == TFT_JOIN_MITER && dot > -0.999f && ratio <= style.miter_limit) {
+        float k = hw / (1.0f + dot);
+        float px[4] = { x, ax, x + (n0x + n1x) * k, bx };
+        float py[4] = { y, ay, y + (n0y + n1y) * k, by };
+        add_piece(px, py, 4, out);
+    } else {
+        float px[3] = { x, ax, bx };
+        float py[3] = { y, ay, by };
+        add_piece(px, py, 3, out);
+    }
+}
+
+// Append a point unless it repeats the last one (no direction)
+static void append_point(std::vector<float>& pts, float x, float y) {
+    size_t n = pts.size();
+    if (n >= 2 && pts[n - 2] == x && pts[n - 1] == y) return;
+    pts.push_back(x);
+    pts.push_back(y);
+}
+
+// Stroke one solid run of points
+static void stroke_run(const std::vector<float>& pts, bool closed, const tft_stroke_style_t& style,
+                       std::vector<tft_path_segment_t>& out) {
+    size_t n = pts.size() / 2;
+    float hw = style.width * 0.5f;
+    if (n == 1) {
+        // Zero-length dash or single point: only caps have extent
+        if (style.cap == TFT_CAP_ROUND) {
+            add_disc(pts[0], pts[1], hw, out);
+        } else if (style.cap == TFT_CAP_SQUARE) {
+            float px[4] = { pts[0] - hw, pts[0] + hw, pts[0] + hw, pts[0] - hw };
+            float py[4] = { pts[1] - hw, pts[1] - hw, pts[1] + hw, pts[1] + hw };
+            add_piece(px, py, 4, out);
+        }
+        return;
+    }
+    
+    size_t segs = closed ? n : n - 1;
+    float first_dx = 0.0f, first_dy = 0.0f, prev_dx = 0.0f, prev_dy = 0.0f;
+    
+    for (size_t i = 0; i < segs; i++) {
+        size_t j = (i + 1 == n) ? 0 : i + 1;
+        float x0 = pts[i * 2], y0 = pts[i * 2 + 1];
+        float x1 = pts[j * 2], y1 = pts[j * 2 + 1];
+        float dx = x1 - x0, dy = y1 - y0;
+        float len = sqrtf(dx * dx + dy * dy);
+        dx /= len;
+        dy /= len;
+        
+        if (i == 0) {
+            first_dx = dx;
+            first_dy = dy;
+        } else {
+            add_join(x0, y0, prev_dx, prev_dy, dx, dy, style, out);
+        }
+        
+        // Square caps extend the end segments by half the width
+        if (!closed && style.cap == TFT_CAP_SQUARE) {
+            if (i == 0) { x0 -= dx * hw; y0 -= dy * hw; }
+            if (i + 1 == segs) { x1 += dx * hw; y1 += dy * hw; }
+        }
+        
+        float nx = -dy * hw, ny = dx * hw;
+        float px[4] = { x0 + nx, x1 + nx, x1 - nx, x0 - nx };
+        float py[4] = { y0 + ny, y1 + ny, y1 - ny, y0 - ny };
+        add_piece(px, py, 4, out);
+        
+        prev_dx = dx;
+        prev_dy = dy;
+    }
+    
+    if (closed) {
+        add_join(pts[0], pts[1], prev_dx, prev_dy, first_dx, first_dy, style, out);
+    } else if (style.cap == TFT_CAP_ROUND) {
+        add_disc(pts[0], pts[1], hw, out);
+        add_disc(pts[(n - 1) * 2], pts[(n - 1) * 2 + 1], hw, out);
+    }
+}
+
+void tft_stroke_polyline(const float* xy, size_t count, bool closed, const tft_stroke_style_t& style,
+                         std::vector<tft_path_segment_t>& out) {
+    if (xy == nullptr || count == 0 || style.width <= 0.0f) return;
+    
+    std::vector<float> pts;
+    pts.reserve(count * 2);
+    for (size_t i = 0; i < count; i++) {
+        append_point(pts, xy[i * 2], xy[i * 2 + 1]);
+    }
+    if (closed && pts.size() >= 4 && pts[0] == pts[pts.size() - 2] && pts[1] == pts[pts.size() - 1]) {
+        pts.resize(pts.size() - 2);
+    }
+    if (closed && pts.size() < 6) closed = false;
+    
+    if (style.dash == nullptr || style.dash_count == 0) {
+        stroke_run(pts, closed, style, out);
+        return;
+    }
+    float dash_total = 0.0f;
+    for (uint8_t i = 0; i < style.dash_count; i++) {
+        dash_total += style.dash[i];
+    }
+    if (dash_total <= 0.0f) {
+        stroke_run(pts, closed, style, out);
+        return;
+    }
+    
+    // Entries alternate on/off; odd-length patterns repeat with flipped
+    // parity, so track the state instead of the index
+    uint8_t dash_idx = 0;
+    bool on = true;
+    float remaining = fmodf(style.dash_offset, dash_total);
+    if (remaining < 0.0f) remaining += dash_total;
+    while (remaining >= style.dash[dash_idx]) {
+        remaining -= style.dash[dash_idx];
+        dash_idx = (dash_idx + 1) % style.dash_count;
+        on = !on;
+    }
+    remaining = style.dash[dash_idx] - remaining;
+    
+    size_t n = pts.size() / 2;
+    size_t segs = closed ? n : n - 1;
+    std::vector<float> run;
+    if (on) {
+        append_point(run, pts[0], pts[1]);
+    }
+    
+    for (size_t i = 0; i < segs; i++) {
+        size_t j = (i + 1 == n) ? 0 : i + 1;
+        float x0 = pts[i * 2], y0 = pts[i * 2 + 1];
+        float x1 = pts[j * 2], y1 = pts[j * 2 + 1];
+        float len = sqrtf((x1 - x0) * (x1 - x0) + (y1 - y0) * (y1 - y0));
+        float pos = 0.0f;
+        
+        while (len - pos > remaining) {
+            pos += remaining;
+            float t = pos / len;
+            append_point(run, x0 + (x1 - x0) * t, y0 + (y1 - y0) * t);
+            if (on) {
+                // End of a dash
+                stroke_run(run, false, style, out);
+                run.clear();
+            }
+            dash_idx = (dash_idx + 1) % style.dash_count;
+            on = !on;
+            remaining = style.dash[dash_idx];
+        }
+        remaining -= len - pos;
+        if (on) {
+            append_point(run, x1, y1);
+        }
+    }
+    if (on && !run.empty()) {
+        stroke_run(run, false, style, out);
+    }
+}
+
+void tft_path_accumulate_row(const tft_path_segment_t* segments, size_t count,
+                             int32_t y, int32_t x0, int32_t w, float* acc) {
+    const float row_top = (float)y, row_bottom = (float)(y + 1);
+    const float max_x = (float)w;
+
+    for (size_t i = 0; i < count; i++) {
+        const tft_path_segment_t& s = segments[i];
+        if (s.y0 == s.y1) continue;
+
+        // Orient top to bottom, remember the winding direction
+        float dir, ax, ay, bx, by;
+        if (s.y0 < s.y1) {
+            dir = 1.0f; ax = s.x0; ay = s.y0; bx = s.x1; by = s.y1;
+        } else {
+            dir = -1.0f; ax = s.x1; ay = s.y1; bx = s.x0; by = s.y0;
+        }
+        if (by <= row_top || ay >= row_bottom) continue;
+
+        float dxdy = (bx - ax) / (by - ay);
+        float top = ay > row_top ? ay : row_top;
+        float bottom = by < row_bottom ? by : row_bottom;
+        float d = (bottom - top) * dir;
+
+        // Window-relative x, clamped: left of the window all cover lands in
+        // column 0, right of it in the spill column w
+        float xa = ax + (top - ay) * dxdy - x0;
+        float xb = ax + (bottom - ay) * dxdy - x0;
+        if (xa < 0.0f) xa = 0.0f;
+        if (xb < 0.0f) xb = 0.0f;
+        if (xa > max_x) xa = max_x;
+        if (xb > max_x) xb = max_x;
+
+        float lo = xa < xb ? xa : xb;
+        float hi = xa < xb ? xb : xa;
+        float lo_floor = floorf(lo);
+        int32_t lo_i = (int32_t)lo_floor;
+        int32_t hi_i = (int32_t)ceilf(hi);
+
+        if (hi_i <= lo_i + 1) {
+            // Within one pixel: split by the mean x
+            float xm = 0.5f * (xa + xb) - lo_floor;
+            acc[lo_i] += d - d * xm;
+            acc[lo_i + 1] += d * xm;
+        } else {
+            // Spans several pixels: trapezoid areas per column
+            float s_inv = 1.0f / (hi - lo);
+            float lo_f = lo - lo_floor;
+            float a0 = 0.5f * s_inv * (1.0f - lo_f) * (1.0f - lo_f);
+            float hi_f = hi - hi_i + 1.0f;
+            float am = 0.5f * s_inv * hi_f * hi_f;
+            acc[lo_i] += d * a0;
+            if (hi_i == lo_i + 2) {
+                acc[lo_i + 1] += d * (1.0f - a0 - am);
+            } else {
+                float a1 = s_inv * (1.5f - lo_f);
+                acc[lo_i + 1] += d * (a1 - a0);
+                for (int32_t xi = lo_i + 2; xi < hi_i - 1; xi++) {
+                    acc[xi] += d * s_inv;
+                }
+                float a2 = a1 + (hi_i - lo_i - 3) * s_inv;
+                acc[hi_i - 1] += d * (1.0f - a2 - am);
+            }
+            acc[hi_i] += d * am;
+        }
+    }
+}
+
+static bool crossing_less(const tft_path_crossing_t& a, const tft_path_crossing_t& b) {
+    return a.x < b.x;
+}
+
+// Adds weight times the covered fraction of each pixel in [a, b)
+static void add_span(float* cov, int32_t w, float a, float b, float weight) {
+    if (a < 0.0f) a = 0.0f;
+    if (b > (float)w) b = (float)w;
+    if (a >= b) return;
+    int32_t ia = (int32_t)a, ib = (int32_t)b;
+    if (ia == ib) {
+        cov[ia] += (b - a) * weight;
+        return;
+    }
+    cov[ia] += ((float)(ia + 1) - a) * weight;
+    for (int32_t i = ia + 1; i < ib; i++) {
+        cov[i] += weight;
+    }
+    if (ib < w) cov[ib] += (b - (float)ib) * weight;
+}
+
+void tft_path_coverage_row(const tft_path_segment_t* segments, size_t count, int32_t y, int32_t x0, int32_t w,
+                           tft_fill_rule_t rule, float* cov, std::vector<tft_path_crossing_t>& crossings) {
+    for (int32_t i = 0; i < w; i++) {
+        cov[i] = 0.0f;
+    }
+    const float weight = 1.0f / TFT_PATH_SUBROWS;
+
+    for (int32_t k = 0; k < TFT_PATH_SUBROWS; k++) {
+        float sy = (float)y + ((float)k + 0.5f) * weight;
+
+        // Crossings of this sample line, half-open in y so shared vertices count once
+        crossings.clear();
+        for (size_t i = 0; i < count; i++) {
+            const tft_path_segment_t& s = segments[i];
+            bool down = s.y0 < s.y1;
+            float top = down ? s.y0 : s.y1;
+            float bottom = down ? s.y1 : s.y0;
+            if (sy < top || sy >= bottom) continue;
+            tft_path_crossing_t c;
+            c.x = s.x0 + (sy - s.y0) * (s.x1 - s.x0) / (s.y1 - s.y0) - (float)x0;
+            c.dir = down ? 1 : -1;
+            crossings.push_back(c);
+        }
+        if (crossings.size() < 2) continue;
+        std::sort(crossings.begin(), crossings.end(), crossing_less);
+
+        // Walk the winding number; spans where the rule says inside get covered
+        int32_t winding = 0;
+        for (size_t i = 0; i + 1 < crossings.size(); i++) {
+            winding += crossings[i].dir;
+            bool inside = (rule == TFT_FILL_EVENODD) ? (winding & 1) != 0 : winding != 0;
+            if (inside) add_span(cov, w, crossings[i].x, crossings[i + 1].x, weight);
+        }
+    }
+}
@@ -0,0 +1,146 @@
+#ifndef TFT_PATH_H
+#define TFT_PATH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+// Vector paths for fillPath(): moveTo/lineTo/quadTo/cubicTo/close, adaptive
+// Bezier flattening, affine transforms and a compact binary format for icons
+// stored in flash. No ESP-IDF dependency.
+
+// Fill rule
+typedef enum {
+    TFT_FILL_NONZERO = 0,
+    TFT_FILL_EVENODD
+} tft_fill_rule_t;
+
+// Affine transform: x' = a*x + c*y + tx, y' = b*x + d*y + ty
+typedef struct {
+    float a, b, c, d, tx, ty;
+} tft_affine_t;
+
+tft_affine_t tftAffineIdentity();
+tft_affine_t tftAffineTranslate(float tx, float ty);
+tft_affine_t tftAffineScale(float sx, float sy);
+tft_affine_t tftAffineRotate(float radians);
+tft_affine_t tftAffineMultiply(const tft_affine_t& outer, const tft_affine_t& inner);  // outer after inner
+
+// Flattened line segment in device space
+typedef struct {
+    float x0, y0, x1, y1;
+} tft_path_segment_t;
+
+// Binary path format:
+//   'T' 'P' version(1), then records of verb byte + int16 LE coordinates in
+//   12.4 fixed point (+-2047 px, 1/16 px), terminated by TFT_PATH_VERB_END.
+#define TFT_PATH_FORMAT_VERSION 1
+
+typedef enum {
+    TFT_PATH_VERB_END = 0,
+    TFT_PATH_VERB_MOVE,     // x y
+    TFT_PATH_VERB_LINE,     // x y
+    TFT_PATH_VERB_QUAD,     // cx cy x y
+    TFT_PATH_VERB_CUBIC,    // c1x c1y c2x c2y x y
+    TFT_PATH_VERB_CLOSE
+} tft_path_verb_t;
+
+class TFTPath {
+public:
+    TFTPath();
+
+    void moveTo(float x, float y);
+    void lineTo(float x, float y);
+    void quadTo(float cx, float cy, float x, float y);
+    void cubicTo(float c1x, float c1y, float c2x, float c2y, float x, float y);
+    void close();
+    void clear();
+    bool empty() const { return verbs.empty(); }
+
+    // Append the flattened outline (every subpath implicitly closed) with the
+    // transform applied. tolerance is the max chord error in device pixels.
+    void flatten(std::vector<tft_path_segment_t>& out, const tft_affine_t* transform = nullptr,
+                 float tolerance = 0.1f) const;
+
+    // Binary format. serialize() returns the bytes needed; data is only
+    // written when capacity is large enough.
+    size_t serialize(uint8_t* data, size_t capacity) const;
+    bool deserialize(const uint8_t* data, size_t len);
+
+private:
+    std::vector<uint8_t> verbs;
+    std::vector<float> coords;
+    bool has_current;
+
+    static uint8_t coord_count(uint8_t verb);
+    void ensure_current();
+};
+
+// Stroke style for drawPolyline()
+typedef enum {
+    TFT_JOIN_MITER = 0,
+    TFT_JOIN_ROUND,
+    TFT_JOIN_BEVEL
+} tft_line_join_t;
+
+typedef enum {
+    TFT_CAP_BUTT = 0,
+    TFT_CAP_ROUND,
+    TFT_CAP_SQUARE
+} tft_line_cap_t;
+
+typedef struct {
+    float width;
+    tft_line_join_t join;
+    tft_line_cap_t cap;
+    float miter_limit;      // Miter length / width before falling back to bevel
+    const float* dash;      // Alternating on/off lengths, nullptr for solid
+    uint8_t dash_count;
+    float dash_offset;
+} tft_stroke_style_t;
+
+tft_stroke_style_t tftStrokeStyle(float width, tft_line_join_t join = TFT_JOIN_MITER,
+                                  tft_line_cap_t cap = TFT_CAP_BUTT);
+
+// Outline of a stroked polyline (xy = x0, y0, x1, y1, ...) as closed,
+// positively wound pieces: one quad per segment plus join and cap pieces.
+// The pieces overlap at joins, so rasterize them with
+// tft_path_coverage_row(), which counts overlapping pieces once.
+void tft_stroke_polyline(const float* xy, size_t count, bool closed, const tft_stroke_style_t& style,
+                         std::vector<tft_path_segment_t>& out);
+
+// Coverage-accumulating scanline rasterizer. Adds the signed area each segment
+// contributes to row y (pixel columns x0 .. x0 + w) into acc[0 .. w + 1]; a
+// running sum over acc then gives the winding coverage of each pixel.
+void tft_path_accumulate_row(const tft_path_segment_t* segments, size_t count,
+                             int32_t y, int32_t x0, int32_t w, float* acc);
+
+// Vertical samples per row for tft_path_coverage_row()
+#define TFT_PATH_SUBROWS 16
+
+// Union rasterizer for shapes made of overlapping pieces (strokes). Writes the
+// coverage 0..1 of row y (pixel columns x0 .. x0 + w - 1) into cov[0 .. w - 1]:
+// the fill rule is evaluated exactly along TFT_PATH_SUBROWS horizontal lines
+// per row, with exact horizontal coverage of each inside span. Summed signed
+// area (tft_path_accumulate_row) counts the anti-aliased edges of
+// overlapping pieces twice; this counts every point once. crossings is
+// scratch space kept by the caller between rows.
+typedef struct {
+    float x;
+    int32_t dir;
+} tft_path_crossing_t;
+
+void tft_path_coverage_row(const tft_path_segment_t* segments, size_t count, int32_t y, int32_t x0, int32_t w,
+                           tft_fill_rule_t rule, float* cov, std::vector<tft_path_crossing_t>& crossings);
+
+// Coverage 0..1 from an accumulated winding value
+inline float tft_path_coverage(float winding, tft_fill_rule_t rule) {
+    float a = winding < 0.0f ? -winding : winding;
+    if (rule == TFT_FILL_EVENODD) {
+        a -= 2.0f * (int32_t)(a * 0.5f);
+        if (a > 1.0f) a = 2.0f - a;
+    }
+    return a > 1.0f ? 1.0f : a;
+}
+
+#endif // TFT_PATH_H
@@ -0,0 +1,46 @@
+#include "tft_scan_model.h"
+
+static int64_t period_ns(const tft_scan_model_t* m) {
+    return (int64_t)m->period_us * 1000;
+}
+
+static int64_t line_ns(const tft_scan_model_t* m) {
+    uint32_t lines = (uint32_t)m->gate_lines + m->porch_lines;
+    return lines ? period_ns(m) / lines : 0;
+}
+
+// Position within the refresh at t_us, 0 .. period - 1 ns
+static int64_t phase_ns(const tft_scan_model_t* m, int64_t t_us) {
+    int64_t phase = ((t_us - m->sync_us) * 1000) % period_ns(m);
+    return (phase < 0) ? phase + period_ns(m) : phase;
+}
+
+uint16_t tft_scan_line(const tft_scan_model_t* m, int64_t t_us) {
+    if (line_ns(m) == 0) return 0;
+    return (uint16_t)(phase_ns(m, t_us) / line_ns(m));
+}
+
+int64_t tft_scan_safe_start(const tft_scan_model_t* m, uint16_t first_row, uint16_t last_row,
+                            uint32_t write_us, int64_t now_us) {
+    int64_t line = line_ns(m);
+    if (line == 0) return now_us;
+
+    // Refresh k scans row r at sync + r * line + k * period; the write reaches
+    // row r at a uniform rate from start (first_row) to start + write
+    // (last_row). Both are linear in r, so a refresh sees a mix of old and new
+    // rows exactly when it scans one end of the range before the write and
+    // the other after it: for starts between the scan reaching first_row and
+    // the scan reaching last_row minus the write time.
+    int64_t a = (int64_t)first_row * line;
+    int64_t b = (int64_t)last_row * line - (int64_t)write_us * 1000;
+    int64_t guard = (int64_t)m->guard_us * 1000;
+    int64_t lo = ((a < b) ? a : b) - guard;
+    int64_t len = ((a < b) ? b - a : a - b) + 2 * guard;
+    if (len >= period_ns(m)) return -1;
+
+    // Forbidden starts repeat every period
+    int64_t into = (phase_ns(m, now_us) - lo) % period_ns(m);
+    if (into < 0) into += period_ns(m);
+    if (into >= len) return now_us;
+    return now_us + (len - into + 999) / 1000;
+}
@@ -0,0 +1,30 @@
+#ifndef TFT_SCAN_MODEL_H
+#define TFT_SCAN_MODEL_H
+
+#include <stdint.h>
+
+// Estimated panel scan position, for tear avoidance on boards without a TE
+// pin. The controller refreshes GRAM rows 0 .. gate_lines - 1 at a constant
+// line rate, then idles through the porch lines, once per period_us. Plain
+// C++ with no ESP-IDF dependency, so schedules can be checked on the host.
+
+typedef struct {
+    uint32_t period_us;      // One refresh, porches included
+    uint16_t gate_lines;     // GRAM rows scanned per refresh
+    uint16_t porch_lines;    // Blank lines per refresh (front + back porch)
+    int64_t sync_us;         // A time the scan was at GRAM row 0
+    uint32_t guard_us;       // Extra clearance for drift and command latency
+} tft_scan_model_t;
+
+// GRAM row under the scan at t_us; gate_lines or more while in the porch
+uint16_t tft_scan_line(const tft_scan_model_t* m, int64_t t_us);
+
+// Earliest start time >= now_us for a write that fills GRAM rows first_row ..
+// last_row in that order (last_row < first_row for a mirrored write) over
+// write_us, such that no refresh shows the rows part old and part new: the
+// write stays ahead of the scan or behind it. -1 when the write is too slow
+// relative to the scan for any start time to work.
+int64_t tft_scan_safe_start(const tft_scan_model_t* m, uint16_t first_row, uint16_t last_row,
+                            uint32_t write_us, int64_t now_us);
+
+#endif // TFT_SCAN_MODEL_H
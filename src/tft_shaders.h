@@ -0,0 +1,215 @@
+#ifndef TFT_SHADERS_H
+#define TFT_SHADERS_H
+
+#include <stdint.h>
+#include <math.h>
+
+// Span shaders for fillRectShader() / fillCircleShader() / fillPolygonShader().
+// A shader is any type with
+//     void span(int16_t x, int16_t y, uint16_t count, uint16_t* dst) const;
+// writing `count` native RGB565 pixels for row y starting at column x. The
+// fill functions are templates, so the span call inlines into the row loop.
+
+namespace tft_shader_detail {
+
+// 4x4 ordered dither thresholds (0..15)
+static const uint8_t bayer4[4][4] = {
+    {  0,  8,  2, 10 },
+    { 12,  4, 14,  6 },
+    {  3, 11,  1,  9 },
+    { 15,  7, 13,  5 },
+};
+
+// Expand RGB565 to 8-bit channels
+inline void expand565(uint16_t c, int32_t& r, int32_t& g, int32_t& b) {
+    r = ((c >> 11) & 0x1F) << 3; r |= r >> 5;
+    g = ((c >> 5) & 0x3F) << 2;  g |= g >> 6;
+    b = (c & 0x1F) << 3;         b |= b >> 5;
+}
+
+// Pack 16.16 channels (0..255) to RGB565, optionally with ordered dithering
+inline uint16_t pack565(int32_t r, int32_t g, int32_t b, int16_t x, int16_t y, bool dither) {
+    if (dither) {
+        int32_t d = bayer4[y & 3][x & 3];
+        r += (d << 15) + (1 << 14);   // (d + 0.5) / 16 of a 5-bit step
+        g += (d << 14) + (1 << 13);   // (d + 0.5) / 16 of a 6-bit step
+        b += (d << 15) + (1 << 14);
+    }
+    int32_t r5 = r >> 19, g6 = g >> 18, b5 = b >> 19;
+    if (r5 > 31) r5 = 31;
+    if (g6 > 63) g6 = 63;
+    if (b5 > 31) b5 = 31;
+    if (r5 < 0) r5 = 0;
+    if (g6 < 0) g6 = 0;
+    if (b5 < 0) b5 = 0;
+    return (uint16_t)((r5 << 11) | (g6 << 5) | b5);
+}
+
+// Two-stop gradient evaluated along a span where t (16.16, 0..1 inside the
+// ramp) advances by dt per pixel. Clamped ends are flat; inside the ramp the
+// channels step incrementally in 16.16 without a multiply per pixel.
+struct Ramp {
+    int32_t r0, g0, b0;     // Start color, 8-bit
+    int32_t dr, dg, db;     // End - start
+    uint16_t c0, c1;        // Exact end colors for the clamped regions
+    bool dither;
+
+    void init(uint16_t from, uint16_t to, bool dith) {
+        int32_t r1, g1, b1;
+        expand565(from, r0, g0, b0);
+        expand565(to, r1, g1, b1);
+        dr = r1 - r0; dg = g1 - g0; db = b1 - b0;
+        c0 = from; c1 = to;
+        dither = dith;
+    }
+
+    void span(int16_t x, int16_t y, uint16_t count, uint16_t* dst, int32_t t, int32_t dt) const {
+        const int32_t ONE = 1 << 16;
+        uint16_t i = 0;
+        while (i < count) {
+            if (t <= 0 || t >= ONE) {
+                dst[i++] = (t <= 0) ? c0 : c1;
+                t += dt;
+                continue;
+            }
+            // Pixels until t leaves (0, 1)
+            uint32_t n = count - i;
+            if (dt > 0) {
+                uint32_t left = (uint32_t)((ONE - t + dt - 1) / dt);
+                if (left < n) n = left;
+            } else if (dt < 0) {
+                uint32_t left = (uint32_t)((t - dt - 1) / -dt);
+                if (left < n) n = left;
+            }
+            int32_t r = (r0 << 16) + dr * t, rs = dr * dt;
+            int32_t g = (g0 << 16) + dg * t, gs = dg * dt;
+            int32_t b = (b0 << 16) + db * t, bs = db * dt;
+            for (uint32_t k = 0; k < n; k++, i++) {
+                dst[i] = pack565(r, g, b, x + i, y, dither);
+                r += rs; g += gs; b += bs;
+            }
+            t += dt * (int32_t)n;
+        }
+    }
+};
+
+} // namespace tft_shader_detail
+
+// Solid color (used by fillPolygon())
+class TFTSolidShader {
+public:
+    explicit TFTSolidShader(uint16_t color) : color(color) {}
+    void span(int16_t, int16_t, uint16_t count, uint16_t* dst) const {
+        for (uint16_t i = 0; i < count; i++) dst[i] = color;
+    }
+private:
+    uint16_t color;
+};
+
+// Linear gradient from (x0, y0) in c0 to (x1, y1) in c1, clamped beyond the ends
+class TFTLinearGradient {
+public:
+    TFTLinearGradient(int16_t x0, int16_t y0, uint16_t c0,
+                      int16_t x1, int16_t y1, uint16_t c1, bool dither = false)
+        : x0(x0), y0(y0) {
+        ramp.init(c0, c1, dither);
+        int64_t dx = x1 - x0, dy = y1 - y0;
+        int64_t len2 = dx * dx + dy * dy;
+        if (len2 == 0) {
+            // Degenerate: everything past the start
+            kx = 0; ky = 0; bias = 1 << 16;
+        } else {
+            // t = ((p - p0) . d) / |d|^2 in 16.16, sampled at pixel centers
+            kx = (int32_t)((dx << 16) / len2);
+            ky = (int32_t)((dy << 16) / len2);
+            bias = (kx + ky) / 2;
+        }
+    }
+
+    void span(int16_t x, int16_t y, uint16_t count, uint16_t* dst) const {
+        int64_t t = (int64_t)(x - x0) * kx + (int64_t)(y - y0) * ky + bias;
+        // Far outside the ramp only the sign matters
+        if (t < -(1 << 24)) t = -(1 << 24);
+        if (t > (1 << 24)) t = 1 << 24;
+        ramp.span(x, y, count, dst, (int32_t)t, kx);
+    }
+
+private:
+    tft_shader_detail::Ramp ramp;
+    int16_t x0, y0;
+    int32_t kx, ky, bias;   // 16.16 per-pixel steps
+};
+
+// Radial gradient: c0 at (cx, cy), c1 at radius and beyond
+class TFTRadialGradient {
+public:
+    TFTRadialGradient(int16_t cx, int16_t cy, uint16_t radius,
+                      uint16_t c0, uint16_t c1, bool dither = false)
+        : cx(cx), cy(cy), inv_radius(radius ? 65536.0f / radius : 0.0f) {
+        ramp.init(c0, c1, dither);
+    }
+
+    void span(int16_t x, int16_t y, uint16_t count, uint16_t* dst) const {
+        // Squared distance steps incrementally; only the sqrt is per pixel
+        float fy = y + 0.5f - cy;
+        float fx = x + 0.5f - cx;
+        float d2 = fx * fx + fy * fy;
+        for (uint16_t i = 0; i < count; i++) {
+            int32_t t = inv_radius > 0.0f ? (int32_t)(sqrtf(d2) * inv_radius) : (1 << 16);
+            if (t > (1 << 16)) t = 1 << 16;
+            ramp.span(x + i, y, 1, dst + i, t, 0);
+            d2 += 2.0f * fx + 1.0f;
+            fx += 1.0f;
+        }
+    }
+
+private:
+    tft_shader_detail::Ramp ramp;
+    int16_t cx, cy;
+    float inv_radius;
+};
+
+// Repeating RGB565 tile anchored at (origin_x, origin_y)
+class TFTPatternShader {
+public:
+    TFTPatternShader(const uint16_t* pixels, uint16_t w, uint16_t h,
+                     int16_t origin_x = 0, int16_t origin_y = 0)
+        : pixels(pixels), w(w), h(h), origin_x(origin_x), origin_y(origin_y) {}
+
+    void span(int16_t x, int16_t y, uint16_t count, uint16_t* dst) const {
+        if (pixels == nullptr || w == 0 || h == 0) return;
+        int32_t ty = (y - origin_y) % h;
+        if (ty < 0) ty += h;
+        int32_t tx = (x - origin_x) % w;
+        if (tx < 0) tx += w;
+        const uint16_t* row = pixels + ty * w;
+        for (uint16_t i = 0; i < count; i++) {
+            dst[i] = row[tx];
+            if (++tx == w) tx = 0;
+        }
+    }
+
+private:
+    const uint16_t* pixels;
+    uint16_t w, h;
+    int16_t origin_x, origin_y;
+};
+
+// Procedural shader from any callable uint16_t f(int16_t x, int16_t y)
+template <typename F>
+class TFTFunctorShader {
+public:
+    explicit TFTFunctorShader(F f) : f(f) {}
+    void span(int16_t x, int16_t y, uint16_t count, uint16_t* dst) const {
+        for (uint16_t i = 0; i < count; i++) dst[i] = f(x + i, y);
+    }
+private:
+    F f;
+};
+
+template <typename F>
+inline TFTFunctorShader<F> tftShader(F f) {
+    return TFTFunctorShader<F>(f);
+}
+
+#endif // TFT_SHADERS_H
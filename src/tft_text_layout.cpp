@@ -0,0 +1,195 @@
+#include "tft_text_layout.h"
+#include <string.h>
+
+tft_text_style_t tftTextStyle(uint16_t color, uint16_t bg, uint8_t size, tft_text_align_t align) {
+    tft_text_style_t s;
+    s.color = color;
+    s.bg = bg;
+    s.size = size ? size : 1;
+    s.align = align;
+    s.wrap = true;
+    s.ellipsis = true;
+    s.line_spacing = 0;
+    return s;
+}
+
+static void push_line(std::vector<tft_text_line_t>& lines, size_t start, size_t length) {
+    tft_text_line_t line = { (uint16_t)start, (uint16_t)length, 0, false };
+    lines.push_back(line);
+}
+
+// Whether anything but spaces and line breaks follows pos
+static bool visible_after(const char* text, size_t pos, size_t len) {
+    for (; pos < len; pos++) {
+        if (text[pos] != ' ' && text[pos] != '\n') return true;
+    }
+    return false;
+}
+
+void tft_text_layout(const char* text, uint16_t box_w, uint16_t box_h,
+                     uint16_t glyph_w, uint16_t glyph_h, const tft_text_style_t& style,
+                     std::vector<tft_text_line_t>& lines) {
+    lines.clear();
+    if (text == nullptr || glyph_w == 0 || glyph_h == 0) return;
+
+    uint16_t cols = box_w / glyph_w;
+    uint16_t line_h = glyph_h + style.line_spacing;
+    uint16_t rows = (box_h >= glyph_h) ? 1 + (box_h - glyph_h) / line_h : 0;
+    if (cols == 0 || rows == 0) return;
+
+    // Break into lines until the box is full; truncated only if visible text is left
+    size_t len = strlen(text);
+    bool truncated = false;
+    size_t pos = 0;
+    while (pos <= len) {
+        if (lines.size() == rows) {
+            truncated = visible_after(text, pos, len);
+            break;
+        }
+        size_t para_end = pos;
+        while (para_end < len && text[para_end] != '\n') para_end++;
+
+        if (!style.wrap) {
+            size_t n = para_end - pos;
+            if (n > cols) {
+                n = cols;
+                if (style.ellipsis) {
+                    push_line(lines, pos, n);
+                    lines.back().ellipsis = true;
+                    pos = para_end + 1;
+                    continue;
+                }
+            }
+            push_line(lines, pos, n);
+            pos = para_end + 1;
+            continue;
+        }
+
+        // Greedy word wrap; words longer than a line are split
+        size_t line_start = pos;
+        while (true) {
+            size_t n = para_end - line_start;
+            if (n <= cols) {
+                push_line(lines, line_start, n);
+                break;
+            }
+            size_t brk = line_start + cols;
+            size_t cut = brk;
+            while (cut > line_start && text[cut] != ' ') cut--;
+            size_t next;
+            if (cut > line_start) {
+                next = cut + 1;
+            } else {
+                cut = brk;
+                next = brk;
+            }
+            size_t end = cut;
+            while (end > line_start && text[end - 1] == ' ') end--;
+            push_line(lines, line_start, end - line_start);
+            while (next < para_end && text[next] == ' ') next++;
+            line_start = next;
+            if (lines.size() == rows) {
+                truncated = visible_after(text, next, len);
+                break;
+            }
+        }
+        if (truncated) break;
+        pos = para_end + 1;
+    }
+
+    if (truncated && style.ellipsis && !lines.empty()) {
+        lines.back().ellipsis = true;
+    }
+
+    // Ellipsis takes three cells of the line it ends
+    for (size_t i = 0; i < lines.size(); i++) {
+        tft_text_line_t& line = lines[i];
+        if (line.ellipsis) {
+            uint16_t room = cols > 3 ? cols - 3 : 0;
+            if (line.length > room) line.length = room;
+            while (line.length > 0 && text[line.start + line.length - 1] == ' ') line.length--;
+        }
+        int32_t line_w = (line.length + (line.ellipsis ? 3 : 0)) * glyph_w;
+        if (line_w > box_w) line_w = box_w;
+        switch (style.align) {
+            case TFT_ALIGN_CENTER: line.x_offset = (int16_t)((box_w - line_w) / 2); break;
+            case TFT_ALIGN_RIGHT:  line.x_offset = (int16_t)(box_w - line_w); break;
+            default:               line.x_offset = 0; break;
+        }
+    }
+}
+
+// FNV-1a over the text and everything that affects the layout
+static uint32_t layout_key(const char* text, size_t len, uint16_t box_w, uint16_t box_h,
+                           uint16_t glyph_w, uint16_t glyph_h, const tft_text_style_t& style) {
+    uint8_t params[12] = {
+        (uint8_t)box_w, (uint8_t)(box_w >> 8), (uint8_t)box_h, (uint8_t)(box_h >> 8),
+        (uint8_t)glyph_w, (uint8_t)(glyph_w >> 8), (uint8_t)glyph_h, (uint8_t)(glyph_h >> 8),
+        (uint8_t)style.align, (uint8_t)((style.wrap ? 1 : 0) | (style.ellipsis ? 2 : 0)), style.line_spacing, 0
+    };
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (uint8_t)text[i];
+        h *= 16777619u;
+    }
+    for (size_t i = 0; i < sizeof(params); i++) {
+        h ^= params[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+TFTTextLayoutCache::TFTTextLayoutCache() : clock(0), hit_count(0), miss_count(0) {
+    clear();
+}
+
+void TFTTextLayoutCache::clear() {
+    for (uint8_t i = 0; i < TFT_TEXT_LAYOUT_CACHE_SIZE; i++) {
+        entries[i].valid = false;
+        entries[i].last_used = 0;
+        entries[i].lines.clear();
+    }
+}
+
+const std::vector<tft_text_line_t>& TFTTextLayoutCache::lookup(const char* text, uint16_t box_w, uint16_t box_h,
+                                                               uint16_t glyph_w, uint16_t glyph_h,
+                                                               const tft_text_style_t& style) {
+    size_t len = text ? strlen(text) : 0;
+    uint32_t key = layout_key(text, len, box_w, box_h, glyph_w, glyph_h, style);
+    clock++;
+
+    Entry* victim = &entries[0];
+    for (uint8_t i = 0; i < TFT_TEXT_LAYOUT_CACHE_SIZE; i++) {
+        Entry& e = entries[i];
+        if (e.valid && e.key == key && e.text_len == len) {
+            e.last_used = clock;
+            hit_count++;
+            return e.lines;
+        }
+        if (!e.valid || (victim->valid && e.last_used < victim->last_used)) victim = &e;
+    }
+
+    miss_count++;
+    tft_text_layout(text, box_w, box_h, glyph_w, glyph_h, style, victim->lines);
+    victim->key = key;
+    victim->text_len = len;
+    victim->last_used = clock;
+    victim->valid = true;
+    return victim->lines;
+}
+
+TFTTextLabel::TFTTextLabel(int16_t x, int16_t y, uint16_t w, uint16_t h, const tft_text_style_t& style)
+    : x(x), y(y), w(w), h(h), style(style), painted(false) {}
+
+void TFTTextLabel::setStyle(const tft_text_style_t& new_style) {
+    style = new_style;
+    painted = false;
+}
+
+void TFTTextLabel::move(int16_t new_x, int16_t new_y, uint16_t new_w, uint16_t new_h) {
+    x = new_x;
+    y = new_y;
+    w = new_w;
+    h = new_h;
+    painted = false;
+}
@@ -0,0 +1,100 @@
+#ifndef TFT_TEXT_LAYOUT_H
+#define TFT_TEXT_LAYOUT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+// Text layout for fixed-pitch fonts: word wrap inside a box, left/center/
+// right alignment and ellipsis truncation, with an LRU cache keyed by a hash
+// of string, box and style. No ESP-IDF dependency.
+
+#define TFT_TEXT_LAYOUT_CACHE_SIZE 8   // Cached layouts in the driver
+
+typedef enum {
+    TFT_ALIGN_LEFT = 0,
+    TFT_ALIGN_CENTER,
+    TFT_ALIGN_RIGHT
+} tft_text_align_t;
+
+typedef struct {
+    uint16_t color;
+    uint16_t bg;                // Text boxes and labels are always opaque
+    uint8_t size;               // Font scale
+    tft_text_align_t align;
+    bool wrap;                  // Word wrap; otherwise one line per '\n'
+    bool ellipsis;              // Mark truncated text with "..."
+    uint8_t line_spacing;       // Extra pixels between lines
+} tft_text_style_t;
+
+tft_text_style_t tftTextStyle(uint16_t color, uint16_t bg, uint8_t size = 1,
+                              tft_text_align_t align = TFT_ALIGN_LEFT);
+
+// One laid-out line: text[start .. start + length) followed by "..." when
+// ellipsis is set, x_offset pixels from the left edge of the box
+typedef struct {
+    uint16_t start;
+    uint16_t length;
+    int16_t x_offset;
+    bool ellipsis;
+} tft_text_line_t;
+
+// Lay out text in a box_w x box_h box with glyph_w x glyph_h cells
+void tft_text_layout(const char* text, uint16_t box_w, uint16_t box_h,
+                     uint16_t glyph_w, uint16_t glyph_h, const tft_text_style_t& style,
+                     std::vector<tft_text_line_t>& lines);
+
+class TFTTextLayoutCache {
+public:
+    TFTTextLayoutCache();
+
+    // Cached layout, computed on a miss. Valid until the next lookup.
+    const std::vector<tft_text_line_t>& lookup(const char* text, uint16_t box_w, uint16_t box_h,
+                                               uint16_t glyph_w, uint16_t glyph_h,
+                                               const tft_text_style_t& style);
+    void clear();
+
+    uint32_t hits() const { return hit_count; }
+    uint32_t misses() const { return miss_count; }
+
+private:
+    struct Entry {
+        uint32_t key;
+        size_t text_len;
+        uint32_t last_used;
+        bool valid;
+        std::vector<tft_text_line_t> lines;
+    };
+    Entry entries[TFT_TEXT_LAYOUT_CACHE_SIZE];
+    uint32_t clock;
+    uint32_t hit_count, miss_count;
+};
+
+class TFT7735V;
+
+// Label with retained state: redrawing it only touches glyphs that changed
+// and the cells that became empty since the last draw
+class TFTTextLabel {
+public:
+    TFTTextLabel(int16_t x, int16_t y, uint16_t w, uint16_t h, const tft_text_style_t& style);
+
+    void setStyle(const tft_text_style_t& style);   // Next draw repaints the whole box
+    void move(int16_t x, int16_t y, uint16_t w, uint16_t h);
+    void invalidate() { painted = false; }
+
+private:
+    friend class TFT7735V;
+
+    struct Line {
+        int16_t x;
+        std::string text;
+    };
+    int16_t x, y;
+    uint16_t w, h;
+    tft_text_style_t style;
+    bool painted;
+    std::vector<Line> drawn;
+};
+
+#endif // TFT_TEXT_LAYOUT_H
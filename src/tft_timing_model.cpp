@@ -0,0 +1,110 @@
+#include "tft_timing_model.h"
+
+// Bits on the wire -> nanoseconds
+static uint64_t wire_ns(const tft_timing_params_t* p, uint64_t bytes) {
+    if (p->spi_hz == 0) return 0;
+    return bytes * 8ULL * 1000000000ULL / p->spi_hz;
+}
+
+void tft_timing_default_params(tft_timing_params_t* params, uint32_t spi_hz, bool overlap_copy) {
+    params->spi_hz = spi_hz;
+    params->transaction_overhead_ns = 8000;   // Polling transmit incl. setup
+    params->dc_switch_ns = 100;
+    params->chunk_overhead_ns = 15000;        // xQueueSend + task wakeup
+    params->psram_copy_bytes_per_us = 40;     // Octal PSRAM through cache, with byte swap
+    params->overlap_copy = overlap_copy;
+}
+
+tft_timing_result_t tft_timing_predict_frame(const tft_timing_params_t* params,
+                                             uint16_t width, uint16_t height, uint16_t chunk_height,
+                                             const tft_timing_rect_t* dirty) {
+    tft_timing_result_t r = {};
+    if (width == 0 || height == 0 || chunk_height == 0) return r;
+    
+    // Same region math as the driver: full-width chunks, or only the dirty
+    // columns of the chunks the dirty rect touches
+    uint16_t x = 0, y = 0, w = width, h = height;
+    if (dirty != nullptr && dirty->valid) {
+        if (dirty->w == 0 || dirty->h == 0 || dirty->x >= width || dirty->y >= height) return r;
+        x = dirty->x;
+        y = dirty->y;
+        w = (dirty->x + dirty->w > width) ? width - x : dirty->w;
+        h = (dirty->y + dirty->h > height) ? height - y : dirty->h;
+    }
+    
+    uint16_t start_chunk = y / chunk_height;
+    uint16_t end_chunk = (y + h - 1) / chunk_height;
+    
+    // Per chunk: CASET, RASET (command + 4 data bytes each), RAMWR, pixel data
+    const uint32_t txn_per_chunk = 6;
+    uint64_t fixed_ns = txn_per_chunk * (uint64_t)(params->transaction_overhead_ns + params->dc_switch_ns)
+                      + wire_ns(params, 3 + 8);
+    
+    uint64_t total_ns = 0, spi_ns = 0, copy_ns = 0, overhead_ns = 0;
+    uint64_t prev_xfer_ns = 0;
+    
+    for (uint16_t c = start_chunk; c <= end_chunk; c++) {
+        uint16_t cy0 = c * chunk_height;
+        uint16_t cy1 = cy0 + chunk_height;
+        if (cy1 > height) cy1 = height;
+        uint16_t ry0 = (y > cy0) ? y : cy0;
+        uint16_t ry1 = (y + h < cy1) ? y + h : cy1;
+        if (ry0 >= ry1) continue;
+        
+        uint32_t bytes = (uint32_t)w * (ry1 - ry0) * 2;
+        uint64_t copy = params->psram_copy_bytes_per_us ? (uint64_t)bytes * 1000 / params->psram_copy_bytes_per_us : 0;
+        uint64_t xfer = fixed_ns + wire_ns(params, bytes);
+        
+        if (params->overlap_copy) {
+            // Staging this chunk runs while the previous one is on the wire
+            total_ns += (copy > prev_xfer_ns ? copy : prev_xfer_ns) + params->chunk_overhead_ns;
+            prev_xfer_ns = xfer;
+        } else {
+            total_ns += copy + xfer + params->chunk_overhead_ns;
+        }
+        
+        spi_ns += wire_ns(params, bytes + 3 + 8);
+        copy_ns += copy;
+        overhead_ns += fixed_ns - wire_ns(params, 3 + 8) + params->chunk_overhead_ns;
+        r.bytes += bytes;
+        r.chunks++;
+        r.transactions += txn_per_chunk;
+    }
+    total_ns += prev_xfer_ns; // Drain the last transfer
+    
+    r.frame_us = (uint32_t)(total_ns / 1000);
+    r.spi_us = (uint32_t)(spi_ns / 1000);
+    r.copy_us = (uint32_t)(copy_ns / 1000);
+    r.overhead_us = (uint32_t)(overhead_ns / 1000);
+    r.fps = r.frame_us ? 1000000.0f / r.frame_us : 0.0f;
+    return r;
+}
+
+tft_timing_result_t tft_timing_predict_workload(const tft_timing_params_t* params,
+                                                uint16_t width, uint16_t height, uint16_t chunk_height,
+                                                const tft_timing_rect_t* frames, size_t frame_count) {
+    tft_timing_result_t avg = {};
+    if (frames == nullptr || frame_count == 0) return avg;
+    
+    uint64_t frame_us = 0, spi_us = 0, copy_us = 0, overhead_us = 0, bytes = 0, chunks = 0, txns = 0;
+    for (size_t i = 0; i < frame_count; i++) {
+        tft_timing_result_t r = tft_timing_predict_frame(params, width, height, chunk_height, &frames[i]);
+        frame_us += r.frame_us;
+        spi_us += r.spi_us;
+        copy_us += r.copy_us;
+        overhead_us += r.overhead_us;
+        bytes += r.bytes;
+        chunks += r.chunks;
+        txns += r.transactions;
+    }
+    
+    avg.frame_us = (uint32_t)(frame_us / frame_count);
+    avg.spi_us = (uint32_t)(spi_us / frame_count);
+    avg.copy_us = (uint32_t)(copy_us / frame_count);
+    avg.overhead_us = (uint32_t)(overhead_us / frame_count);
+    avg.bytes = (uint32_t)(bytes / frame_count);
+    avg.chunks = (uint16_t)(chunks / frame_count);
+    avg.transactions = (uint16_t)(txns / frame_count);
+    avg.fps = avg.frame_us ? 1000000.0f / avg.frame_us : 0.0f;
+    return avg;
+}
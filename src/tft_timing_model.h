@@ -0,0 +1,52 @@
+#ifndef TFT_TIMING_MODEL_H
+#define TFT_TIMING_MODEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Cycle-approximate model of the display pipeline: PSRAM -> SRAM staging plus
+// the SPI transactions sent per chunk. Plain C++ with no ESP-IDF dependency,
+// so it builds on the host to evaluate chunk/clock changes before flashing.
+
+// Timing parameters (defaults from tft_timing_default_params())
+typedef struct {
+    uint32_t spi_hz;                   // SPI clock
+    uint32_t transaction_overhead_ns;  // Driver setup + completion per SPI transaction
+    uint32_t dc_switch_ns;             // DC GPIO toggle before a transaction
+    uint32_t chunk_overhead_ns;        // Queue message + task switch per chunk
+    uint32_t psram_copy_bytes_per_us;  // PSRAM -> SRAM staging bandwidth
+    bool overlap_copy;                 // Staging overlaps the previous transfer (async transport)
+} tft_timing_params_t;
+
+// Region pushed in one frame; valid == false means a full frame
+typedef struct {
+    uint16_t x, y, w, h;
+    bool valid;
+} tft_timing_rect_t;
+
+// Predicted cost of one frame (or the average of a workload)
+typedef struct {
+    uint32_t frame_us;      // Wall time from display() to completion
+    uint32_t spi_us;        // Time the bus is clocking bits
+    uint32_t copy_us;       // Staging copies
+    uint32_t overhead_us;   // Transaction, DC and chunk overhead
+    uint32_t bytes;         // Pixel bytes on the wire
+    uint16_t chunks;
+    uint16_t transactions;
+    float fps;
+} tft_timing_result_t;
+
+// Fill params with typical ESP32-S3 numbers for the given clock
+void tft_timing_default_params(tft_timing_params_t* params, uint32_t spi_hz, bool overlap_copy);
+
+// Predict one frame for a width x height panel staged chunk_height rows at a time
+tft_timing_result_t tft_timing_predict_frame(const tft_timing_params_t* params,
+                                             uint16_t width, uint16_t height, uint16_t chunk_height,
+                                             const tft_timing_rect_t* dirty);
+
+// Average over a replayed workload of frame_count dirty regions
+tft_timing_result_t tft_timing_predict_workload(const tft_timing_params_t* params,
+                                                uint16_t width, uint16_t height, uint16_t chunk_height,
+                                                const tft_timing_rect_t* frames, size_t frame_count);
+
+#endif // TFT_TIMING_MODEL_H
@@ -0,0 +1,203 @@
+#include "tft_trace.h"
+#include <string.h>
+
+static const uint8_t trace_header[TFT_TRACE_HEADER_SIZE] = { 'T', 'R', TFT_TRACE_FORMAT_VERSION };
+
+uint32_t tft_trace_hash(const void* data, size_t len, uint32_t seed) {
+    const uint8_t* p = (const uint8_t*)data;
+    uint32_t h = seed;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static size_t put_varint(uint8_t* out, uint32_t v) {
+    size_t n = 0;
+    while (v >= 0x80) {
+        out[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    out[n++] = (uint8_t)v;
+    return n;
+}
+
+static bool get_varint(const uint8_t* data, size_t end, size_t* pos, uint32_t* v) {
+    uint32_t result = 0;
+    for (uint8_t shift = 0; shift < 35; shift += 7) {
+        if (*pos >= end) return false;
+        uint8_t b = data[(*pos)++];
+        result |= (uint32_t)(b & 0x7F) << shift;
+        if ((b & 0x80) == 0) {
+            *v = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+TFTTraceRecorder::TFTTraceRecorder()
+    : ring(nullptr), ring_capacity(0), ring_head(0), ring_used(0),
+      sink(nullptr), sink_user(nullptr), last_us(0), has_last(false),
+      records(0), dropped(0) {}
+
+bool TFTTraceRecorder::beginRing(uint8_t* buffer, size_t capacity) {
+    if (buffer == nullptr || capacity < TFT_TRACE_MAX_RECORD) return false;
+    end();
+    ring = buffer;
+    ring_capacity = capacity;
+    return true;
+}
+
+void TFTTraceRecorder::beginSink(tft_trace_sink_t sink_fn, void* user) {
+    end();
+    if (sink_fn == nullptr) return;
+    sink = sink_fn;
+    sink_user = user;
+    sink(trace_header, sizeof(trace_header), sink_user);
+}
+
+void TFTTraceRecorder::end() {
+    ring = nullptr;
+    ring_capacity = 0;
+    ring_head = 0;
+    ring_used = 0;
+    sink = nullptr;
+    sink_user = nullptr;
+    has_last = false;
+    records = 0;
+    dropped = 0;
+}
+
+void TFTTraceRecorder::clearRing() {
+    ring_head = 0;
+    ring_used = 0;
+    has_last = false;
+}
+
+void TFTTraceRecorder::record(uint8_t op, const int32_t* args, uint8_t argc, int64_t now_us) {
+    if (!active()) return;
+    if (argc > TFT_TRACE_MAX_ARGS) argc = TFT_TRACE_MAX_ARGS;
+
+    uint32_t dt = 0;
+    if (has_last && now_us > last_us) {
+        int64_t d = now_us - last_us;
+        dt = d > 0xFFFFFFFF ? 0xFFFFFFFF : (uint32_t)d;
+    }
+    last_us = now_us;
+    has_last = true;
+
+    uint8_t buf[TFT_TRACE_MAX_RECORD];
+    size_t n = 1;
+    buf[n++] = op;
+    n += put_varint(buf + n, dt);
+    for (uint8_t i = 0; i < argc; i++) {
+        // Zigzag keeps small negative coordinates short
+        uint32_t z = ((uint32_t)args[i] << 1) ^ (uint32_t)(args[i] >> 31);
+        n += put_varint(buf + n, z);
+    }
+    buf[0] = (uint8_t)(n - 1);
+
+    records++;
+    if (sink != nullptr) {
+        sink(buf, n, sink_user);
+    } else {
+        ring_write(buf, n);
+    }
+}
+
+void TFTTraceRecorder::ring_write(const uint8_t* data, size_t len) {
+    // Drop whole records from the front until the new one fits
+    while (ring_used + len > ring_capacity) {
+        size_t old_len = (size_t)ring[ring_head] + 1;
+        ring_head = (ring_head + old_len) % ring_capacity;
+        ring_used -= old_len;
+        dropped++;
+    }
+
+    size_t tail = (ring_head + ring_used) % ring_capacity;
+    size_t first = ring_capacity - tail;
+    if (first > len) first = len;
+    memcpy(ring + tail, data, first);
+    memcpy(ring, data + first, len - first);
+    ring_used += len;
+}
+
+size_t TFTTraceRecorder::copyRing(uint8_t* data, size_t capacity) const {
+    size_t needed = sizeof(trace_header) + ring_used;
+    if (data == nullptr || capacity < needed) return needed;
+
+    memcpy(data, trace_header, sizeof(trace_header));
+    size_t first = ring_capacity - ring_head;
+    if (first > ring_used) first = ring_used;
+    if (ring_used > 0) {
+        memcpy(data + sizeof(trace_header), ring + ring_head, first);
+        memcpy(data + sizeof(trace_header) + first, ring, ring_used - first);
+    }
+    return needed;
+}
+
+bool tft_trace_read_header(const uint8_t* data, size_t len, size_t* offset) {
+    if (data == nullptr || len < sizeof(trace_header)) return false;
+    if (data[0] != 'T' || data[1] != 'R' || data[2] != TFT_TRACE_FORMAT_VERSION) return false;
+    *offset = sizeof(trace_header);
+    return true;
+}
+
+bool tft_trace_next(const uint8_t* data, size_t len, size_t* offset, tft_trace_record_t* record) {
+    size_t pos = *offset;
+    if (pos + 2 > len) return false;
+    size_t end = pos + 1 + data[pos];
+    if (end > len) return false;
+    pos++;
+
+    record->op = data[pos++];
+    record->argc = 0;
+    memset(record->args, 0, sizeof(record->args));
+    if (!get_varint(data, end, &pos, &record->dt_us)) return false;
+    while (pos < end && record->argc < TFT_TRACE_MAX_ARGS) {
+        uint32_t z;
+        if (!get_varint(data, end, &pos, &z)) return false;
+        record->args[record->argc++] = (int32_t)(z >> 1) ^ -(int32_t)(z & 1);
+    }
+    *offset = end;
+    return true;
+}
+
+bool tft_trace_summarize(const uint8_t* data, size_t len, tft_trace_summary_t* summary) {
+    memset(summary, 0, sizeof(*summary));
+    size_t offset;
+    if (!tft_trace_read_header(data, len, &offset)) return false;
+
+    tft_trace_record_t rec;
+    while (tft_trace_next(data, len, &offset, &rec)) {
+        summary->records++;
+        summary->duration_us += rec.dt_us;
+        if (rec.op < TFT_TRACE_OP_COUNT) summary->op_count[rec.op]++;
+        if (rec.op == TFT_TRACE_OP_DISPLAY) summary->frames++;
+        if (rec.op == TFT_TRACE_OP_BEGIN && rec.argc >= 2) {
+            summary->width = (uint16_t)rec.args[0];
+            summary->height = (uint16_t)rec.args[1];
+        }
+    }
+    return true;
+}
+
+bool tft_trace_frame_rects(const uint8_t* data, size_t len, std::vector<tft_timing_rect_t>& frames) {
+    size_t offset;
+    if (!tft_trace_read_header(data, len, &offset)) return false;
+
+    tft_trace_record_t rec;
+    while (tft_trace_next(data, len, &offset, &rec)) {
+        if (rec.op != TFT_TRACE_OP_DISPLAY || rec.argc < 5) continue;
+        tft_timing_rect_t r;
+        r.x = (uint16_t)rec.args[0];
+        r.y = (uint16_t)rec.args[1];
+        r.w = (uint16_t)rec.args[2];
+        r.h = (uint16_t)rec.args[3];
+        r.valid = rec.args[4] != 0;
+        frames.push_back(r);
+    }
+    return true;
+}
@@ -0,0 +1,144 @@
+#ifndef TFT_TRACE_H
+#define TFT_TRACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "tft_timing_model.h"
+
+// Drawing-call trace: every public drawing call and display() as a compact
+// binary record, written into a caller-provided RAM ring or handed to a sink
+// callback. Plain C++ with no ESP-IDF dependency, so traces pulled off a
+// device can be decoded, summarized and fed to the timing model on the host,
+// or replayed against the simulated panel (test/host/trace_replay.cpp).
+//
+// Stream format:
+//   'T' 'R' version, then records of
+//   len(1) op(1) dt_us(varint) args(zigzag varints...)
+// where len counts the bytes after itself and dt_us is the time since the
+// previous record. Bitmap, sprite image, text, point list and path payloads
+// are not stored, only their FNV-1a hash plus the sizes and bounds needed to
+// replay them. Sprite ops carry the id addSprite() returned while recording.
+#define TFT_TRACE_FORMAT_VERSION 1
+#define TFT_TRACE_HEADER_SIZE    3
+#define TFT_TRACE_MAX_ARGS       16
+#define TFT_TRACE_MAX_RECORD     (2 + 5 + TFT_TRACE_MAX_ARGS * 5)
+#define TFT_TRACE_HASH_SEED      2166136261u
+
+typedef enum {
+    TFT_TRACE_OP_BEGIN = 0,       // width height rotation framebuffer
+    TFT_TRACE_OP_DISPLAY,         // dirty x y w h valid
+    TFT_TRACE_OP_FILL_SCREEN,     // color
+    TFT_TRACE_OP_PIXEL,           // x y color
+    TFT_TRACE_OP_HLINE,           // x y w color
+    TFT_TRACE_OP_VLINE,           // x y h color
+    TFT_TRACE_OP_FILL_RECT,       // x y w h color
+    TFT_TRACE_OP_LINE,            // x0 y0 x1 y1 color
+    TFT_TRACE_OP_RECT,            // x y w h color
+    TFT_TRACE_OP_CIRCLE,          // x y r color
+    TFT_TRACE_OP_FILL_CIRCLE,     // x y r color
+    TFT_TRACE_OP_BITMAP,          // x y w h color bg has_bg hash
+    TFT_TRACE_OP_RGB_BITMAP,      // x y w h has_mask hash
+    TFT_TRACE_OP_RGB_REGION,      // x y w h flip src_stride hash
+    TFT_TRACE_OP_PIXELS,          // count has_colors color bx by bw bh hash
+    TFT_TRACE_OP_LINES,           // count bx by bw bh hash
+    TFT_TRACE_OP_RECTS,           // count bx by bw bh hash
+    TFT_TRACE_OP_POLYGON,         // count color bx by bw bh hash
+    TFT_TRACE_OP_PATH,            // color rule bx by bw bh hash
+    TFT_TRACE_OP_POLYLINE,        // count color width_x16 join cap closed dashed bx by bw bh hash
+    TFT_TRACE_OP_THICK_LINE,      // x0 y0 x1 y1 width_x16 color cap
+    TFT_TRACE_OP_SHADER_RECT,     // x y w h
+    TFT_TRACE_OP_SHADER_CIRCLE,   // x y r
+    TFT_TRACE_OP_SHADER_POLYGON,  // count bx by bw bh hash
+    TFT_TRACE_OP_DIM,             // x y w h level
+    TFT_TRACE_OP_TINT,            // x y w h color amount
+    TFT_TRACE_OP_INVERT,          // x y w h
+    TFT_TRACE_OP_BLUR,            // x y w h radius passes
+    TFT_TRACE_OP_CHAR,            // x y c color bg size has_bg
+    TFT_TRACE_OP_TEXT,            // x y len color bg size has_bg hash
+    TFT_TRACE_OP_ADDR_WINDOW,     // x0 y0 x1 y1
+    TFT_TRACE_OP_PUSH_COLORS,     // len hash
+    TFT_TRACE_OP_PUSH_COLOR,      // color len
+    TFT_TRACE_OP_RGB_ALPHA,       // x y w h hash
+    TFT_TRACE_OP_SPRITE_ADD,      // id w h x y z hash
+    TFT_TRACE_OP_SPRITE_REMOVE,   // id
+    TFT_TRACE_OP_SPRITE_CLEAR,    //
+    TFT_TRACE_OP_SPRITE_MOVE,     // id x y
+    TFT_TRACE_OP_SPRITE_IMAGE,    // id hash
+    TFT_TRACE_OP_SPRITE_Z,        // id z
+    TFT_TRACE_OP_SPRITE_KEY,      // id key enable
+    TFT_TRACE_OP_SPRITE_ALPHA,    // id alpha
+    TFT_TRACE_OP_SPRITE_SHOW,     // id visible
+    TFT_TRACE_OP_COUNT
+} tft_trace_op_t;
+
+// Decoded record
+typedef struct {
+    uint8_t op;
+    uint8_t argc;
+    uint32_t dt_us;
+    int32_t args[TFT_TRACE_MAX_ARGS];
+} tft_trace_record_t;
+
+// Receives every encoded record (the stream header first)
+typedef void (*tft_trace_sink_t)(const uint8_t* data, size_t len, void* user);
+
+// FNV-1a; pass the previous result as seed to hash data in pieces
+uint32_t tft_trace_hash(const void* data, size_t len, uint32_t seed = TFT_TRACE_HASH_SEED);
+
+class TFTTraceRecorder {
+public:
+    TFTTraceRecorder();
+
+    // Ring mode keeps the newest records, dropping whole old records when
+    // full. The buffer stays owned by the caller (e.g. PSRAM).
+    bool beginRing(uint8_t* buffer, size_t capacity);
+    void beginSink(tft_trace_sink_t sink, void* user);
+    void end();
+    bool active() const { return ring != nullptr || sink != nullptr; }
+
+    void record(uint8_t op, const int32_t* args, uint8_t argc, int64_t now_us);
+
+    // Ring contents as a complete stream (header + records, oldest first).
+    // Returns the bytes needed; data is only written when capacity is large enough.
+    size_t copyRing(uint8_t* data, size_t capacity) const;
+    void clearRing();
+
+    uint32_t recordCount() const { return records; }
+    uint32_t droppedCount() const { return dropped; }
+
+private:
+    uint8_t* ring;
+    size_t ring_capacity;
+    size_t ring_head;       // Oldest record
+    size_t ring_used;
+    tft_trace_sink_t sink;
+    void* sink_user;
+    int64_t last_us;
+    bool has_last;
+    uint32_t records;
+    uint32_t dropped;
+
+    void ring_write(const uint8_t* data, size_t len);
+};
+
+// Stream reader: check the header, then call tft_trace_next() until it
+// returns false. offset starts at 0.
+bool tft_trace_read_header(const uint8_t* data, size_t len, size_t* offset);
+bool tft_trace_next(const uint8_t* data, size_t len, size_t* offset, tft_trace_record_t* record);
+
+// Per-op call counts and the span of a trace
+typedef struct {
+    uint32_t records;
+    uint32_t frames;                         // display() calls
+    uint32_t op_count[TFT_TRACE_OP_COUNT];
+    uint64_t duration_us;                    // Sum of record deltas
+    uint16_t width, height;                  // From the BEGIN record, 0 if none
+} tft_trace_summary_t;
+
+bool tft_trace_summarize(const uint8_t* data, size_t len, tft_trace_summary_t* summary);
+
+// Damage of every display() call, ready for tft_timing_predict_workload()
+bool tft_trace_frame_rects(const uint8_t* data, size_t len, std::vector<tft_timing_rect_t>& frames);
+
+#endif // TFT_TRACE_H
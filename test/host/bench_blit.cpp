@@ -0,0 +1,75 @@
+// RGB blit throughput in framebuffer mode on the simulated panel: the
+// per-pixel loop drawRGBBitmap() used before the row-memcpy path, the
+// current drawRGBBitmap() and drawRGBBitmapRegion() from an atlas with each
+// flip, and display() staging with and without a color LUT. The staging
+// cases include the simulated panel decoding the pixels.
+//   g++ -std=c++11 -O2 -Isrc -Itest/host/sim test/host/bench_blit.cpp src/*.cpp test/host/sim/idf_sim.cpp -o bench_blit -lpthread && ./bench_blit
+
+#include "host_bench.h"
+#include "TFT7735V.h"
+#include <vector>
+
+static const uint16_t W = 128, H = 160;
+uint16_t legacy_fb[W * H];   // Not static: the stores must not be dropped
+
+// The former fb_draw_rgb_bitmap() without a mask: bounds checks and a copy
+// per pixel
+static void legacy_blit(uint16_t x, uint16_t y, const uint16_t* bitmap, uint16_t w, uint16_t h) {
+    for (uint16_t row = 0; row < h; row++) {
+        if (y + row >= H) break;
+        for (uint16_t col = 0; col < w; col++) {
+            if (x + col >= W) break;
+            legacy_fb[(y + row) * W + (x + col)] = bitmap[row * w + col];
+        }
+    }
+}
+
+int main() {
+    TFT7735V tft;
+    if (!tft.begin()) {
+        fprintf(stderr, "driver failed to start\n");
+        return 1;
+    }
+
+    std::vector<uint16_t> image(W * H), atlas(256 * 256);
+    for (size_t i = 0; i < image.size(); i++) image[i] = (uint16_t)(i * 2654435761u >> 16);
+    for (size_t i = 0; i < atlas.size(); i++) atlas[i] = (uint16_t)(i * 40503u);
+
+    const uint16_t sizes[][2] = { { 16, 16 }, { 32, 32 }, { W, H } };
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        uint16_t w = sizes[s][0], h = sizes[s][1];
+        uint16_t x = (W - w) / 2, y = (H - h) / 2;
+        double pixels = (double)w * h;
+        char name[64];
+
+        snprintf(name, sizeof(name), "per-pixel loop %ux%u", w, h);
+        host_bench_print(name, host_bench_us([&] { legacy_blit(x, y, &image[0], w, h); }), pixels);
+        snprintf(name, sizeof(name), "drawRGBBitmap %ux%u", w, h);
+        host_bench_print(name, host_bench_us([&] { tft.drawRGBBitmap(x, y, &image[0], w, h); }), pixels);
+        if (w > 64) continue;
+
+        static const struct { uint8_t flip; const char* name; } flips[] = {
+            { TFT_FLIP_NONE, "" }, { TFT_FLIP_H, " flip H" }, { TFT_FLIP_V, " flip V" },
+        };
+        for (size_t f = 0; f < sizeof(flips) / sizeof(flips[0]); f++) {
+            snprintf(name, sizeof(name), "drawRGBBitmapRegion %ux%u%s", w, h, flips[f].name);
+            host_bench_print(name, host_bench_us([&] {
+                tft.drawRGBBitmapRegion(x, y, &atlas[0], 256, 64, 96, w, h, flips[f].flip);
+            }), pixels);
+        }
+    }
+
+    // Full frames through stage_rows(): byte swap only, then the LUT path
+    uint8_t red[32], green[64], blue[32];
+    for (int i = 0; i < 32; i++) red[i] = blue[i] = (uint8_t)(31 - i);
+    for (int i = 0; i < 64; i++) green[i] = (uint8_t)(63 - i);
+    for (int lut = 0; lut < 2; lut++) {
+        if (lut) tft.setColorLUT(red, green, blue);
+        host_bench_print(lut ? "display() full frame, color LUT" : "display() full frame", host_bench_us([&] {
+            tft.drawRGBBitmap(0, 0, &image[0], W, H);
+            tft.display();
+            tft.waitForDisplayDone();
+        }), (double)W * H);
+    }
+    return 0;
+}
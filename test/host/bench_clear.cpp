@@ -0,0 +1,39 @@
+// Lazy clear on the simulated panel: fill_screen() alone, and frames that
+// clear, draw a few shapes and call display(), with setLazyClear() off and
+// on. Frame times include the simulated panel decoding the pixels.
+//   g++ -std=c++11 -O2 -Isrc -Itest/host/sim test/host/bench_clear.cpp src/*.cpp test/host/sim/idf_sim.cpp -o bench_clear -lpthread && ./bench_clear
+
+#include "host_bench.h"
+#include "TFT7735V.h"
+
+static const uint16_t W = 128, H = 160;
+
+int main() {
+    TFT7735V tft;
+    if (!tft.begin()) {
+        fprintf(stderr, "driver failed to start\n");
+        return 1;
+    }
+
+    for (int lazy = 0; lazy < 2; lazy++) {
+        tft.setLazyClear(lazy != 0);
+        const char* mode = lazy ? "lazy" : "eager";
+        char name[64];
+        uint16_t color = 0;
+
+        snprintf(name, sizeof(name), "fill_screen, %s", mode);
+        host_bench_print(name, host_bench_us([&] { tft.fill_screen(color++); }), (double)W * H);
+
+        // Mostly background: a few shapes over the cleared screen
+        snprintf(name, sizeof(name), "clear + draw + display, %s", mode);
+        host_bench_print(name, host_bench_us([&] {
+            tft.fill_screen(color++);
+            tft.fillRect(10, 10, 40, 20, ST7735_RED);
+            tft.fillCircle(64, 90, 15, ST7735_GREEN);
+            tft.drawLine(0, 159, 127, 0, ST7735_WHITE);
+            tft.display();
+            tft.waitForDisplayDone();
+        }), (double)W * H);
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+// Sprite count scaling on the simulated panel: frames in which every 16x16
+// sprite moves, drawn with the sprite engine and, for comparison, by
+// restoring the background under each sprite and blitting it with
+// drawRGBBitmap(). Frame times include the simulated panel decoding the
+// pixels; "compose" is the staging time spent on sprites (sprite_us). The
+// host's framebuffer is ordinary RAM, so the PSRAM writes the engine saves
+// (two per sprite pixel per frame in immediate mode) cost little here.
+//   g++ -std=c++11 -O2 -Isrc -Itest/host/sim test/host/bench_sprites.cpp src/*.cpp test/host/sim/idf_sim.cpp -o bench_sprites -lpthread && ./bench_sprites
+
+#include "host_bench.h"
+#include "TFT7735V.h"
+#include <vector>
+
+static const uint16_t W = 128, H = 160, S = 16;
+
+struct mover_t {
+    int16_t x, y, dx, dy;
+    void step() {
+        if (x + dx < 0 || x + dx > W - S) dx = -dx;
+        if (y + dy < 0 || y + dy > H - S) dy = -dy;
+        x += dx;
+        y += dy;
+    }
+};
+
+static std::vector<mover_t> make_movers(int count) {
+    std::vector<mover_t> m(count);
+    for (int i = 0; i < count; i++) {
+        m[i].x = (int16_t)((i * 37) % (W - S));
+        m[i].y = (int16_t)((i * 53) % (H - S));
+        m[i].dx = (int16_t)(1 + i % 3);
+        m[i].dy = (int16_t)(1 + i % 2);
+    }
+    return m;
+}
+
+int main() {
+    TFT7735V tft;
+    if (!tft.begin()) {
+        fprintf(stderr, "driver failed to start\n");
+        return 1;
+    }
+
+    std::vector<uint16_t> background(W * H), sprite(S * S);
+    for (size_t i = 0; i < background.size(); i++) background[i] = (uint16_t)(i * 2654435761u >> 16);
+    for (size_t i = 0; i < sprite.size(); i++) sprite[i] = (i % 5) ? (uint16_t)(i * 40503u) : ST7735_BLACK;
+
+    const int counts[] = { 0, 8, 32, 64, 128 };
+    char name[64];
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        int n = counts[c];
+        double pixels = (double)n * S * S;
+
+        // Sprite engine: the background stays in the framebuffer
+        tft.drawRGBBitmap(0, 0, &background[0], W, H);
+        std::vector<mover_t> m = make_movers(n);
+        std::vector<int16_t> ids(n);
+        for (int i = 0; i < n; i++) {
+            ids[i] = tft.addSprite(&sprite[0], S, S, m[i].x, m[i].y, (int16_t)i);
+            tft.setSpriteColorKey(ids[i], ST7735_BLACK);
+        }
+        uint64_t compose_us = 0, frames = 0;
+        double us = host_bench_us([&] {
+            for (int i = 0; i < n; i++) {
+                m[i].step();
+                tft.moveSprite(ids[i], m[i].x, m[i].y);
+            }
+            tft.display();
+            tft.waitForDisplayDone();
+            compose_us += tft.getFrameStats().sprite_us;
+            frames++;
+        });
+        snprintf(name, sizeof(name), "sprite engine, %d sprites", n);
+        host_bench_print(name, us, pixels);
+        printf("%-36s %10.2f us\n", "  compose", (double)compose_us / frames);
+        tft.clearSprites();
+
+        // Immediate mode: background restore and blit per sprite
+        tft.drawRGBBitmap(0, 0, &background[0], W, H);
+        m = make_movers(n);
+        us = host_bench_us([&] {
+            for (int i = 0; i < n; i++) {
+                tft.drawRGBBitmapRegion(m[i].x, m[i].y, &background[0], W, m[i].x, m[i].y, S, S);
+                m[i].step();
+            }
+            for (int i = 0; i < n; i++) tft.drawRGBBitmap(m[i].x, m[i].y, &sprite[0], S, S);
+            tft.display();
+            tft.waitForDisplayDone();
+        });
+        snprintf(name, sizeof(name), "drawRGBBitmap, %d sprites", n);
+        host_bench_print(name, us, pixels);
+    }
+    return 0;
+}
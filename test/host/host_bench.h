@@ -0,0 +1,36 @@
+#ifndef HOST_BENCH_H
+#define HOST_BENCH_H
+
+// Minimal timing for the host benchmarks. Each benchmark file is one program
+// that prints one line per case. Compare the numbers within a run; they do
+// not predict the device.
+
+#include <stdio.h>
+#include <chrono>
+
+static inline double host_bench_now_us() {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Calls fn until at least min_us have passed, after one warm-up call;
+// returns microseconds per call
+template <typename F>
+static double host_bench_us(F fn, double min_us = 200000.0) {
+    fn();
+    long calls = 0;
+    double start = host_bench_now_us(), elapsed = 0.0;
+    do {
+        fn();
+        // Keeps the compiler from merging repeated stores across calls
+        __asm__ __volatile__("" : : : "memory");
+        calls++;
+        elapsed = host_bench_now_us() - start;
+    } while (elapsed < min_us);
+    return elapsed / calls;
+}
+
+static inline void host_bench_print(const char* name, double us_per_call, double pixels_per_call) {
+    printf("%-36s %10.2f us %9.1f MPix/s\n", name, us_per_call, pixels_per_call / us_per_call);
+}
+
+#endif // HOST_BENCH_H
@@ -0,0 +1,32 @@
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+// Minimal checks for the host tests. Each test file is one program: it prints
+// the failed checks and exits non-zero if there were any.
+
+#include <stdio.h>
+#include <math.h>
+
+static int host_test_failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+        host_test_failures++; \
+    } \
+} while (0)
+
+#define CHECK_NEAR(actual, expected, tolerance) do { \
+    double host_a = (actual), host_e = (expected); \
+    if (fabs(host_a - host_e) > (tolerance)) { \
+        printf("%s:%d: %s = %g, expected %g\n", __FILE__, __LINE__, #actual, host_a, host_e); \
+        host_test_failures++; \
+    } \
+} while (0)
+
+static inline int host_test_result(const char* name) {
+    printf("%s: %s\n", name, host_test_failures ? "FAILED" : "ok");
+    return host_test_failures ? 1 : 0;
+}
+
+#endif // HOST_TEST_H
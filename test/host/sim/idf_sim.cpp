@@ -0,0 +1,674 @@
+// Host implementation of the ESP-IDF and FreeRTOS subset the driver uses,
+// with the simulated panel (see sim_panel.h). One lock and condition
+// variable serve every queue and semaphore; that is plenty for tests.
+
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "driver/gpio.h"
+#include "driver/ledc.h"
+#include "driver/spi_master.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "sim_panel.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Time, logging, heap
+
+int64_t esp_timer_get_time(void) {
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+static esp_log_level_t log_level = ESP_LOG_WARN;
+
+void esp_log_level_set(const char* tag, esp_log_level_t level) {
+    (void)tag;
+    log_level = level;
+}
+
+void esp_log_write(esp_log_level_t level, const char* tag, const char* format, ...) {
+    static const char letters[] = "NEWIDV";
+    if (level > log_level) return;
+    fprintf(stderr, "%c (%lld) %s: ", letters[level], (long long)(esp_timer_get_time() / 1000), tag);
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+    fputc('\n', stderr);
+}
+
+const char* esp_err_to_name(esp_err_t code) {
+    switch (code) {
+        case ESP_OK: return "ESP_OK";
+        case ESP_FAIL: return "ESP_FAIL";
+        case ESP_ERR_NO_MEM: return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG: return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_TIMEOUT: return "ESP_ERR_TIMEOUT";
+        default: return "ERROR";
+    }
+}
+
+void* heap_caps_malloc(size_t size, uint32_t caps) {
+    (void)caps;
+    return malloc(size);
+}
+
+void* heap_caps_calloc(size_t n, size_t size, uint32_t caps) {
+    (void)caps;
+    return calloc(n, size);
+}
+
+void heap_caps_free(void* ptr) {
+    free(ptr);
+}
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) ? 4 * 1024 * 1024 : 256 * 1024;
+}
+
+// ---------------------------------------------------------------------------
+// Tasks
+
+struct sim_task_t {
+    std::thread thread;
+    TaskFunction_t fn;
+    void* params;
+    bool deleted;
+    uint32_t notify;
+};
+
+// Thrown out of a blocking call when the task was deleted from elsewhere
+struct sim_task_deleted {};
+
+static std::mutex sim_lock;
+static std::condition_variable sim_cv;
+static std::recursive_mutex critical_lock;
+static thread_local sim_task_t* current_task = nullptr;
+
+static sim_task_t* self_task() {
+    // The main thread gets a handle on first use
+    if (current_task == nullptr) {
+        current_task = new sim_task_t();
+        current_task->fn = nullptr;
+        current_task->params = nullptr;
+        current_task->deleted = false;
+        current_task->notify = 0;
+    }
+    return current_task;
+}
+
+// Wait under sim_lock until ready() or the timeout; false on timeout
+template <typename Ready>
+static bool sim_wait(std::unique_lock<std::mutex>& lock, TickType_t ticks, Ready ready) {
+    sim_task_t* task = self_task();
+    std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds((int64_t)ticks * portTICK_PERIOD_MS);
+    while (!ready()) {
+        if (task->deleted) throw sim_task_deleted();
+        if (ticks == 0) return false;
+        if (ticks == portMAX_DELAY) {
+            sim_cv.wait(lock);
+        } else if (sim_cv.wait_until(lock, deadline) == std::cv_status::timeout) {
+            return ready();
+        }
+    }
+    return true;
+}
+
+static void task_entry(sim_task_t* task) {
+    current_task = task;
+    try {
+        task->fn(task->params);
+    } catch (const sim_task_deleted&) {
+    }
+    std::lock_guard<std::mutex> guard(sim_lock);
+    if (!task->deleted) {
+        // Deleted itself (or returned): nobody will join
+        task->thread.detach();
+        delete task;
+    }
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char* name, uint32_t stack_depth, void* params,
+                       UBaseType_t priority, TaskHandle_t* handle) {
+    (void)name;
+    (void)stack_depth;
+    (void)priority;
+    sim_task_t* task = new sim_task_t();
+    task->fn = fn;
+    task->params = params;
+    task->deleted = false;
+    task->notify = 0;
+    {
+        std::lock_guard<std::mutex> guard(sim_lock);
+        task->thread = std::thread(task_entry, task);
+    }
+    if (handle != nullptr) *handle = task;
+    return pdPASS;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack_depth, void* params,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core) {
+    (void)core;
+    return xTaskCreate(fn, name, stack_depth, params, priority, handle);
+}
+
+void vTaskDelete(TaskHandle_t handle) {
+    if (handle == nullptr || handle == current_task) {
+        throw sim_task_deleted();
+    }
+    {
+        std::lock_guard<std::mutex> guard(sim_lock);
+        handle->deleted = true;
+    }
+    sim_cv.notify_all();
+    handle->thread.join();
+    delete handle;
+}
+
+void vTaskDelay(TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(sim_lock);
+    sim_wait(lock, ticks ? ticks : 1, [] { return false; });
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return (TickType_t)(esp_timer_get_time() / 1000 / portTICK_PERIOD_MS);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return self_task();
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t handle) {
+    {
+        std::lock_guard<std::mutex> guard(sim_lock);
+        handle->notify++;
+    }
+    sim_cv.notify_all();
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t handle, BaseType_t* woken) {
+    xTaskNotifyGive(handle);
+    if (woken != nullptr) *woken = pdFALSE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks) {
+    sim_task_t* task = self_task();
+    std::unique_lock<std::mutex> lock(sim_lock);
+    sim_wait(lock, ticks, [task] { return task->notify != 0; });
+    uint32_t value = task->notify;
+    if (value != 0) task->notify = clear_on_exit ? 0 : value - 1;
+    return value;
+}
+
+void taskYIELD(void) {
+    std::this_thread::yield();
+}
+
+void vPortEnterCritical(portMUX_TYPE* mux) {
+    critical_lock.lock();
+    mux->count++;
+}
+
+void vPortExitCritical(portMUX_TYPE* mux) {
+    mux->count--;
+    critical_lock.unlock();
+}
+
+// ---------------------------------------------------------------------------
+// Queues and semaphores
+
+typedef enum {
+    SIM_QUEUE,
+    SIM_SEMAPHORE,
+    SIM_MUTEX,
+    SIM_RECURSIVE_MUTEX
+} sim_queue_kind_t;
+
+struct sim_queue_t {
+    sim_queue_kind_t kind;
+    UBaseType_t length;                        // Items, or the maximum count
+    UBaseType_t item_size;
+    std::deque<std::vector<uint8_t> > items;
+    UBaseType_t count;                         // Semaphores
+    sim_task_t* owner;                         // Mutexes
+    UBaseType_t depth;
+};
+
+static sim_queue_t* new_queue(sim_queue_kind_t kind, UBaseType_t length, UBaseType_t item_size, UBaseType_t count) {
+    sim_queue_t* q = new sim_queue_t();
+    q->kind = kind;
+    q->length = length;
+    q->item_size = item_size;
+    q->count = count;
+    q->owner = nullptr;
+    q->depth = 0;
+    return q;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) {
+    return new_queue(SIM_QUEUE, length, item_size, 0);
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+    delete queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(sim_lock);
+    if (!sim_wait(lock, ticks, [queue] { return queue->items.size() < queue->length; })) return pdFAIL;
+    const uint8_t* bytes = (const uint8_t*)item;
+    queue->items.push_back(std::vector<uint8_t>(bytes, bytes + queue->item_size));
+    lock.unlock();
+    sim_cv.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void* item, TickType_t ticks) {
+    return xQueueSend(queue, item, ticks);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(sim_lock);
+    if (!sim_wait(lock, ticks, [queue] { return !queue->items.empty(); })) return pdFAIL;
+    memcpy(item, &queue->items.front()[0], queue->item_size);
+    queue->items.pop_front();
+    lock.unlock();
+    sim_cv.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xQueueReset(QueueHandle_t queue) {
+    {
+        std::lock_guard<std::mutex> guard(sim_lock);
+        queue->items.clear();
+    }
+    sim_cv.notify_all();
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    std::lock_guard<std::mutex> guard(sim_lock);
+    return (queue->kind == SIM_QUEUE) ? (UBaseType_t)queue->items.size() : queue->count;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue) {
+    std::lock_guard<std::mutex> guard(sim_lock);
+    return queue->length - (UBaseType_t)queue->items.size();
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void) {
+    return new_queue(SIM_SEMAPHORE, 1, 0, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max_count, UBaseType_t initial_count) {
+    return new_queue(SIM_SEMAPHORE, max_count, 0, initial_count);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+    return new_queue(SIM_MUTEX, 1, 0, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void) {
+    return new_queue(SIM_RECURSIVE_MUTEX, 1, 0, 1);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t sem) {
+    delete sem;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks) {
+    sim_task_t* task = self_task();
+    std::unique_lock<std::mutex> lock(sim_lock);
+    if (!sim_wait(lock, ticks, [sem] { return sem->count != 0; })) return pdFAIL;
+    sem->count--;
+    sem->owner = task;
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+    {
+        std::lock_guard<std::mutex> guard(sim_lock);
+        if (sem->count >= sem->length) return pdFAIL;
+        sem->count++;
+        sem->owner = nullptr;
+    }
+    sim_cv.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t* woken) {
+    if (woken != nullptr) *woken = pdFALSE;
+    return xSemaphoreGive(sem);
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t sem, TickType_t ticks) {
+    sim_task_t* task = self_task();
+    std::unique_lock<std::mutex> lock(sim_lock);
+    if (!sim_wait(lock, ticks, [sem, task] { return sem->owner == nullptr || sem->owner == task; })) return pdFAIL;
+    sem->owner = task;
+    sem->depth++;
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t sem) {
+    {
+        std::lock_guard<std::mutex> guard(sim_lock);
+        if (sem->owner != current_task || sem->depth == 0) return pdFAIL;
+        if (--sem->depth == 0) sem->owner = nullptr;
+    }
+    sim_cv.notify_all();
+    return pdPASS;
+}
+
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t sem) {
+    std::lock_guard<std::mutex> guard(sim_lock);
+    return sem->count;
+}
+
+// ---------------------------------------------------------------------------
+// GPIO and LEDC
+
+static uint8_t gpio_levels[GPIO_NUM_MAX];
+static thread_local int last_gpio_level = 0;   // DC for the next transaction
+
+esp_err_t gpio_config(const gpio_config_t* config) {
+    return (config->pin_bit_mask >> GPIO_NUM_MAX) ? ESP_ERR_INVALID_ARG : ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level) {
+    if (gpio_num < 0 || gpio_num >= GPIO_NUM_MAX) return ESP_ERR_INVALID_ARG;
+    gpio_levels[gpio_num] = level ? 1 : 0;
+    last_gpio_level = level ? 1 : 0;
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num) {
+    return (gpio_num >= 0 && gpio_num < GPIO_NUM_MAX) ? gpio_levels[gpio_num] : 0;
+}
+
+esp_err_t ledc_timer_config(const ledc_timer_config_t* config) {
+    (void)config;
+    return ESP_OK;
+}
+
+esp_err_t ledc_channel_config(const ledc_channel_config_t* config) {
+    (void)config;
+    return ESP_OK;
+}
+
+esp_err_t ledc_set_duty(ledc_mode_t mode, ledc_channel_t channel, uint32_t duty) {
+    (void)mode;
+    (void)channel;
+    (void)duty;
+    return ESP_OK;
+}
+
+esp_err_t ledc_update_duty(ledc_mode_t mode, ledc_channel_t channel) {
+    (void)mode;
+    (void)channel;
+    return ESP_OK;
+}
+
+esp_err_t ledc_stop(ledc_mode_t mode, ledc_channel_t channel, uint32_t idle_level) {
+    (void)mode;
+    (void)channel;
+    (void)idle_level;
+    return ESP_OK;
+}
+
+// ---------------------------------------------------------------------------
+// Simulated panel
+
+#define SIM_CMD_CASET 0x2A
+#define SIM_CMD_RASET 0x2B
+#define SIM_CMD_RAMWR 0x2C
+#define SIM_CMD_RAMRD 0x2E
+#define SIM_MAX_PARAMS 16
+
+struct sim_panel_t {
+    int cs;
+    uint16_t gram[SIM_PANEL_GRAM_W * SIM_PANEL_GRAM_H];
+    sim_panel_stats_t stats;
+    uint64_t bus_ns;
+    uint8_t cmd;                                   // Current command
+    uint8_t param_count;
+    uint8_t params[256][SIM_MAX_PARAMS];           // Last parameters per command
+    uint8_t param_len[256];
+    uint16_t xs, xe, ys, ye;                       // Address window
+    uint16_t x, y;                                 // RAMWR/RAMRD pointer
+    int16_t high_byte;                             // First half of a pixel, -1 if none
+};
+
+static uint16_t be16(const uint8_t* p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static void panel_advance(sim_panel_t* p) {
+    if (++p->x > p->xe) {
+        p->x = p->xs;
+        if (++p->y > p->ye) p->y = p->ys;
+    }
+}
+
+static void panel_command(sim_panel_t* p, uint8_t cmd) {
+    p->stats.commands++;
+    p->stats.cmd_count[cmd]++;
+    p->cmd = cmd;
+    p->param_count = 0;
+    p->param_len[cmd] = 0;
+    if (cmd == SIM_CMD_RAMWR || cmd == SIM_CMD_RAMRD) {
+        p->x = p->xs;
+        p->y = p->ys;
+        p->high_byte = -1;
+    }
+}
+
+static void panel_data(sim_panel_t* p, uint8_t b) {
+    p->stats.data_bytes++;
+    if (p->cmd == SIM_CMD_RAMWR) {
+        if (p->high_byte < 0) {
+            p->high_byte = b;
+            return;
+        }
+        if (p->x < SIM_PANEL_GRAM_W && p->y < SIM_PANEL_GRAM_H) {
+            p->gram[p->y * SIM_PANEL_GRAM_W + p->x] = (uint16_t)((p->high_byte << 8) | b);
+        }
+        p->high_byte = -1;
+        p->stats.pixels++;
+        panel_advance(p);
+        return;
+    }
+    if (p->param_count < SIM_MAX_PARAMS) {
+        p->params[p->cmd][p->param_count++] = b;
+        p->param_len[p->cmd] = p->param_count;
+    }
+    if (p->param_count == 4 && p->cmd == SIM_CMD_CASET) {
+        p->xs = be16(&p->params[SIM_CMD_CASET][0]);
+        p->xe = be16(&p->params[SIM_CMD_CASET][2]);
+    } else if (p->param_count == 4 && p->cmd == SIM_CMD_RASET) {
+        p->ys = be16(&p->params[SIM_CMD_RASET][0]);
+        p->ye = be16(&p->params[SIM_CMD_RASET][2]);
+    }
+}
+
+// RAMRD: 18-bit color, each channel in the upper 6 bits of a byte
+static void panel_read(sim_panel_t* p, uint8_t* out, size_t len) {
+    for (size_t i = 0; i + 3 <= len; i += 3) {
+        uint16_t c = (p->x < SIM_PANEL_GRAM_W && p->y < SIM_PANEL_GRAM_H) ? p->gram[p->y * SIM_PANEL_GRAM_W + p->x] : 0;
+        uint8_t r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, b = c & 0x1F;
+        out[i] = (uint8_t)(((r << 1) | (r >> 4)) << 2);
+        out[i + 1] = (uint8_t)(g << 2);
+        out[i + 2] = (uint8_t)(((b << 1) | (b >> 4)) << 2);
+        panel_advance(p);
+    }
+}
+
+uint16_t sim_panel_pixel(const sim_panel_t* panel, uint16_t x, uint16_t y) {
+    if (x >= SIM_PANEL_GRAM_W || y >= SIM_PANEL_GRAM_H) return 0;
+    return panel->gram[y * SIM_PANEL_GRAM_W + x];
+}
+
+uint32_t sim_panel_hash(const sim_panel_t* panel, uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    uint32_t hash = 2166136261u;
+    for (uint16_t row = y; row < y + h; row++) {
+        for (uint16_t col = x; col < x + w; col++) {
+            uint16_t c = sim_panel_pixel(panel, col, row);
+            hash = (hash ^ (c & 0xFF)) * 16777619u;
+            hash = (hash ^ (c >> 8)) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+uint8_t sim_panel_params(const sim_panel_t* panel, uint8_t cmd, uint8_t* params, uint8_t max) {
+    uint8_t n = (panel->param_len[cmd] < max) ? panel->param_len[cmd] : max;
+    memcpy(params, panel->params[cmd], n);
+    return n;
+}
+
+const sim_panel_stats_t* sim_panel_stats(const sim_panel_t* panel) {
+    return &panel->stats;
+}
+
+void sim_panel_reset_stats(sim_panel_t* panel) {
+    memset(&panel->stats, 0, sizeof(panel->stats));
+    panel->bus_ns = 0;
+}
+
+// ---------------------------------------------------------------------------
+// SPI master
+
+struct spi_device_t {
+    spi_host_device_t host;
+    int cs;
+    int clock_hz;
+    sim_panel_t* panel;
+};
+
+static bool bus_initialized[3];
+static bool realtime_bus = false;
+static std::recursive_mutex bus_lock[3];
+static std::vector<spi_device_t*> devices;
+static std::vector<sim_panel_t*> panels;       // Kept per CS pin across re-adds
+
+sim_panel_t* sim_panel_get(gpio_num_t cs) {
+    for (size_t i = 0; i < devices.size(); i++) {
+        if (devices[i]->cs == cs) return devices[i]->panel;
+    }
+    return nullptr;
+}
+
+void sim_panel_set_realtime(bool realtime) {
+    realtime_bus = realtime;
+}
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t* config, int dma_chan) {
+    (void)config;
+    (void)dma_chan;
+    if (host > SPI3_HOST) return ESP_ERR_INVALID_ARG;
+    if (bus_initialized[host]) return ESP_ERR_INVALID_STATE;
+    bus_initialized[host] = true;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_free(spi_host_device_t host) {
+    if (host > SPI3_HOST || !bus_initialized[host]) return ESP_ERR_INVALID_STATE;
+    bus_initialized[host] = false;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t* config,
+                             spi_device_handle_t* handle) {
+    if (host > SPI3_HOST || !bus_initialized[host]) return ESP_ERR_INVALID_STATE;
+    spi_device_t* dev = new spi_device_t();
+    dev->host = host;
+    dev->cs = config->spics_io_num;
+    dev->clock_hz = config->clock_speed_hz;
+    dev->panel = nullptr;
+    // A device re-added on the same CS pin (e.g. for a new clock) is the same panel
+    for (size_t i = 0; i < panels.size(); i++) {
+        if (panels[i]->cs == dev->cs) dev->panel = panels[i];
+    }
+    if (dev->panel == nullptr) {
+        dev->panel = (sim_panel_t*)calloc(1, sizeof(sim_panel_t));
+        dev->panel->cs = dev->cs;
+        dev->panel->high_byte = -1;
+        panels.push_back(dev->panel);
+    }
+    devices.push_back(dev);
+    *handle = dev;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle) {
+    for (size_t i = 0; i < devices.size(); i++) {
+        if (devices[i] == handle) devices.erase(devices.begin() + i);
+    }
+    delete handle;
+    return ESP_OK;
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t* trans) {
+    std::lock_guard<std::recursive_mutex> guard(bus_lock[handle->host]);
+    sim_panel_t* p = handle->panel;
+    const uint8_t* tx = (trans->flags & SPI_TRANS_USE_TXDATA) ? trans->tx_data : (const uint8_t*)trans->tx_buffer;
+    size_t tx_len = trans->length / 8;
+    size_t bits = trans->length + trans->rxlength;
+    if (trans->flags & SPI_TRANS_VARIABLE_DUMMY) {
+        bits += ((spi_transaction_ext_t*)trans)->dummy_bits;
+    }
+
+    for (size_t i = 0; i < tx_len; i++) {
+        if (last_gpio_level) {
+            panel_data(p, tx[i]);
+        } else {
+            panel_command(p, tx[i]);
+        }
+    }
+    if (trans->rxlength != 0) {
+        uint8_t* rx = (trans->flags & SPI_TRANS_USE_RXDATA) ? trans->rx_data : (uint8_t*)trans->rx_buffer;
+        size_t rx_len = (trans->rxlength + 7) / 8;
+        memset(rx, 0, rx_len);
+        if (p->cmd == SIM_CMD_RAMRD) panel_read(p, rx, rx_len);
+    }
+
+    if (handle->clock_hz > 0) {
+        uint64_t ns = (uint64_t)bits * 1000000000ull / (uint64_t)handle->clock_hz;
+        p->bus_ns += ns;
+        p->stats.bus_us = p->bus_ns / 1000;
+        if (realtime_bus) std::this_thread::sleep_for(std::chrono::nanoseconds(ns));
+    }
+    return ESP_OK;
+}
+
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t* trans) {
+    return spi_device_polling_transmit(handle, trans);
+}
+
+esp_err_t spi_device_acquire_bus(spi_device_handle_t handle, TickType_t wait) {
+    (void)wait;
+    bus_lock[handle->host].lock();
+    return ESP_OK;
+}
+
+void spi_device_release_bus(spi_device_handle_t handle) {
+    bus_lock[handle->host].unlock();
+}
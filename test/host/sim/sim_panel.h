@@ -0,0 +1,47 @@
+#ifndef SIM_PANEL_H
+#define SIM_PANEL_H
+
+#include <stdint.h>
+#include "driver/gpio.h"
+
+// Simulated panel behind the host ESP-IDF shim in this directory. Every
+// spi_master device is one panel; whether a transaction is command or data
+// comes from the GPIO level the calling task set last, since the driver
+// drives DC itself right before each transaction. CASET, RASET, RAMWR and
+// RAMRD are decoded into a 16-bit GRAM addressed in window coordinates (after
+// MADCTL), and bus time is counted at the device clock rather than slept.
+// Read pixels and stats once the driver is idle (waitForDisplayDone()).
+
+#define SIM_PANEL_GRAM_W 320
+#define SIM_PANEL_GRAM_H 320
+
+typedef struct sim_panel_t sim_panel_t;
+
+typedef struct {
+    uint32_t commands;         // Command bytes
+    uint32_t cmd_count[256];   // Per command byte
+    uint64_t data_bytes;       // Bytes in data phases, parameters included
+    uint64_t pixels;           // Pixels written to GRAM
+    uint64_t bus_us;           // Transfer time at the device clock
+} sim_panel_stats_t;
+
+// Panel of the device on this CS pin; nullptr if there is none
+sim_panel_t* sim_panel_get(gpio_num_t cs);
+
+// RGB565 as sent on the bus (high byte first), 0 outside the GRAM
+uint16_t sim_panel_pixel(const sim_panel_t* panel, uint16_t x, uint16_t y);
+
+// FNV-1a of the RGB565 values in a GRAM rectangle, row by row
+uint32_t sim_panel_hash(const sim_panel_t* panel, uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+
+// Last parameter bytes sent with a command; returns how many (at most max)
+uint8_t sim_panel_params(const sim_panel_t* panel, uint8_t cmd, uint8_t* params, uint8_t max);
+
+const sim_panel_stats_t* sim_panel_stats(const sim_panel_t* panel);
+void sim_panel_reset_stats(sim_panel_t* panel);
+
+// With realtime set, every transaction also takes its wire time, so frames
+// queue up behind the bus as on hardware. Off by default.
+void sim_panel_set_realtime(bool realtime);
+
+#endif // SIM_PANEL_H
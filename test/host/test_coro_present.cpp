@@ -0,0 +1,84 @@
+// Coroutine present path on the simulated panel: present() waits for a free
+// buffer instead of letting display() stall, returns each frame's sequence
+// number, and frameDone() resumes once that frame is on the panel.
+//   g++ -std=c++20 -Isrc -Itest/host/sim test/host/test_coro_present.cpp src/*.cpp test/host/sim/idf_sim.cpp -o test_coro_present -lpthread && ./test_coro_present
+
+#include "host_test.h"
+#include "TFT7735V.h"
+#include "sim_panel.h"
+#include <vector>
+
+static const uint16_t colors[] = { ST7735_RED, ST7735_GREEN, ST7735_BLUE, ST7735_WHITE, ST7735_CYAN, ST7735_YELLOW,
+                                   ST7735_MAGENTA, ST7735_BLACK };
+static const int frames = sizeof(colors) / sizeof(colors[0]);
+
+struct results_t {
+    std::vector<uint32_t> seqs;       // present() results
+    std::vector<uint32_t> done;       // frameDone() results, every third frame
+    std::vector<uint32_t> done_for;   // The frame each one waited for
+    std::vector<uint8_t> depth;       // Queue depth after each present()
+};
+
+// Full-screen frames as fast as present() allows; waits for every third one
+static TFTTask render(TFT7735V& tft, results_t& r) {
+    for (int i = 0; i < frames; i++) {
+        tft.fill_screen(colors[i]);
+        uint32_t seq = co_await tft.present();
+        r.seqs.push_back(seq);
+        r.depth.push_back(tft.getQueueDepth());
+        if (i % 3 == 2) {
+            r.done.push_back(co_await tft.frameDone(seq));
+            r.done_for.push_back(seq);
+        }
+    }
+}
+
+// Runs alongside: the scheduler keeps resuming other coroutines while
+// render() waits
+static TFTTask ticker(TFTScheduler& sched, const results_t& r, int& ticks) {
+    while ((int)r.seqs.size() < frames) {
+        ticks++;
+        co_await sched.sleep(1);
+    }
+}
+
+int main() {
+    // Outlives the driver, whose display task may still call wake()
+    TFTScheduler sched;
+    TFT7735V tft;
+    // Slow clock with real wire time: frames take ~80 ms, so the queue fills
+    CHECK(tft.begin(4000000));
+    sim_panel_set_realtime(true);
+    tft.resetFrameStats();
+
+    tft.setFrameDoneCallback(TFTScheduler::wake, &sched);
+    results_t r;
+    int ticks = 0;
+    sched.spawn(render(tft, r));
+    sched.spawn(ticker(sched, r, ticks));
+    sched.run();
+
+    CHECK((int)r.seqs.size() == frames);
+    for (int i = 1; i < (int)r.seqs.size(); i++) CHECK(r.seqs[i] == r.seqs[i - 1] + 1);
+    for (size_t i = 0; i < r.done.size(); i++) CHECK((int32_t)(r.done[i] - r.done_for[i]) >= 0);
+    for (size_t i = 0; i < r.depth.size(); i++) CHECK(r.depth[i] < tft.getFramebufferCount());
+    CHECK(ticks > 1);
+
+    // The queue filled up, yet display() never stalled: present() held the
+    // frames back while the scheduler kept running
+    CHECK(tft.getFrameStats().max_queue_depth == tft.getFramebufferCount() - 1);
+    CHECK(tft.getFrameStats().stalls == 0);
+
+    tft.waitForDisplayDone();
+    CHECK(tft.completedFrameSequence() == r.seqs.back());
+    sim_panel_t* panel = sim_panel_get(GPIO_NUM_10);
+    int wrong = 0;
+    for (uint16_t y = 0; y < 160; y++) {
+        for (uint16_t x = 0; x < 128; x++) {
+            if (sim_panel_pixel(panel, x, y) != colors[frames - 1]) wrong++;
+        }
+    }
+    CHECK(wrong == 0);
+
+    return host_test_result("test_coro_present");
+}
@@ -0,0 +1,84 @@
+// Tear-avoidance schedule: chunks started at tft_scan_safe_start() must never
+// be seen half old and half new by a refresh.
+//   g++ -std=c++11 -Isrc test/host/test_scan_model.cpp src/tft_scan_model.cpp -o test_scan_model && ./test_scan_model
+
+#include "host_test.h"
+#include "tft_scan_model.h"
+#include <stdlib.h>
+
+// Brute force: every refresh that overlaps the write scans each row of
+// first .. last either before or after the write reaches it, never a mix.
+// Rows scanned within 0.01 us of being written count as either.
+static bool tears(const tft_scan_model_t* m, int32_t first, int32_t last, uint32_t write_us, int64_t start) {
+    double line = (double)m->period_us / (m->gate_lines + m->porch_lines);
+    int32_t step = (last >= first) ? 1 : -1;
+    int32_t n = (last - first) * step;
+    int64_t k0 = (start - m->sync_us) / m->period_us - 2;
+    int64_t k1 = (start + write_us - m->sync_us) / m->period_us + 2;
+    for (int64_t k = k0; k <= k1; k++) {
+        int seen = 0;
+        for (int32_t i = 0; i <= n; i++) {
+            int32_t r = first + i * step;
+            double written = start + (n ? (double)write_us * i / n : 0.0);
+            double scanned = m->sync_us + r * line + (double)k * m->period_us;
+            if (fabs(scanned - written) < 0.01) continue;
+            int sign = (scanned < written) ? -1 : 1;
+            if (seen != 0 && sign != seen) return true;
+            seen = sign;
+        }
+    }
+    return false;
+}
+
+// Start times from many phases: never tearing, never waiting longer than needed
+static void check_schedule(const tft_scan_model_t* m, int32_t first, int32_t last, uint32_t write_us) {
+    for (int i = 0; i < 500; i++) {
+        int64_t now = 1000000 + (int64_t)(rand() % (3 * m->period_us));
+        int64_t start = tft_scan_safe_start(m, first, last, write_us, now);
+        CHECK(start >= now);
+        CHECK(start < now + m->period_us);
+        CHECK(!tears(m, first, last, write_us, start));
+        if (start > now + 1) CHECK(tears(m, first, last, write_us, start - 2));
+    }
+}
+
+int main() {
+    // ST7735V profile timing, synced at an arbitrary time
+    tft_scan_model_t m = { 12403, 160, 91, 123456, 0 };
+
+    // Scan line estimate wraps once per period, porch lines included
+    CHECK(tft_scan_line(&m, m.sync_us) == 0);
+    CHECK(tft_scan_line(&m, m.sync_us + 12403 / 2) == 125);
+    CHECK(tft_scan_line(&m, m.sync_us + 12403 * 7 + 100) == 2);
+    CHECK(tft_scan_line(&m, m.sync_us - 60) == 249);
+
+    // 32-row chunk written faster than the scan (40 MHz SPI: 1.6 ms)
+    check_schedule(&m, 0, 31, 1638);
+    check_schedule(&m, 96, 127, 1638);
+
+    // Rotation 2: rows written bottom-up against the scan
+    check_schedule(&m, 159, 128, 1638);
+    check_schedule(&m, 63, 32, 1638);
+
+    // Writes slower than the scan and longer than a whole refresh can still
+    // be placed while the scan stays on one side of them on every pass
+    check_schedule(&m, 0, 159, 20000);
+    check_schedule(&m, 159, 0, 4000);
+
+    // Too slow to place at any start: -1, and indeed every start tears
+    CHECK(tft_scan_safe_start(&m, 0, 159, 30000, 1000000) == -1);
+    bool all_tear = true;
+    for (int64_t t = 1000000; t < 1000000 + 12403; t += 97) {
+        if (!tears(&m, 0, 159, 30000, t)) all_tear = false;
+    }
+    CHECK(all_tear);
+
+    // The guard band widens the forbidden window on both sides
+    tft_scan_model_t guarded = m;
+    guarded.guard_us = 100;
+    int64_t inside = m.sync_us + 31 * 12403 / 251;   // Scan on row 31
+    int64_t plain = tft_scan_safe_start(&m, 32, 63, 1638, inside);
+    CHECK_NEAR((double)(tft_scan_safe_start(&guarded, 32, 63, 1638, inside) - plain), 100.0, 2.0);
+
+    return host_test_result("test_scan_model");
+}
@@ -0,0 +1,94 @@
+// Stroke coverage: joins and caps must not count overlapping pieces twice.
+//   g++ -std=c++11 -Isrc test/host/test_stroke.cpp src/tft_path.cpp -o test_stroke && ./test_stroke
+
+#include "host_test.h"
+#include "tft_path.h"
+
+typedef struct {
+    double total;   // Sum of pixel coverage
+    float max;      // Largest single pixel coverage
+} coverage_t;
+
+// Rasterize the stroke the way drawPolyline() does, over a 64x64 area
+static coverage_t stroke_coverage(const float* xy, size_t count, bool closed, const tft_stroke_style_t& style) {
+    std::vector<tft_path_segment_t> segments;
+    tft_stroke_polyline(xy, count, closed, style, segments);
+    std::vector<tft_path_crossing_t> crossings;
+    float cov[64];
+    coverage_t c = { 0.0, 0.0f };
+    for (int32_t y = 0; y < 64; y++) {
+        tft_path_coverage_row(&segments[0], segments.size(), y, 0, 64, TFT_FILL_NONZERO, cov, crossings);
+        for (int32_t x = 0; x < 64; x++) {
+            c.total += cov[x];
+            if (cov[x] > c.max) c.max = cov[x];
+        }
+    }
+    return c;
+}
+
+// Independent estimate of the union area: nonzero winding of the stroke
+// pieces at n x n points per pixel
+static double sampled_area(const float* xy, size_t count, bool closed, const tft_stroke_style_t& style) {
+    std::vector<tft_path_segment_t> segments;
+    tft_stroke_polyline(xy, count, closed, style, segments);
+    const int n = 32;
+    long inside = 0;
+    for (int py = 0; py < 64 * n; py++) {
+        float sy = (py + 0.5f) / n;
+        for (int px = 0; px < 64 * n; px++) {
+            float sx = (px + 0.5f) / n;
+            int winding = 0;
+            for (size_t i = 0; i < segments.size(); i++) {
+                const tft_path_segment_t& s = segments[i];
+                bool down = s.y0 < s.y1;
+                if (sy < (down ? s.y0 : s.y1) || sy >= (down ? s.y1 : s.y0)) continue;
+                float x = s.x0 + (sy - s.y0) * (s.x1 - s.x0) / (s.y1 - s.y0);
+                if (x < sx) winding += down ? 1 : -1;
+            }
+            if (winding != 0) inside++;
+        }
+    }
+    return (double)inside / (n * n);
+}
+
+int main() {
+    // L with a miter join: two 10 x 3 bars, overlapping 1.5 x 1.5 at the
+    // inner corner, plus the 1.5 x 1.5 miter square outside it
+    {
+        const float xy[] = { 10.5f, 10.5f, 20.5f, 10.5f, 20.5f, 20.5f };
+        coverage_t c = stroke_coverage(xy, 3, false, tftStrokeStyle(3.0f, TFT_JOIN_MITER, TFT_CAP_BUTT));
+        CHECK_NEAR(c.total, 60.0, 1e-3);
+        CHECK(c.max <= 1.0f + 1e-5f);
+    }
+
+    // Closed square outline: 23 x 23 outside, 17 x 17 hole
+    {
+        const float xy[] = { 10.5f, 10.5f, 30.5f, 10.5f, 30.5f, 30.5f, 10.5f, 30.5f };
+        coverage_t c = stroke_coverage(xy, 4, true, tftStrokeStyle(3.0f, TFT_JOIN_MITER, TFT_CAP_BUTT));
+        CHECK_NEAR(c.total, 529.0 - 289.0, 1e-3);
+    }
+
+    // Diagonal zig-zag: joins at odd angles against a supersampled union
+    const float zig[] = { 5.5f, 40.5f, 18.3f, 12.7f, 30.1f, 45.2f, 41.6f, 9.9f, 57.2f, 30.4f };
+    const tft_line_join_t joins[] = { TFT_JOIN_MITER, TFT_JOIN_BEVEL, TFT_JOIN_ROUND };
+    for (int j = 0; j < 3; j++) {
+        tft_stroke_style_t style = tftStrokeStyle(4.5f, joins[j], TFT_CAP_ROUND);
+        coverage_t c = stroke_coverage(zig, 5, false, style);
+        double area = sampled_area(zig, 5, false, style);
+        CHECK_NEAR(c.total, area, area * 0.002);
+        CHECK(c.max <= 1.0f + 1e-5f);
+    }
+
+    // Dashes: pieces of neighbouring dashes never touch, caps overlap quads
+    {
+        static const float dash[] = { 6.0f, 3.0f };
+        tft_stroke_style_t style = tftStrokeStyle(3.0f, TFT_JOIN_ROUND, TFT_CAP_ROUND);
+        style.dash = dash;
+        style.dash_count = 2;
+        coverage_t c = stroke_coverage(zig, 5, false, style);
+        double area = sampled_area(zig, 5, false, style);
+        CHECK_NEAR(c.total, area, area * 0.002);
+    }
+
+    return host_test_result("test_stroke");
+}
@@ -0,0 +1,74 @@
+// Retained labels on the simulated panel: redrawing a label sends only the
+// glyph runs that changed and the cells that became empty, and leaves the
+// panel as a fresh draw of the new text would.
+//   g++ -std=c++11 -Isrc -Itest/host/sim test/host/test_text_label.cpp src/*.cpp test/host/sim/idf_sim.cpp -o test_text_label -lpthread && ./test_text_label
+
+#include "host_test.h"
+#include "TFT7735V.h"
+#include "sim_panel.h"
+
+static const int16_t BX = 4, BY = 20;
+static const uint16_t BW = 120, BH = 8;
+
+// Same text drawn fresh on another panel: the box as a redraw must leave it
+static uint32_t fresh(gpio_num_t cs, const char* text, const tft_text_style_t& style) {
+    TFT7735V tft(GPIO_NUM_11, GPIO_NUM_12, cs, GPIO_NUM_9, GPIO_NUM_NC, GPIO_NUM_NC);
+    tft.begin();
+    tft.disableFramebuffer();
+    tft.drawTextBox(BX, BY, BW, BH, text, style);
+    return sim_panel_hash(sim_panel_get(cs), BX, BY, BW, BH);
+}
+
+// Redraws the label and returns the pixels sent for it
+static uint64_t redraw(TFT7735V& tft, TFTTextLabel& label, const char* text) {
+    sim_panel_t* panel = sim_panel_get(GPIO_NUM_10);
+    sim_panel_reset_stats(panel);
+    tft.drawLabel(label, text);
+    return sim_panel_stats(panel)->pixels;
+}
+
+int main() {
+    // Direct mode: every glyph and clear goes straight to the panel
+    TFT7735V tft;
+    CHECK(tft.begin());
+    tft.disableFramebuffer();
+    sim_panel_t* panel = sim_panel_get(GPIO_NUM_10);
+    tft.fill_screen(ST7735_BLUE);
+
+    tft_text_style_t style = tftTextStyle(ST7735_WHITE, ST7735_BLACK);
+    TFTTextLabel label(BX, BY, BW, BH, style);
+
+    // First draw paints the whole box
+    CHECK(redraw(tft, label, "Score 1234") == (uint64_t)BW * BH);
+    CHECK(sim_panel_hash(panel, BX, BY, BW, BH) == fresh(GPIO_NUM_5, "Score 1234", style));
+
+    // One digit changed: one 8x8 cell
+    CHECK(redraw(tft, label, "Score 1235") == 64);
+    CHECK(sim_panel_hash(panel, BX, BY, BW, BH) == fresh(GPIO_NUM_4, "Score 1235", style));
+
+    // Two separate runs changed
+    CHECK(redraw(tft, label, "Scare 1285") == 2 * 64);
+    CHECK(sim_panel_hash(panel, BX, BY, BW, BH) == fresh(GPIO_NUM_6, "Scare 1285", style));
+
+    // Shorter: nothing to draw, the two cells left behind are cleared
+    CHECK(redraw(tft, label, "Scare 12") == 2 * 64);
+    CHECK(sim_panel_hash(panel, BX, BY, BW, BH) == fresh(GPIO_NUM_3, "Scare 12", style));
+
+    // Unchanged text sends nothing
+    CHECK(redraw(tft, label, "Scare 12") == 0);
+
+    // Right-aligned: a longer value shifts the text by whole cells, so only
+    // the new leading digit is drawn
+    style.align = TFT_ALIGN_RIGHT;
+    TFTTextLabel right(BX, BY + 20, BW, BH, style);
+    tft.drawLabel(right, "99");
+    sim_panel_reset_stats(panel);
+    tft.drawLabel(right, "199");
+    CHECK(sim_panel_stats(panel)->pixels == 64);
+
+    // Outside the label, the screen was never touched
+    CHECK(sim_panel_pixel(panel, BX - 1, BY) == ST7735_BLUE);
+    CHECK(sim_panel_pixel(panel, BX + BW, BY + BH - 1) == ST7735_BLUE);
+
+    return host_test_result("test_text_label");
+}
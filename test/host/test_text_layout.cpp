@@ -0,0 +1,75 @@
+// Text box layout: wrapping, alignment and when an ellipsis is added.
+//   g++ -std=c++11 -Isrc test/host/test_text_layout.cpp src/tft_text_layout.cpp -o test_text_layout && ./test_text_layout
+
+#include "host_test.h"
+#include "tft_text_layout.h"
+#include <string>
+
+// Lines as drawn, "..." appended where the layout puts an ellipsis
+static std::vector<std::string> layout(const char* text, uint16_t box_w, uint16_t box_h,
+                                       tft_text_align_t align = TFT_ALIGN_LEFT, bool wrap = true) {
+    tft_text_style_t style = tftTextStyle(0xFFFF, 0x0000, 1, align);
+    style.wrap = wrap;
+    std::vector<tft_text_line_t> lines;
+    tft_text_layout(text, box_w, box_h, 8, 8, style, lines);
+    std::vector<std::string> out;
+    for (size_t i = 0; i < lines.size(); i++) {
+        std::string s(text + lines[i].start, lines[i].length);
+        if (lines[i].ellipsis) s += "...";
+        out.push_back(s);
+    }
+    return out;
+}
+
+int main() {
+    // Word wrap at spaces, long words split
+    {
+        std::vector<std::string> l = layout("hello big world", 48, 24);
+        CHECK(l.size() == 3);
+        CHECK(l.size() == 3 && l[0] == "hello" && l[1] == "big" && l[2] == "world");
+        l = layout("abcdefghij", 32, 24);
+        CHECK(l.size() == 3 && l[0] == "abcd" && l[1] == "efgh" && l[2] == "ij");
+    }
+
+    // Truncation: only when visible text is cut off
+    {
+        std::vector<std::string> l = layout("hello big world", 48, 16);
+        CHECK(l.size() == 2 && l[1] == "big...");
+        l = layout("ab    ", 32, 8);
+        CHECK(l.size() == 1 && l[0] == "ab");
+        l = layout("abcd   \n  \n", 32, 8);
+        CHECK(l.size() == 1 && l[0] == "abcd");
+        l = layout("ab\n  x", 32, 8);
+        CHECK(l.size() == 1 && l[0] == "a...");
+    }
+
+    // Alignment offsets
+    {
+        tft_text_style_t style = tftTextStyle(0xFFFF, 0x0000, 1, TFT_ALIGN_RIGHT);
+        std::vector<tft_text_line_t> lines;
+        tft_text_layout("ab", 64, 8, 8, 8, style, lines);
+        CHECK(lines.size() == 1 && lines[0].x_offset == 48);
+        style.align = TFT_ALIGN_CENTER;
+        tft_text_layout("ab", 64, 8, 8, 8, style, lines);
+        CHECK(lines.size() == 1 && lines[0].x_offset == 24);
+    }
+
+    // No wrap: one line per paragraph, long lines end in an ellipsis
+    {
+        std::vector<std::string> l = layout("abcdefgh\nxy", 48, 16, TFT_ALIGN_LEFT, false);
+        CHECK(l.size() == 2 && l[0] == "abc..." && l[1] == "xy");
+    }
+
+    // Glyphs wider than 255 pixels (font size 32 and up)
+    {
+        tft_text_style_t style = tftTextStyle(0xFFFF, 0x0000, 32, TFT_ALIGN_RIGHT);
+        std::vector<tft_text_line_t> lines;
+        tft_text_layout("ab", 600, 256, 256, 256, style, lines);
+        CHECK(lines.size() == 1 && lines[0].length == 2 && lines[0].x_offset == 88);
+        TFTTextLayoutCache cache;
+        CHECK(cache.lookup("ab", 600, 256, 256, 256, style).size() == 1);
+        CHECK(cache.lookup("ab", 600, 256, 8, 8, style)[0].x_offset == 584);
+    }
+
+    return host_test_result("test_text_layout");
+}
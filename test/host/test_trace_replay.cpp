@@ -0,0 +1,139 @@
+// Trace record and replay against the simulated panel: replaying a recorded
+// session reproduces the panel contents, and stand-in payloads are
+// deterministic.
+//   g++ -std=c++11 -Isrc -Itest/host/sim test/host/test_trace_replay.cpp src/*.cpp test/host/sim/idf_sim.cpp -o test_trace_replay -lpthread && ./test_trace_replay
+
+#include "host_test.h"
+#include "TFT7735V.h"
+#include "sim_panel.h"
+#include <string.h>
+#include <vector>
+
+static uint8_t ring[16 * 1024];
+
+static uint32_t gram_hash(gpio_num_t cs) {
+    return sim_panel_hash(sim_panel_get(cs), 0, 0, SIM_PANEL_GRAM_W, SIM_PANEL_GRAM_H);
+}
+
+// Fresh driver on its own CS pin, replaying a stream; returns the GRAM hash
+static uint32_t replay_on(gpio_num_t cs, const std::vector<uint8_t>& stream) {
+    TFT7735V tft(GPIO_NUM_11, GPIO_NUM_12, cs, GPIO_NUM_9, GPIO_NUM_NC, GPIO_NUM_NC);
+    tft.begin();
+    tft.replayTrace(&stream[0], stream.size());
+    tft.waitForDisplayDone();
+    return gram_hash(cs);
+}
+
+int main() {
+    TFT7735V tft;
+    CHECK(tft.begin());
+
+    // Three frames of calls whose arguments are recorded in full. replayTrace()
+    // lets each frame finish before the next display(), so the recording does
+    // too: otherwise the next frame may render into a different buffer.
+    TFTTraceRecorder rec;
+    CHECK(rec.beginRing(ring, sizeof(ring)));
+    tft.setTraceRecorder(&rec);
+    tft.fill_screen(ST7735_BLUE);
+    tft.fillRect(10, 20, 50, 30, ST7735_RED);
+    tft.drawLine(0, 0, 127, 159, ST7735_WHITE);
+    tft.display();
+    tft.waitForDisplayDone();
+    tft.fillCircle(64, 80, 25, ST7735_GREEN);
+    tft.drawRect(5, 5, 118, 150, ST7735_YELLOW);
+    tft.drawThickLine(10, 150, 120, 100, 3.5f, ST7735_CYAN, TFT_CAP_ROUND);
+    tft.display();
+    tft.waitForDisplayDone();
+    tft.dimRegion(0, 60, 128, 40, 128);
+    tft.drawCircle(30, 30, 12, ST7735_MAGENTA);
+    tft.display();
+    tft.waitForDisplayDone();
+    tft.setTraceRecorder(nullptr);
+    uint32_t recorded = gram_hash(GPIO_NUM_10);
+
+    std::vector<uint8_t> stream(rec.copyRing(nullptr, 0));
+    CHECK(rec.copyRing(&stream[0], stream.size()) == stream.size());
+    tft_trace_summary_t summary;
+    CHECK(tft_trace_summarize(&stream[0], stream.size(), &summary));
+    CHECK(summary.frames == 3);
+    CHECK(summary.width == 128 && summary.height == 160);
+
+    // Same calls on another panel: same picture
+    CHECK(replay_on(GPIO_NUM_5, stream) == recorded);
+
+    // Text is recorded as length and hash only, computed once per call
+    rec.clearRing();
+    tft.setTraceRecorder(&rec);
+    tft.drawText(4, 4, "hello", ST7735_WHITE, ST7735_BLACK, 2);
+    tft.display();
+    tft.waitForDisplayDone();
+    tft.setTraceRecorder(nullptr);
+    stream.resize(rec.copyRing(nullptr, 0));
+    rec.copyRing(&stream[0], stream.size());
+    size_t offset;
+    tft_trace_record_t r;
+    bool found = false;
+    CHECK(tft_trace_read_header(&stream[0], stream.size(), &offset));
+    while (tft_trace_next(&stream[0], stream.size(), &offset, &r)) {
+        if (r.op != TFT_TRACE_OP_TEXT) continue;
+        found = true;
+        CHECK(r.args[2] == 5);
+        CHECK(r.args[5] == 2);
+        CHECK((uint32_t)r.args[7] == tft_trace_hash("hello", 5));
+    }
+    CHECK(found);
+
+    // Stand-in payloads: replays agree with each other
+    uint32_t a = replay_on(GPIO_NUM_4, stream);
+    uint32_t b = replay_on(GPIO_NUM_6, stream);
+    CHECK(a == b);
+
+    // Sprites are replayed too, ids mapped, with stand-in images
+    static uint16_t ball[8 * 8], box[12 * 12];
+    for (int i = 0; i < 64; i++) ball[i] = (i % 9) ? ST7735_RED : ST7735_BLACK;
+    for (int i = 0; i < 144; i++) box[i] = ST7735_BLUE;
+    rec.clearRing();
+    tft.setTraceRecorder(&rec);
+    tft.fill_screen(ST7735_BLACK);
+    int16_t s0 = tft.addSprite(ball, 8, 8, 10, 10, 1);
+    int16_t s1 = tft.addSprite(box, 12, 12, 40, 60);
+    tft.setSpriteColorKey(s0, ST7735_BLACK);
+    tft.display();
+    tft.waitForDisplayDone();
+    tft.moveSprite(s0, 90, 120);
+    tft.setSpriteAlpha(s1, 128);
+    tft.display();
+    tft.waitForDisplayDone();
+    tft.removeSprite(s0);
+    tft.display();
+    tft.waitForDisplayDone();
+    tft.setTraceRecorder(nullptr);
+    stream.resize(rec.copyRing(nullptr, 0));
+    rec.copyRing(&stream[0], stream.size());
+    CHECK(tft_trace_summarize(&stream[0], stream.size(), &summary));
+    CHECK(summary.op_count[TFT_TRACE_OP_SPRITE_ADD] == 2);
+    CHECK(summary.op_count[TFT_TRACE_OP_SPRITE_MOVE] == 1);
+
+    TFT7735V replay(GPIO_NUM_11, GPIO_NUM_12, GPIO_NUM_3, GPIO_NUM_9, GPIO_NUM_NC, GPIO_NUM_NC);
+    replay.begin();
+    CHECK(replay.replayTrace(&stream[0], stream.size()) == summary.records);
+    replay.waitForDisplayDone();
+    CHECK(replay.getSpriteCount() == 1);
+    CHECK(replay.getFrameStats().sprite_count == 1);
+    CHECK(gram_hash(GPIO_NUM_3) == replay_on(GPIO_NUM_2, stream));
+    // The remaining sprite shows over the cleared background
+    sim_panel_t* panel = sim_panel_get(GPIO_NUM_3);
+    CHECK(sim_panel_hash(panel, 40, 60, 12, 12) != sim_panel_hash(panel, 60, 60, 12, 12));
+
+    // Records shorter than their op are skipped, not replayed with garbage
+    rec.clearRing();
+    int32_t args[12] = { 10, 10, 'A', ST7735_WHITE, ST7735_BLACK, 1, 1, 0, 0, 0, 0, 0 };
+    rec.record(TFT_TRACE_OP_CHAR, args, 3, 0);
+    rec.record(TFT_TRACE_OP_POLYLINE, args, 5, 0);
+    rec.record(TFT_TRACE_OP_CHAR, args, 7, 0);
+    stream.resize(rec.copyRing(nullptr, 0));
+    rec.copyRing(&stream[0], stream.size());
+    CHECK(replay.replayTrace(&stream[0], stream.size()) == 1);
+
+    return host_test_result("test_trace_replay");
+}
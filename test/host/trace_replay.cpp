@@ -0,0 +1,160 @@
+// Replays a drawing-call trace (see tft_trace.h) through the driver against the
+// simulated panel in test/host/sim, one display() at a time, and prints per
+// frame the GRAM hash, pixels sent, modelled bus time and host time. Given the
+// output of an earlier run, it reports every frame whose hash changed.
+//   g++ -std=c++11 -O2 -Isrc -Itest/host/sim test/host/trace_replay.cpp src/*.cpp test/host/sim/idf_sim.cpp -o trace_replay -lpthread
+//   ./trace_replay [-p ILI9341] [-t] trace.bin > frames.txt
+//   ./trace_replay [-p ILI9341] [-t] trace.bin frames.txt
+// -p picks the panel profile by name prefix (default: the first profile with
+// the recorded size), -t keeps the recorded timing.
+
+#include "TFT7735V.h"
+#include "sim_panel.h"
+#include <esp_timer.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <vector>
+
+static const tft_panel_profile_t* const profiles[] = {
+    &TFT_PANEL_ST7735V_128X160,
+    &TFT_PANEL_ST7789_240X240,
+    &TFT_PANEL_ST7789_240X320,
+    &TFT_PANEL_ILI9341_240X320,
+};
+
+static bool read_file(const char* path, std::vector<uint8_t>& data) {
+    FILE* f = fopen(path, "rb");
+    if (f == nullptr) return false;
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) data.insert(data.end(), buf, buf + n);
+    fclose(f);
+    return true;
+}
+
+static const tft_panel_profile_t* pick_profile(const char* name, const tft_trace_record_t* begin) {
+    for (size_t i = 0; i < sizeof(profiles) / sizeof(profiles[0]); i++) {
+        const tft_panel_profile_t* p = profiles[i];
+        if (name != nullptr) {
+            if (strncasecmp(p->name, name, strlen(name)) == 0) return p;
+            continue;
+        }
+        if (begin == nullptr) return p;
+        int32_t w = begin->args[0], h = begin->args[1];
+        if ((w == p->native_width && h == p->native_height) || (w == p->native_height && h == p->native_width)) {
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+int main(int argc, char** argv) {
+    const char* panel_name = nullptr;
+    bool timed = false;
+    int arg = 1;
+    for (; arg < argc && argv[arg][0] == '-'; arg++) {
+        if (strcmp(argv[arg], "-p") == 0 && arg + 1 < argc) {
+            panel_name = argv[++arg];
+        } else if (strcmp(argv[arg], "-t") == 0) {
+            timed = true;
+        } else {
+            break;
+        }
+    }
+    if (arg >= argc) {
+        fprintf(stderr, "usage: %s [-p panel] [-t] trace.bin [frames.txt]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<uint8_t> trace;
+    if (!read_file(argv[arg], trace)) {
+        fprintf(stderr, "cannot read %s\n", argv[arg]);
+        return 2;
+    }
+    size_t offset;
+    if (!tft_trace_read_header(&trace[0], trace.size(), &offset)) {
+        fprintf(stderr, "%s is not a trace stream\n", argv[arg]);
+        return 2;
+    }
+
+    // Reference hashes from an earlier run
+    std::vector<uint32_t> expected;
+    if (arg + 1 < argc) {
+        FILE* f = fopen(argv[arg + 1], "r");
+        if (f == nullptr) {
+            fprintf(stderr, "cannot read %s\n", argv[arg + 1]);
+            return 2;
+        }
+        unsigned frame, hash;
+        char line[256];
+        while (fgets(line, sizeof(line), f) != nullptr) {
+            if (sscanf(line, "%u %x", &frame, &hash) == 2) expected.push_back(hash);
+        }
+        fclose(f);
+    }
+
+    // Panel and rotation from the BEGIN record, if the trace starts with one
+    tft_trace_record_t rec;
+    size_t first = offset;
+    bool has_begin = tft_trace_next(&trace[0], trace.size(), &offset, &rec) && rec.op == TFT_TRACE_OP_BEGIN &&
+                     rec.argc >= 4;
+    const tft_panel_profile_t* profile = pick_profile(panel_name, has_begin ? &rec : nullptr);
+    if (profile == nullptr) {
+        fprintf(stderr, "no matching panel profile\n");
+        return 2;
+    }
+
+    TFT7735V tft;
+    tft.setPanel(*profile);
+    if (!tft.begin()) {
+        fprintf(stderr, "driver failed to start\n");
+        return 2;
+    }
+    if (has_begin) {
+        tft.setRotation((uint8_t)rec.args[2]);
+        if (!rec.args[3]) tft.disableFramebuffer();
+    }
+    sim_panel_t* panel = sim_panel_get(GPIO_NUM_10);
+
+    // Replay up to and including each DISPLAY record, as a stream of its own
+    std::vector<uint8_t> slice(trace.begin(), trace.begin() + TFT_TRACE_HEADER_SIZE);
+    offset = first;
+    size_t start = first;
+    uint32_t frame = 0, mismatches = 0;
+    uint64_t total_pixels = 0, total_bus_us = 0, total_host_us = 0;
+    printf("# frame hash pixels bus_us host_us (%s)\n", profile->name);
+    while (tft_trace_next(&trace[0], trace.size(), &offset, &rec)) {
+        if (rec.op != TFT_TRACE_OP_DISPLAY) continue;
+        slice.resize(TFT_TRACE_HEADER_SIZE);
+        slice.insert(slice.end(), trace.begin() + start, trace.begin() + offset);
+        start = offset;
+
+        sim_panel_reset_stats(panel);
+        int64_t t0 = esp_timer_get_time();
+        tft.replayTrace(&slice[0], slice.size(), timed);
+        tft.waitForDisplayDone();
+        uint32_t host_us = (uint32_t)(esp_timer_get_time() - t0);
+
+        const sim_panel_stats_t* s = sim_panel_stats(panel);
+        uint32_t hash = sim_panel_hash(panel, 0, 0, SIM_PANEL_GRAM_W, SIM_PANEL_GRAM_H);
+        printf("%u %08x %llu %llu %u\n", frame, hash, (unsigned long long)s->pixels,
+               (unsigned long long)s->bus_us, host_us);
+        if (frame < expected.size() && expected[frame] != hash) {
+            fprintf(stderr, "frame %u: hash %08x, expected %08x\n", frame, hash, expected[frame]);
+            mismatches++;
+        }
+        total_pixels += s->pixels;
+        total_bus_us += s->bus_us;
+        total_host_us += host_us;
+        frame++;
+    }
+
+    printf("# %u frames, %llu pixels, bus %llu us, host %llu us\n", frame, (unsigned long long)total_pixels,
+           (unsigned long long)total_bus_us, (unsigned long long)total_host_us);
+    if (!expected.empty() && expected.size() != frame) {
+        fprintf(stderr, "%u frames, reference has %u\n", frame, (unsigned)expected.size());
+        mismatches++;
+    }
+    return mismatches ? 1 : 0;
+}